@@ -1,21 +1,25 @@
 #include "accumulation.h"
 
+#include "parallel_for.h"
+
 #include <cassert>
 #include <iostream>
 #include <numeric>
+#include <stdexcept>
 #include <thread>
 
 namespace concurrent
 {
-int accumulate(const std::vector<int>& nums)
+int accumulate(const std::vector<int>& nums, const size_t threads)
 {
+    if (threads == 0)
+        throw std::invalid_argument("Accumulation needs at least one thread");
+
     static constexpr size_t min_size_for_threading = 1000;
-    if (nums.size() < min_size_for_threading)
+    if (threads == 1 || nums.size() < min_size_for_threading)
         return std::accumulate(nums.begin(), nums.end(), 0);
 
-    size_t num_workers = std::thread::hardware_concurrency();
-    if (num_workers == 0)
-        num_workers = 2;
+    const size_t num_workers = threads;
 
     const size_t nums_part_size = nums.size() / num_workers;
 
@@ -55,4 +59,23 @@ int accumulate(const std::vector<int>& nums)
 
     return total_sum.load();
 }
+
+int accumulate(thread_pool& pool, const std::vector<int>& nums)
+{
+    // Big enough chunks to make the per chunk atomic add negligible
+    static constexpr size_t grain = 4096;
+
+    std::atomic_int total_sum{ 0 };
+    parallel_for(
+            pool, size_t{ 0 }, nums.size(), grain,
+            [&nums, &total_sum](const size_t start, const size_t end)
+            {
+                const int local_sum = std::accumulate(nums.begin() + static_cast<std::ptrdiff_t>(start),
+                                                      nums.begin() + static_cast<std::ptrdiff_t>(end), 0);
+                total_sum.fetch_add(local_sum, std::memory_order_relaxed);
+            },
+            chunking::static_chunks);
+
+    return total_sum.load();
+}
 } // namespace concurrent
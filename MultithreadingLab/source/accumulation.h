@@ -1,8 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <thread>
 #include <vector>
 
 namespace concurrent
 {
-int accumulate(const std::vector<int>& nums);
+class thread_pool;
+
+/**
+ * Sums numbers with at most threads worker threads, small inputs are summed by the calling thread.
+ * Throws std::invalid_argument if threads is zero
+ */
+int accumulate(const std::vector<int>& nums, size_t threads = std::max(std::thread::hardware_concurrency(), 1u));
+
+/** Sums numbers with parallel_for on the pool and the calling thread, small inputs are summed by the calling thread */
+int accumulate(thread_pool& pool, const std::vector<int>& nums);
 } // namespace concurrent
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+namespace concurrent
+{
+/** What a push into a full bounded queue does */
+enum class full_policy
+{
+    block,  // Waits until a consumer frees a slot (sleeps on an atomic wait)
+    spin,   // Retries until a consumer frees a slot, yielding between attempts
+    reject, // Returns false immediately
+};
+
+/**
+ * Lock-free bounded multi-producer multi-consumer queue (Dmitry Vyukov's ring buffer). Every slot has
+ * a sequence number telling whether it is ready for the producer or for the consumer of the current lap,
+ * so a push or a pop is one CAS on the shared position plus one store to the slot. Slots and positions
+ * are padded to cache lines. The order is FIFO per producer
+ */
+template<class T>
+class mpmc_queue final
+{
+public:
+    /**
+     * The capacity is rounded up to a power of two and at least 2: with a single slot the sequence number
+     * of a filled slot would look free to the producer of the next lap
+     */
+    explicit mpmc_queue(const size_t capacity, const full_policy policy = full_policy::block) :
+        _mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1), _policy(policy)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("mpmc_queue capacity must be greater than 0");
+
+        _slots = std::make_unique<slot[]>(_mask + 1);
+        for (size_t i = 0; i <= _mask; ++i)
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    mpmc_queue(const mpmc_queue& other) = delete;
+    mpmc_queue& operator=(const mpmc_queue& other) = delete;
+
+    mpmc_queue(mpmc_queue&& other) = delete;
+    mpmc_queue& operator=(mpmc_queue&& other) = delete;
+
+    ~mpmc_queue()
+    {
+        while (try_pop())
+        {}
+    }
+
+    /** Returns false if the queue is full, the value is not moved from then */
+    template<class U>
+    bool try_push(U&& value)
+    {
+        size_t position = _push_position.load(std::memory_order_relaxed);
+        slot* next_slot;
+
+        while (true)
+        {
+            next_slot = &_slots[position & _mask];
+            const size_t sequence = next_slot->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (difference == 0)
+            {
+                if (_push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                // The slot still holds the value of the previous lap
+                return false;
+            }
+            else
+            {
+                position = _push_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::construct_at(reinterpret_cast<T*>(next_slot->storage), std::forward<U>(value));
+        // Publishes the value to the consumer of this lap
+        next_slot->sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /** Pushes according to the full policy, returns false only if the value is rejected */
+    template<class U>
+    bool push(U&& value)
+    {
+        if (try_push(std::forward<U>(value)))
+            return true;
+
+        switch (_policy)
+        {
+        case full_policy::reject:
+            return false;
+        case full_policy::spin:
+            while (!try_push(std::forward<U>(value)))
+                std::this_thread::yield();
+            return true;
+        case full_policy::block:
+            while (true)
+            {
+                const uint32_t pops = _pops.load(std::memory_order_acquire);
+                // Pairs with the read-modify-write in try_pop: either the producer sees the free slot
+                // or the consumer sees the waiting producer and changes the pops counter
+                _waiting_producers.fetch_add(1, std::memory_order_acq_rel);
+                const bool pushed = try_push(std::forward<U>(value));
+                if (!pushed)
+                    _pops.wait(pops, std::memory_order_acquire);
+                _waiting_producers.fetch_sub(1, std::memory_order_relaxed);
+
+                if (pushed || try_push(std::forward<U>(value)))
+                    return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** Returns std::nullopt if the queue is empty */
+    std::optional<T> try_pop()
+    {
+        size_t position = _pop_position.load(std::memory_order_relaxed);
+        slot* next_slot;
+
+        while (true)
+        {
+            next_slot = &_slots[position & _mask];
+            const size_t sequence = next_slot->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+            if (difference == 0)
+            {
+                if (_pop_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                // The slot is not filled in this lap yet
+                return std::nullopt;
+            }
+            else
+            {
+                position = _pop_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::optional<T> result(std::move(*next_slot->value()));
+        std::destroy_at(next_slot->value());
+        // Frees the slot for the producer of the next lap
+        next_slot->sequence.store(position + _mask + 1, std::memory_order_release);
+
+        // A read-modify-write reads the latest value, unlike a load it cannot miss a producer which has just
+        // failed to push. A fence would be cheaper but thread sanitizer does not support fences
+        if (_policy == full_policy::block)
+        {
+            if (_waiting_producers.fetch_add(0, std::memory_order_acq_rel) > 0)
+            {
+                _pops.fetch_add(1, std::memory_order_release);
+                _pops.notify_all();
+            }
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] size_t capacity() const
+    {
+        return _mask + 1;
+    }
+
+    [[nodiscard]] full_policy policy() const
+    {
+        return _policy;
+    }
+
+    /** Approximate number of values, it may be outdated by concurrent pushes and pops */
+    [[nodiscard]] size_t size() const
+    {
+        const size_t pop_position = _pop_position.load(std::memory_order_relaxed);
+        const size_t push_position = _push_position.load(std::memory_order_relaxed);
+        return push_position > pop_position ? push_position - pop_position : 0;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    static constexpr size_t cache_line_size = 64;
+
+    struct alignas(cache_line_size) slot
+    {
+        std::atomic<size_t> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* value()
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    const size_t _mask;
+    const full_policy _policy;
+    std::unique_ptr<slot[]> _slots;
+
+    alignas(cache_line_size) std::atomic<size_t> _push_position = 0;
+    alignas(cache_line_size) std::atomic<size_t> _pop_position = 0;
+
+    // Blocked producers wait for a change of the pops counter, it is only updated if somebody waits
+    alignas(cache_line_size) std::atomic<uint32_t> _pops = 0;
+    std::atomic<size_t> _waiting_producers = 0;
+};
+} // namespace concurrent
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace concurrent
+{
+/** How parallel_for splits iterations between the participating threads */
+enum class chunking
+{
+    // Chunks of grain iterations are assigned round-robin to participants up front: the least overhead,
+    // the best for uniform iterations
+    static_chunks,
+    // Participants take the next chunk of grain iterations when they are done with the previous one
+    dynamic_chunks,
+    // Like dynamic, but a chunk is the remaining iterations divided by twice the number of participants and
+    // at least grain: big chunks first, small ones for balancing at the end
+    guided_chunks,
+};
+
+/**
+ * Calls function for every index of [begin, end) using the pool and the calling thread. The function takes
+ * either one index, or a chunk as two indices [first, last) which lets it keep local state per chunk.
+ * The calling thread takes part in the work and may do it all alone, so parallel_for may be called from
+ * the pool's own tasks. Helper tasks are pushed at once with push_tasks. The first exception thrown by
+ * function is rethrown after the remaining chunks are skipped. Throws std::invalid_argument if grain is zero
+ * or begin is greater than end
+ */
+template<std::integral Index, class F>
+void parallel_for(thread_pool& pool, Index begin, Index end, Index grain, F&& function,
+                  chunking mode = chunking::dynamic_chunks);
+
+/** Calls function for every element of the random access range, see parallel_for */
+template<std::ranges::random_access_range Range, class F>
+    requires std::ranges::sized_range<Range>
+void parallel_for_each(thread_pool& pool, Range&& range, size_t grain, F&& function,
+                       chunking mode = chunking::dynamic_chunks);
+
+namespace local
+{
+    /** Shared by the calling thread and helper tasks, helpers which start late only touch this state */
+    struct parallel_for_state
+    {
+        size_t size = 0;
+        size_t grain = 0;
+        size_t participants = 0;
+        chunking mode = chunking::dynamic_chunks;
+
+        // The next iteration offset, or the next participant slot for static chunking
+        alignas(64) std::atomic<size_t> next = 0;
+        // Iterations done or skipped, the calling thread waits for it to reach the size
+        alignas(64) std::atomic<size_t> completed = 0;
+
+        std::atomic<bool> failed = false;
+        std::exception_ptr exception;
+    };
+
+    template<class Index, class F>
+    void run_chunk(parallel_for_state& state, const Index begin, F& function, const size_t first, const size_t last)
+    {
+        if (!state.failed.load(std::memory_order_relaxed))
+        {
+            try
+            {
+                if constexpr (std::is_invocable_v<F&, Index, Index>)
+                {
+                    function(static_cast<Index>(begin + static_cast<Index>(first)),
+                             static_cast<Index>(begin + static_cast<Index>(last)));
+                }
+                else
+                {
+                    for (size_t i = first; i < last; ++i)
+                        function(static_cast<Index>(begin + static_cast<Index>(i)));
+                }
+            } catch (...)
+            {
+                if (!state.failed.exchange(true, std::memory_order_relaxed))
+                    state.exception = std::current_exception();
+            }
+        }
+
+        // Release publishes the exception and the effects of the chunk to the calling thread
+        if (state.completed.fetch_add(last - first, std::memory_order_acq_rel) + (last - first) == state.size)
+            state.completed.notify_all();
+    }
+
+    template<class Index, class F>
+    void run_parallel_for(parallel_for_state& state, const Index begin, F& function)
+    {
+        switch (state.mode)
+        {
+        case chunking::static_chunks:
+        {
+            // A participant slot owns every participants-th chunk. Slots are claimed instead of being bound
+            // to threads, so the calling thread does the slots of helpers which have not started
+            const size_t stride = state.participants * state.grain;
+            for (size_t slot = state.next.fetch_add(1, std::memory_order_relaxed); slot < state.participants;
+                 slot = state.next.fetch_add(1, std::memory_order_relaxed))
+            {
+                for (size_t first = slot * state.grain; first < state.size; first += stride)
+                    run_chunk<Index>(state, begin, function, first, std::min(first + state.grain, state.size));
+            }
+            break;
+        }
+        case chunking::dynamic_chunks:
+            for (size_t first = state.next.fetch_add(state.grain, std::memory_order_relaxed); first < state.size;
+                 first = state.next.fetch_add(state.grain, std::memory_order_relaxed))
+            {
+                run_chunk<Index>(state, begin, function, first, std::min(first + state.grain, state.size));
+            }
+            break;
+        case chunking::guided_chunks:
+        {
+            size_t first = state.next.load(std::memory_order_relaxed);
+            while (first < state.size)
+            {
+                const size_t chunk = std::max(state.grain, (state.size - first) / (2 * state.participants));
+                const size_t last = std::min(first + chunk, state.size);
+                if (state.next.compare_exchange_weak(first, last, std::memory_order_relaxed))
+                {
+                    run_chunk<Index>(state, begin, function, first, last);
+                    first = state.next.load(std::memory_order_relaxed);
+                }
+            }
+            break;
+        }
+        }
+    }
+} // namespace local
+
+template<std::integral Index, class F>
+void parallel_for(thread_pool& pool, const Index begin, const Index end, const Index grain, F&& function,
+                  const chunking mode)
+{
+    static_assert(std::is_invocable_v<F&, Index> || std::is_invocable_v<F&, Index, Index>,
+                  "The function must take an index or a chunk [first, last)");
+
+    if (grain <= 0)
+        throw std::invalid_argument("parallel_for grain must be greater than 0");
+    if (begin > end)
+        throw std::invalid_argument("parallel_for begin must not be greater than end");
+    if (begin == end)
+        return;
+
+    auto state = std::make_shared<local::parallel_for_state>();
+    state->size = static_cast<size_t>(end - begin);
+    state->grain = static_cast<size_t>(grain);
+    state->mode = mode;
+
+    const size_t chunks = (state->size + state->grain - 1) / state->grain;
+    const size_t helpers = std::min(pool.size(), chunks - 1);
+    state->participants = helpers + 1;
+
+    if (helpers > 0)
+    {
+        // The function outlives helpers' use of it: they only call it for claimed chunks,
+        // and the calling thread waits for all chunks
+        const auto helper = [state, shared_function = &function, begin]()
+        { local::run_parallel_for(*state, begin, *shared_function); };
+        pool.push_tasks(std::vector(helpers, helper));
+    }
+
+    local::run_parallel_for(*state, begin, function);
+
+    for (size_t completed = state->completed.load(std::memory_order_acquire); completed != state->size;
+         completed = state->completed.load(std::memory_order_acquire))
+    {
+        state->completed.wait(completed, std::memory_order_acquire);
+    }
+
+    if (state->exception)
+        std::rethrow_exception(state->exception);
+}
+
+template<std::ranges::random_access_range Range, class F>
+    requires std::ranges::sized_range<Range>
+void parallel_for_each(thread_pool& pool, Range&& range, const size_t grain, F&& function, const chunking mode)
+{
+    const auto first = std::ranges::begin(range);
+    const auto size = static_cast<size_t>(std::ranges::size(range));
+
+    parallel_for(
+            pool, size_t{ 0 }, size, grain,
+            [&function, first](const size_t chunk_begin, const size_t chunk_end)
+            {
+                for (size_t i = chunk_begin; i < chunk_end; ++i)
+                    std::invoke(function, first[static_cast<std::iter_difference_t<decltype(first)>>(i)]);
+            },
+            mode);
+}
+} // namespace concurrent
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace concurrent
+{
+/**
+ * Process-wide free list of memory blocks for objects of type T. Released blocks are kept for reuse instead of
+ * being returned to the heap, so after a warm-up creating and destroying objects allocates nothing. Every thread
+ * has its own cache of blocks; it exchanges batches of blocks with the shared list under a mutex, so producer
+ * threads which only create objects and consumer threads which only destroy them lock rarely.
+ * Blocks are never returned to the heap
+ */
+template<class T>
+class recycling_pool final
+{
+public:
+    recycling_pool() = delete;
+
+    template<class... Args>
+    static T* create(Args&&... args)
+    {
+        void* block = allocate();
+        try
+        {
+            return std::construct_at(static_cast<T*>(block), std::forward<Args>(args)...);
+        } catch (...)
+        {
+            deallocate(block);
+            throw;
+        }
+    }
+
+    static void destroy(T* object) noexcept
+    {
+        std::destroy_at(object);
+        deallocate(object);
+    }
+
+    /** Number of blocks a thread cache takes from or gives to the shared list at once */
+    static constexpr size_t batch_size = 64;
+
+private:
+    union block
+    {
+        struct
+        {
+            block* next;
+            // The next batch in the shared list, only set in the first block of a batch
+            block* next_batch;
+        } links;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    struct shared_list
+    {
+        std::mutex mutex;
+        block* batches = nullptr;
+    };
+
+    // Trivially destructible, so it is still usable by objects destroyed after the thread cache flusher
+    struct thread_cache
+    {
+        block* blocks = nullptr;
+        size_t size = 0;
+        bool flushed = false;
+    };
+
+    // Gives the blocks of the thread cache back to the shared list when the thread exits
+    struct thread_cache_flusher
+    {
+        ~thread_cache_flusher()
+        {
+            while (cache.size > 0)
+                give_batch();
+            cache.flushed = true;
+        }
+
+        // Forces the construction of the thread local flusher
+        void touch()
+        {}
+    };
+
+    static inline thread_local constinit thread_cache cache;
+    static inline thread_local thread_cache_flusher flusher;
+
+    static shared_list& shared()
+    {
+        // Never destroyed, thread caches may give blocks back during the static destruction
+        static shared_list* list = new shared_list;
+        return *list;
+    }
+
+    static void* allocate()
+    {
+        flusher.touch();
+
+        if (cache.blocks == nullptr)
+            take_batch();
+
+        if (cache.blocks == nullptr)
+            return (new block)->storage;
+
+        block* next_block = cache.blocks;
+        cache.blocks = next_block->links.next;
+        cache.size--;
+        return next_block->storage;
+    }
+
+    static void deallocate(void* memory) noexcept
+    {
+        auto* released = static_cast<block*>(memory);
+
+        if (cache.flushed)
+        {
+            // The thread is exiting, the block goes to the shared list as a batch of one
+            released->links.next = nullptr;
+            give(released);
+            return;
+        }
+
+        flusher.touch();
+
+        released->links.next = cache.blocks;
+        cache.blocks = released;
+        cache.size++;
+
+        // Keeping up to two batches, so alternating allocations and deallocations do not lock every time
+        if (cache.size >= 2 * batch_size)
+            give_batch();
+    }
+
+    static void take_batch()
+    {
+        shared_list& list = shared();
+        std::scoped_lock lock(list.mutex);
+
+        if (list.batches == nullptr)
+            return;
+
+        block* batch = list.batches;
+        list.batches = batch->links.next_batch;
+
+        cache.blocks = batch;
+        for (block* next_block = batch; next_block != nullptr; next_block = next_block->links.next)
+            cache.size++;
+    }
+
+    static void give_batch() noexcept
+    {
+        block* batch = cache.blocks;
+        block* last = batch;
+        size_t size = 1;
+        while (size < batch_size && last->links.next != nullptr)
+        {
+            last = last->links.next;
+            size++;
+        }
+
+        cache.blocks = last->links.next;
+        cache.size -= size;
+        last->links.next = nullptr;
+
+        give(batch);
+    }
+
+    static void give(block* batch) noexcept
+    {
+        shared_list& list = shared();
+        std::scoped_lock lock(list.mutex);
+
+        batch->links.next_batch = list.batches;
+        list.batches = batch;
+    }
+};
+} // namespace concurrent
@@ -0,0 +1,635 @@
+#pragma once
+
+#include "recycling_pool.h"
+#include "task_future.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace concurrent
+{
+template<class T = void>
+class task;
+
+/**
+ * Runs the task on the calling thread until its first suspension and blocks until it completes, returns its
+ * result or rethrows its exception. Blocking a worker of the pool the task waits for may deadlock, so it is
+ * meant for threads outside of the pool
+ */
+template<class T>
+T sync_wait(task<T> awaited);
+
+namespace local
+{
+    /** void results of combinators are represented by std::monostate */
+    template<class T>
+    using non_void_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    /** Coroutine frames up to this size are taken from recycling pools, one pool per granularity step */
+    inline constexpr size_t frame_granularity = 64;
+    inline constexpr size_t max_recycled_frame_size = 1024;
+
+    template<size_t Size>
+    struct alignas(std::max_align_t) frame_block
+    {
+        // Not value-initialized, the block is raw memory for the frame
+        frame_block()
+        {}
+
+        std::byte storage[Size];
+    };
+
+    template<size_t... Classes>
+    void* allocate_frame(const size_t size_class, std::index_sequence<Classes...>)
+    {
+        void* frame = nullptr;
+        ((size_class == Classes
+                  ? (frame = recycling_pool<frame_block<(Classes + 1) * frame_granularity>>::create()->storage, true)
+                  : false) ||
+         ...);
+        return frame;
+    }
+
+    template<size_t... Classes>
+    void deallocate_frame(void* frame, const size_t size_class, std::index_sequence<Classes...>) noexcept
+    {
+        ((size_class == Classes ? (recycling_pool<frame_block<(Classes + 1) * frame_granularity>>::destroy(
+                                           static_cast<frame_block<(Classes + 1) * frame_granularity>*>(frame)),
+                                   true)
+                                : false) ||
+         ...);
+    }
+
+    using frame_classes = std::make_index_sequence<max_recycled_frame_size / frame_granularity>;
+
+    /** Base of promise types, their coroutine frames are allocated from recycling pools */
+    struct recycled_frame
+    {
+        static void* operator new(const size_t size)
+        {
+            if (size > max_recycled_frame_size)
+                return ::operator new(size);
+
+            return allocate_frame((size - 1) / frame_granularity, frame_classes{});
+        }
+
+        static void operator delete(void* frame, const size_t size) noexcept
+        {
+            if (size > max_recycled_frame_size)
+                ::operator delete(frame, size);
+            else
+                deallocate_frame(frame, (size - 1) / frame_granularity, frame_classes{});
+        }
+    };
+
+    /** The value or the exception of a completed coroutine */
+    template<class T>
+    class task_result final
+    {
+    public:
+        template<class... Args>
+        void set_value(Args&&... args)
+        {
+            _result.template emplace<1>(std::forward<Args>(args)...);
+        }
+
+        void set_exception(std::exception_ptr exception)
+        {
+            _result.template emplace<2>(std::move(exception));
+        }
+
+        /** Moves the value out or rethrows the exception */
+        T get()
+        {
+            if (_result.index() == 2)
+                std::rethrow_exception(std::get<2>(_result));
+
+            if constexpr (!std::is_void_v<T>)
+                return std::move(std::get<1>(_result));
+        }
+
+        /** Like get(), but void results are returned as std::monostate */
+        non_void_t<T> get_non_void()
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                get();
+                return {};
+            }
+            else
+            {
+                return get();
+            }
+        }
+
+    private:
+        std::variant<std::monostate, non_void_t<T>, std::exception_ptr> _result;
+    };
+
+    /** Final awaiter of a completed coroutine which resumes the continuation of its promise */
+    struct continuation_awaiter
+    {
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        template<class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> completed) noexcept
+        {
+            return completed.promise().continuation;
+        }
+
+        void await_resume() noexcept
+        {}
+    };
+
+    template<class T>
+    class coroutine_promise_base : public recycled_frame
+    {
+    public:
+        task_result<T> result;
+        // Resumed by symmetric transfer when the coroutine completes
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        continuation_awaiter final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void unhandled_exception() noexcept
+        {
+            result.set_exception(std::current_exception());
+        }
+    };
+
+    template<class T>
+    class coroutine_promise : public coroutine_promise_base<T>
+    {
+    public:
+        template<class U>
+        void return_value(U&& value)
+        {
+            this->result.set_value(std::forward<U>(value));
+        }
+    };
+
+    template<>
+    class coroutine_promise<void> : public coroutine_promise_base<void>
+    {
+    public:
+        void return_void()
+        {
+            result.set_value();
+        }
+    };
+
+    /** Fire-and-forget coroutine started immediately, its frame is destroyed when it completes */
+    struct detached_task
+    {
+        struct promise_type : recycled_frame
+        {
+            detached_task get_return_object() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            {}
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+
+    /**
+     * Lazy coroutine started by a combinator. It completes with co_await destroy_and_transfer, so it destroys
+     * its own frame after handing its result over; the handle is owned until the coroutine is started
+     */
+    class child_task final
+    {
+    public:
+        struct promise_type : recycled_frame
+        {
+            child_task get_return_object() noexcept
+            {
+                return child_task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            {}
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+
+        child_task(const child_task& other) = delete;
+        child_task& operator=(const child_task& other) = delete;
+
+        child_task(child_task&& other) noexcept : _handle(std::exchange(other._handle, nullptr))
+        {}
+
+        child_task& operator=(child_task&& other) = delete;
+
+        ~child_task()
+        {
+            if (_handle)
+                _handle.destroy();
+        }
+
+        /** The coroutine owns its frame from now on */
+        void start()
+        {
+            std::exchange(_handle, nullptr).resume();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> _handle;
+
+        explicit child_task(const std::coroutine_handle<promise_type> handle) : _handle(handle)
+        {}
+    };
+
+    /** Destroys the awaiting coroutine and transfers to the coroutine returned by next */
+    template<class Next>
+    struct destroy_and_transfer
+    {
+        Next next;
+
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> completed) noexcept
+        {
+            // The awaiter lives in the destroyed frame, nothing may be touched after destroy
+            const std::coroutine_handle<> next_coroutine = next();
+            completed.destroy();
+            return next_coroutine;
+        }
+
+        void await_resume() noexcept
+        {}
+    };
+
+    /** Awaits the task and passes its result to complete, which returns the coroutine to transfer to */
+    template<class T, class Complete>
+    child_task make_child(task<T> awaited, Complete complete)
+    {
+        task_result<T> result;
+        try
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                co_await std::move(awaited);
+                result.set_value();
+            }
+            else
+            {
+                result.set_value(co_await std::move(awaited));
+            }
+        } catch (...)
+        {
+            result.set_exception(std::current_exception());
+        }
+
+        co_await destroy_and_transfer{ [&complete, &result]() noexcept { return complete(result); } };
+    }
+
+    /**
+     * Resumes the waiter after all children and the waiter itself have arrived. The waiter arrives after
+     * starting all children, so children completing synchronously do not resume it too early
+     */
+    class completion_latch final
+    {
+    public:
+        explicit completion_latch(const size_t children) : _count(children + 1)
+        {}
+
+        /** Returns the waiter if this is the last arrival */
+        std::coroutine_handle<> arrive() noexcept
+        {
+            if (_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                return _waiter;
+
+            return std::noop_coroutine();
+        }
+
+        /** Suspends the waiter, starts the children and resumes the waiter if all of them have completed */
+        auto start(std::vector<child_task>& children)
+        {
+            struct start_awaiter
+            {
+                completion_latch& latch;
+                std::vector<child_task>& children;
+
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> waiter)
+                {
+                    latch._waiter = waiter;
+                    for (child_task& child: children)
+                        child.start();
+
+                    return latch.arrive();
+                }
+
+                void await_resume() noexcept
+                {}
+            };
+            return start_awaiter{ *this, children };
+        }
+
+    private:
+        std::atomic<size_t> _count;
+        std::coroutine_handle<> _waiter;
+    };
+
+    /** Shared by when_any and its children, the children which lose keep it alive until they complete */
+    template<class T>
+    struct when_any_state
+    {
+        std::atomic<bool> finished = false;
+        size_t index = 0;
+        task_result<T> result;
+        // The waiter and the first completed child arrive
+        completion_latch latch{ 1 };
+
+        std::coroutine_handle<> complete(const size_t child_index, task_result<T>& child_result) noexcept
+        {
+            if (finished.exchange(true, std::memory_order_acq_rel))
+                return std::noop_coroutine();
+
+            index = child_index;
+            result = std::move(child_result);
+            return latch.arrive();
+        }
+    };
+
+    template<class... Ts, size_t... Indices>
+    task<std::tuple<non_void_t<Ts>...>> when_all(std::index_sequence<Indices...>, task<Ts>... tasks);
+} // namespace local
+
+/**
+ * Lazy coroutine: it starts when it is awaited and resumes the awaiting coroutine by symmetric transfer when it
+ * completes, so chains of synchronously completing tasks do not grow the stack. A task is awaited once as an
+ * rvalue: co_await std::move(t). Frames are allocated from recycling pools, so after a warm-up creating tasks
+ * allocates nothing
+ */
+template<class T>
+class [[nodiscard]] task final
+{
+public:
+    struct promise_type : local::coroutine_promise<T>
+    {
+        task get_return_object() noexcept
+        {
+            return task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    task() = default;
+
+    task(const task& other) = delete;
+    task& operator=(const task& other) = delete;
+
+    task(task&& other) noexcept : _handle(std::exchange(other._handle, nullptr))
+    {}
+
+    task& operator=(task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~task()
+    {
+        reset();
+    }
+
+    [[nodiscard]] bool valid() const
+    {
+        return static_cast<bool>(_handle);
+    }
+
+    /** Throws std::future_error with no_state if the task is not valid */
+    auto operator co_await() &&
+    {
+        struct awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume()
+            {
+                return handle.promise().result.get();
+            }
+        };
+
+        if (!_handle)
+            throw std::future_error(std::future_errc::no_state);
+
+        return awaiter{ _handle };
+    }
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+
+    explicit task(const std::coroutine_handle<promise_type> handle) : _handle(handle)
+    {}
+
+    void reset()
+    {
+        if (_handle)
+            std::exchange(_handle, nullptr).destroy();
+    }
+};
+
+template<class T>
+T sync_wait(task<T> awaited)
+{
+    auto [promise, future] = make_task_promise<T>();
+
+    // The detached coroutine owns the awaited task and the promise, the shared state outlives both
+    [](task<T> detached, task_promise<T> result) -> local::detached_task
+    {
+        try
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                co_await std::move(detached);
+                result.set_value();
+            }
+            else
+            {
+                result.set_value(co_await std::move(detached));
+            }
+        } catch (...)
+        {
+            result.set_exception(std::current_exception());
+        }
+    }(std::move(awaited), std::move(promise));
+
+    return future.get();
+}
+
+/**
+ * Starts all tasks and completes when all of them complete, the tasks run concurrently if they hop onto a pool.
+ * Returns the results in the order of the tasks, void results are std::monostate. Rethrows the exception of the
+ * first failed task in that order
+ */
+template<class... Ts>
+task<std::tuple<local::non_void_t<Ts>...>> when_all(task<Ts>... tasks)
+{
+    return local::when_all(std::index_sequence_for<Ts...>{}, std::move(tasks)...);
+}
+
+/** when_all for a dynamic number of tasks of one type, returns task<void> for void tasks */
+template<class T>
+task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> when_all(std::vector<task<T>> tasks)
+{
+    std::vector<local::task_result<T>> results(tasks.size());
+    local::completion_latch latch(tasks.size());
+
+    {
+        std::vector<local::child_task> children;
+        children.reserve(tasks.size());
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            children.push_back(local::make_child(std::move(tasks[i]),
+                                                 [&results, &latch, i](local::task_result<T>& result) noexcept
+                                                 {
+                                                     results[i] = std::move(result);
+                                                     return latch.arrive();
+                                                 }));
+        }
+        co_await latch.start(children);
+    }
+
+    if constexpr (std::is_void_v<T>)
+    {
+        for (local::task_result<T>& result: results)
+            result.get();
+    }
+    else
+    {
+        std::vector<T> values;
+        values.reserve(results.size());
+        for (local::task_result<T>& result: results)
+            values.push_back(result.get());
+        co_return values;
+    }
+}
+
+/**
+ * Starts all tasks and completes when the first of them completes, returns its index and its result or rethrows
+ * its exception. The other tasks keep running and their results are dropped, so whatever they use must outlive
+ * them. The returned task throws std::invalid_argument if there are no tasks
+ */
+template<class T>
+task<std::pair<size_t, local::non_void_t<T>>> when_any(std::vector<task<T>> tasks)
+{
+    if (tasks.empty())
+        throw std::invalid_argument("when_any needs at least one task");
+
+    auto state = std::make_shared<local::when_any_state<T>>();
+
+    {
+        std::vector<local::child_task> children;
+        children.reserve(tasks.size());
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            children.push_back(local::make_child(std::move(tasks[i]),
+                                                 [state, i](local::task_result<T>& result) noexcept
+                                                 { return state->complete(i, result); }));
+        }
+        co_await state->latch.start(children);
+    }
+
+    co_return std::pair<size_t, local::non_void_t<T>>(state->index, state->result.get_non_void());
+}
+
+namespace local
+{
+    template<class... Ts, size_t... Indices>
+    task<std::tuple<non_void_t<Ts>...>> when_all(std::index_sequence<Indices...>, task<Ts>... tasks)
+    {
+        std::tuple<task_result<Ts>...> results;
+        completion_latch latch(sizeof...(Ts));
+
+        {
+            std::vector<child_task> children;
+            children.reserve(sizeof...(Ts));
+            (children.push_back(make_child(std::move(tasks),
+                                           [&results, &latch](task_result<Ts>& result) noexcept
+                                           {
+                                               std::get<Indices>(results) = std::move(result);
+                                               return latch.arrive();
+                                           })),
+             ...);
+            co_await latch.start(children);
+        }
+
+        // Braced initialization evaluates the results in order, so the first exception in order is rethrown
+        co_return std::tuple<non_void_t<Ts>...>{ std::get<Indices>(results).get_non_void()... };
+    }
+} // namespace local
+} // namespace concurrent
@@ -0,0 +1,402 @@
+#pragma once
+
+#include "recycling_pool.h"
+#include "unique_function.h"
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace concurrent
+{
+template<class T>
+class task_future;
+
+template<class T>
+class task_promise;
+
+/** Creates a connected promise/future pair, the shared state is taken from a recycling_pool */
+template<class T>
+std::pair<task_promise<T>, task_future<T>> make_task_promise();
+
+namespace local
+{
+    /**
+     * The result of a task shared by one task_promise and one task_future, a lighter std::promise state:
+     * no mutex, the readiness flag is waited on with atomic wait, the state is recycled by its last owner
+     */
+    template<class T>
+    class task_state final
+    {
+        struct void_result
+        {};
+        using value_type = std::conditional_t<std::is_void_v<T>, void_result, T>;
+
+    public:
+        template<class... Args>
+        void set_value(Args&&... args)
+        {
+            _result.template emplace<1>(std::forward<Args>(args)...);
+            make_ready();
+        }
+
+        void set_exception(std::exception_ptr exception)
+        {
+            _result.template emplace<2>(std::move(exception));
+            make_ready();
+        }
+
+        [[nodiscard]] bool is_ready() const
+        {
+            return _ready.load(std::memory_order_acquire) != 0;
+        }
+
+        void wait() const
+        {
+            _ready.wait(0, std::memory_order_acquire);
+        }
+
+        /** Waits for the result, rethrows the stored exception */
+        T get()
+        {
+            wait();
+
+            if (_result.index() == 2)
+                std::rethrow_exception(std::get<2>(_result));
+
+            if constexpr (!std::is_void_v<T>)
+                return std::move(std::get<1>(_result));
+        }
+
+        /** The promise and the future release the state, the last one recycles it */
+        void release()
+        {
+            if (_owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                recycling_pool<task_state>::destroy(this);
+        }
+
+        /**
+         * Invokes the continuation once the result is ready: right away if it is, otherwise by the thread
+         * which makes it ready. The continuation takes over the reference of the future
+         */
+        void set_continuation(unique_function<void()> continuation)
+        {
+            _continuation = std::move(continuation);
+            run_continuation_if_second();
+        }
+
+    private:
+        std::variant<std::monostate, value_type, std::exception_ptr> _result;
+        std::atomic<uint32_t> _ready = 0;
+        std::atomic<uint32_t> _owners = 2;
+
+        unique_function<void()> _continuation;
+        // The continuation is run by the second one of set_continuation and make_ready
+        std::atomic<bool> _continuation_arrived = false;
+
+        void make_ready()
+        {
+            _ready.store(1, std::memory_order_release);
+            _ready.notify_all();
+            run_continuation_if_second();
+        }
+
+        void run_continuation_if_second()
+        {
+            // Acquire-release publishes the result to the continuation and the continuation to the promise
+            if (_continuation_arrived.exchange(true, std::memory_order_acq_rel))
+                std::exchange(_continuation, nullptr)();
+        }
+    };
+
+    /** Owning reference to a task_state, used by continuations instead of the future */
+    template<class T>
+    class state_reference final
+    {
+    public:
+        explicit state_reference(task_state<T>* state) : _state(state)
+        {}
+
+        state_reference(const state_reference& other) = delete;
+        state_reference& operator=(const state_reference& other) = delete;
+
+        state_reference(state_reference&& other) noexcept : _state(std::exchange(other._state, nullptr))
+        {}
+
+        state_reference& operator=(state_reference&& other) = delete;
+
+        ~state_reference()
+        {
+            if (_state != nullptr)
+                _state->release();
+        }
+
+        task_state<T>* operator->() const
+        {
+            return _state;
+        }
+
+    private:
+        task_state<T>* _state;
+    };
+
+    template<class T, class F>
+    struct continuation_result
+    {
+        using type = std::invoke_result_t<F, T>;
+    };
+
+    template<class F>
+    struct continuation_result<void, F>
+    {
+        using type = std::invoke_result_t<F>;
+    };
+
+    template<class T, class F>
+    using continuation_result_t = typename continuation_result<T, F>::type;
+} // namespace local
+
+/**
+ * Move-only future of a task_promise, a lighter std::future without the std::shared_future features.
+ * get() may be called once, it invalidates the future
+ */
+template<class T>
+class task_future final
+{
+public:
+    task_future() = default;
+
+    task_future(const task_future& other) = delete;
+    task_future& operator=(const task_future& other) = delete;
+
+    task_future(task_future&& other) noexcept : _state(std::exchange(other._state, nullptr))
+    {}
+
+    task_future& operator=(task_future&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _state = std::exchange(other._state, nullptr);
+        }
+        return *this;
+    }
+
+    ~task_future()
+    {
+        reset();
+    }
+
+    [[nodiscard]] bool valid() const
+    {
+        return _state != nullptr;
+    }
+
+    /** Throws std::future_error with no_state if the future is not valid */
+    [[nodiscard]] bool is_ready() const
+    {
+        return checked_state()->is_ready();
+    }
+
+    /** Throws std::future_error with no_state if the future is not valid */
+    void wait() const
+    {
+        checked_state()->wait();
+    }
+
+    /**
+     * Waits for the result and returns it or rethrows the exception of the task. Throws std::future_error with
+     * broken_promise if the promise was destroyed without a result and with no_state if the future is not valid
+     */
+    T get()
+    {
+        local::task_state<T>* state = checked_state();
+        _state = nullptr;
+
+        // Releasing the state after the result is moved out of it
+        struct releaser
+        {
+            local::task_state<T>* state;
+            ~releaser()
+            {
+                state->release();
+            }
+        } release_on_exit{ state };
+
+        return state->get();
+    }
+
+    /**
+     * Posts function to the executor (a thread_pool) once the result is ready and returns the future of its
+     * result. function takes the value (nothing for void); an exception of this future is passed on without
+     * calling it. Invalidates this future, throws std::future_error with no_state if it is not valid.
+     * If the executor rejects the continuation, the returned future gets std::future_errc::broken_promise
+     */
+    template<class Executor, class F>
+    auto then(Executor& executor, F&& function)
+    {
+        using ReturnType = local::continuation_result_t<T, std::decay_t<F>>;
+
+        local::task_state<T>* state = checked_state();
+        auto [promise, future] = make_task_promise<ReturnType>();
+        _state = nullptr;
+
+        state->set_continuation(
+                [&executor, antecedent = local::state_reference<T>(state), promise = std::move(promise),
+                 function = std::forward<F>(function)]() mutable
+                {
+                    try
+                    {
+                        executor.post(
+                                [antecedent = std::move(antecedent), promise = std::move(promise),
+                                 function = std::move(function)]() mutable
+                                {
+                                    try
+                                    {
+                                        if constexpr (std::is_void_v<T>)
+                                        {
+                                            antecedent->get();
+                                            promise.set_from(std::move(function));
+                                        }
+                                        else
+                                        {
+                                            promise.set_from(std::move(function), antecedent->get());
+                                        }
+                                    } catch (...)
+                                    {
+                                        promise.set_exception(std::current_exception());
+                                    }
+                                });
+                    } catch (...)
+                    {
+                        // The rejected task is destroyed with the promise, which breaks it
+                    }
+                });
+
+        return std::move(future);
+    }
+
+private:
+    friend std::pair<task_promise<T>, task_future<T>> make_task_promise<T>();
+
+    local::task_state<T>* _state = nullptr;
+
+    explicit task_future(local::task_state<T>* state) : _state(state)
+    {}
+
+    local::task_state<T>* checked_state() const
+    {
+        if (_state == nullptr)
+            throw std::future_error(std::future_errc::no_state);
+
+        return _state;
+    }
+
+    void reset()
+    {
+        if (_state != nullptr)
+            std::exchange(_state, nullptr)->release();
+    }
+};
+
+/** Move-only promise of a task_future. A promise destroyed without a result sets std::future_errc::broken_promise */
+template<class T>
+class task_promise final
+{
+public:
+    task_promise() = default;
+
+    task_promise(const task_promise& other) = delete;
+    task_promise& operator=(const task_promise& other) = delete;
+
+    task_promise(task_promise&& other) noexcept : _state(std::exchange(other._state, nullptr))
+    {}
+
+    task_promise& operator=(task_promise&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _state = std::exchange(other._state, nullptr);
+        }
+        return *this;
+    }
+
+    ~task_promise()
+    {
+        reset();
+    }
+
+    /** The promise may be satisfied once, it is invalidated then */
+    template<class... Args>
+    void set_value(Args&&... args)
+    {
+        checked_state()->set_value(std::forward<Args>(args)...);
+        std::exchange(_state, nullptr)->release();
+    }
+
+    void set_exception(std::exception_ptr exception)
+    {
+        checked_state()->set_exception(std::move(exception));
+        std::exchange(_state, nullptr)->release();
+    }
+
+    /** Invokes the function and sets its result or its exception */
+    template<class F, class... Args>
+    void set_from(F&& function, Args&&... args)
+    {
+        try
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                std::invoke(std::forward<F>(function), std::forward<Args>(args)...);
+                set_value();
+            }
+            else
+            {
+                set_value(std::invoke(std::forward<F>(function), std::forward<Args>(args)...));
+            }
+        } catch (...)
+        {
+            set_exception(std::current_exception());
+        }
+    }
+
+private:
+    friend std::pair<task_promise<T>, task_future<T>> make_task_promise<T>();
+
+    local::task_state<T>* _state = nullptr;
+
+    explicit task_promise(local::task_state<T>* state) : _state(state)
+    {}
+
+    local::task_state<T>* checked_state() const
+    {
+        if (_state == nullptr)
+            throw std::future_error(std::future_errc::no_state);
+
+        return _state;
+    }
+
+    void reset()
+    {
+        if (_state == nullptr)
+            return;
+
+        _state->set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+        std::exchange(_state, nullptr)->release();
+    }
+};
+
+template<class T>
+std::pair<task_promise<T>, task_future<T>> make_task_promise()
+{
+    auto* state = recycling_pool<local::task_state<T>>::create();
+    return { task_promise<T>(state), task_future<T>(state) };
+}
+} // namespace concurrent
@@ -0,0 +1,141 @@
+#include "task_graph.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace concurrent
+{
+task_graph::node_id task_graph::add(unique_function<void()> work)
+{
+    auto new_node = std::make_unique<node>();
+    new_node->id = _nodes.size();
+    new_node->work = std::move(work);
+    _nodes.push_back(std::move(new_node));
+    _validated = false;
+
+    return _nodes.size() - 1;
+}
+
+void task_graph::precede(const node_id before, const node_id after)
+{
+    if (before >= _nodes.size() || after >= _nodes.size())
+        throw std::invalid_argument("task_graph node does not exist");
+    if (before == after)
+        throw std::invalid_argument("task_graph node cannot precede itself");
+
+    _nodes[before]->successors.push_back(_nodes[after].get());
+    _nodes[after]->dependencies++;
+    _validated = false;
+}
+
+void task_graph::run(thread_pool& pool)
+{
+    if (!_validated)
+        validate();
+
+    if (_nodes.empty())
+        return;
+
+    for (const auto& next_node: _nodes)
+        next_node->pending_dependencies.store(next_node->dependencies, std::memory_order_relaxed);
+    _pending_nodes.store(_nodes.size(), std::memory_order_relaxed);
+
+    // The counters above are published by the pushes, the calling thread runs the first root itself
+    for (size_t i = 1; i < _roots.size(); ++i)
+        schedule(pool, _roots[i]);
+    run_node(pool, _roots.front());
+
+    pool.wait_helping(_pending_nodes);
+
+    if (_failed.load(std::memory_order_relaxed))
+    {
+        _failed.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+}
+
+size_t task_graph::size() const
+{
+    return _nodes.size();
+}
+
+void task_graph::validate()
+{
+    // Kahn's algorithm: a node is reached after all of its dependencies, nodes on a cycle are never reached
+    _roots.clear();
+    std::vector<size_t> dependencies(_nodes.size());
+    for (size_t i = 0; i < _nodes.size(); ++i)
+    {
+        dependencies[i] = _nodes[i]->dependencies;
+        if (dependencies[i] == 0)
+            _roots.push_back(_nodes[i].get());
+    }
+
+    std::vector<node*> ready = _roots;
+    size_t reached = 0;
+    while (!ready.empty())
+    {
+        const node* next_node = ready.back();
+        ready.pop_back();
+        reached++;
+
+        for (node* successor: next_node->successors)
+        {
+            if (--dependencies[successor->id] == 0)
+                ready.push_back(successor);
+        }
+    }
+
+    if (reached != _nodes.size())
+        throw std::logic_error("task_graph has a cycle");
+
+    _validated = true;
+}
+
+void task_graph::schedule(thread_pool& pool, node* ready_node)
+{
+    try
+    {
+        pool.post([this, &pool, ready_node]() { run_node(pool, ready_node); });
+    } catch (const std::overflow_error&)
+    {
+        // A node may not be dropped, the run would never complete
+        run_node(pool, ready_node);
+    }
+}
+
+void task_graph::run_node(thread_pool& pool, node* next_node)
+{
+    while (next_node != nullptr)
+    {
+        if (!_failed.load(std::memory_order_relaxed))
+        {
+            try
+            {
+                next_node->work();
+            } catch (...)
+            {
+                if (!_failed.exchange(true, std::memory_order_relaxed))
+                    _exception = std::current_exception();
+            }
+        }
+
+        // The first ready successor continues in this task, the others are pushed for other workers to steal
+        node* continuation = nullptr;
+        for (node* successor: next_node->successors)
+        {
+            if (successor->pending_dependencies.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                continue;
+
+            if (continuation == nullptr)
+                continuation = successor;
+            else
+                schedule(pool, successor);
+        }
+
+        // The last access to the graph after the last node, run() may return right after the decrement
+        pool.count_down(_pending_nodes);
+        next_node = continuation;
+    }
+}
+} // namespace concurrent
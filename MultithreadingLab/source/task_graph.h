@@ -0,0 +1,73 @@
+#pragma once
+
+#include "thread_pool.h"
+#include "unique_function.h"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace concurrent
+{
+/**
+ * Directed acyclic graph of tasks run on a thread_pool. Every node has a counter of unfinished dependencies,
+ * a node completing decrements the counters of its successors and schedules the ones which become ready; one
+ * of them continues in the same pool task. Running reuses the nodes and their pool tasks are small enough to
+ * be stored inline, so repeated runs of a fixed graph allocate nothing after a warm-up.
+ * A graph may not be changed or run again while it runs
+ */
+class task_graph final
+{
+public:
+    using node_id = size_t;
+
+    task_graph() = default;
+
+    task_graph(const task_graph& other) = delete;
+    task_graph& operator=(const task_graph& other) = delete;
+
+    task_graph(task_graph&& other) = delete;
+    task_graph& operator=(task_graph&& other) = delete;
+
+    /** The work is invoked once per run */
+    node_id add(unique_function<void()> work);
+
+    /** after runs once before has completed. Throws std::invalid_argument for unknown nodes or a self-loop */
+    void precede(node_id before, node_id after);
+
+    /**
+     * Runs every node once and waits for all of them. The calling thread runs the first root and then
+     * pending tasks of the pool like task_group::sync(). After the first exception of a node the work of
+     * not started nodes is skipped and the exception is rethrown. Throws std::logic_error if the graph has
+     * a cycle
+     */
+    void run(thread_pool& pool);
+
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct node
+    {
+        node_id id = 0;
+        unique_function<void()> work;
+        std::vector<node*> successors;
+        size_t dependencies = 0;
+        std::atomic<size_t> pending_dependencies = 0;
+    };
+
+    // Pointers keep nodes in place, successors and pool tasks refer to them
+    std::vector<std::unique_ptr<node>> _nodes;
+    std::vector<node*> _roots;
+    bool _validated = true;
+
+    std::atomic<size_t> _pending_nodes = 0;
+    std::atomic<bool> _failed = false;
+    std::exception_ptr _exception;
+
+    void validate();
+    void schedule(thread_pool& pool, node* ready_node);
+    void run_node(thread_pool& pool, node* next_node);
+};
+} // namespace concurrent
@@ -0,0 +1,35 @@
+#include "task_group.h"
+
+namespace concurrent
+{
+task_group::task_group(thread_pool& pool) : _pool(pool)
+{}
+
+task_group::~task_group()
+{
+    wait();
+}
+
+void task_group::sync()
+{
+    wait();
+
+    if (_failed.load(std::memory_order_relaxed))
+    {
+        _failed.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+}
+
+void task_group::set_exception(std::exception_ptr exception)
+{
+    // Published to sync() by the release decrement of the pending counter
+    if (!_failed.exchange(true, std::memory_order_relaxed))
+        _exception = std::move(exception);
+}
+
+void task_group::wait()
+{
+    _pool.wait_helping(_pending);
+}
+} // namespace concurrent
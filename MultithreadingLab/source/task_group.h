@@ -0,0 +1,77 @@
+#pragma once
+
+#include "thread_pool.h"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <utility>
+
+namespace concurrent
+{
+/**
+ * Fork-join scope on a thread_pool: spawn() posts child tasks, sync() waits for all of them. The waiting thread
+ * runs pending tasks of the pool meanwhile, so a task may spawn and sync children without blocking its worker and
+ * recursive divide and conquer runs on a pool of any size without extra threads. sync() may return later than
+ * the children complete if the waiting thread is busy with another task. The group may be reused after sync()
+ */
+class task_group final
+{
+public:
+    explicit task_group(thread_pool& pool);
+
+    task_group(const task_group& other) = delete;
+    task_group& operator=(const task_group& other) = delete;
+
+    task_group(task_group&& other) = delete;
+    task_group& operator=(task_group&& other) = delete;
+
+    /** Waits for the children like sync(), but drops their exception */
+    ~task_group();
+
+    /**
+     * Posts a child task, the function and args are decay-copied like by thread_pool::post(). Throws
+     * std::overflow_error if the pool rejects the task, it is not performed then
+     */
+    template<class F, class... Args>
+    void spawn(F&& function, Args&&... args)
+    {
+        _pending.fetch_add(1, std::memory_order_relaxed);
+
+        try
+        {
+            _pool.post(
+                    [this, function = std::forward<F>(function), ... args = std::forward<Args>(args)]() mutable
+                    {
+                        try
+                        {
+                            std::invoke(std::move(function), std::move(args)...);
+                        } catch (...)
+                        {
+                            set_exception(std::current_exception());
+                        }
+
+                        // The last access to the group, it may be destroyed right after the decrement
+                        _pool.count_down(_pending);
+                    });
+        } catch (...)
+        {
+            _pending.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    /** Waits for all spawned children while helping the pool, rethrows the first exception of a child */
+    void sync();
+
+private:
+    thread_pool& _pool;
+    std::atomic<size_t> _pending = 0;
+
+    std::atomic<bool> _failed = false;
+    std::exception_ptr _exception;
+
+    void set_exception(std::exception_ptr exception);
+    void wait();
+};
+} // namespace concurrent
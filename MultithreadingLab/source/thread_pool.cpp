@@ -1,56 +1,761 @@
 #include "thread_pool.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace concurrent
 {
-thread_pool::thread_pool(const size_t size)
+namespace
+{
+// The pool and the worker index of the current thread, so nested pushes go to the local deque
+thread_local const thread_pool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+// Stealing and lane state of threads which help with pending tasks, workers keep theirs in run()
+thread_local uint64_t helper_random_state = 0;
+thread_local size_t helper_lane_turn = 0;
+// Pending tasks a thread runs inside each other while it helps
+thread_local size_t helper_depth = 0;
+
+// Helping takes the oldest injected, lane and stolen tasks too, which may help in turn without bound. Deeper a
+// worker only pops its own deque, which only the children of the tasks it runs refill from then on
+constexpr size_t max_helper_depth = 64;
+// Failed helping attempts of a thread in wait_helping() before it sleeps
+constexpr size_t max_failed_helping = 64;
+
+constexpr size_t critical_lane = static_cast<size_t>(task_priority::critical);
+constexpr size_t normal_lane = static_cast<size_t>(task_priority::normal);
+constexpr size_t background_lane = static_cast<size_t>(task_priority::background);
+
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+uint64_t nanoseconds(const std::chrono::steady_clock::duration duration)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+/** Adds the time from its construction to the idle time of a worker, unless the worker retires and stays idle */
+class idle_period final
+{
+public:
+    explicit idle_period(local::metrics_shard& shard) : _shard(shard)
+    {
+        _shard.begin_idle(std::chrono::steady_clock::now());
+    }
+
+    idle_period(const idle_period&) = delete;
+    idle_period& operator=(const idle_period&) = delete;
+
+    ~idle_period()
+    {
+        if (!_retired)
+            _shard.end_idle(std::chrono::steady_clock::now());
+    }
+
+    void retire()
+    {
+        _retired = true;
+    }
+
+private:
+    local::metrics_shard& _shard;
+    bool _retired = false;
+};
+#endif
+
+// Maximal number of injected tasks a worker moves to its own deque at once
+constexpr size_t max_injection_batch = 32;
+
+/** Spin loop hint, it lets the sibling hyper-thread run and saves power */
+void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+uint64_t next_random(uint64_t& state)
+{
+    // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+} // namespace
+
+thread_pool::thread_pool(const size_t size) : thread_pool(size, thread_pool_options{})
+{}
+
+thread_pool::thread_pool(const size_t size, const thread_pool_options& options) :
+    _min_workers(size), _grow_backlog(options.grow_backlog), _idle_timeout(options.idle_timeout),
+    _spin_pauses(options.spin_pauses), _spin_yields(options.spin_yields), _lane_weights(options.lane_weights),
+    _exception_handler(options.exception_handler)
 {
     if (size == 0)
         throw std::invalid_argument("thread_pool size must be greater than 0");
+    if (options.max_threads != 0 && options.max_threads < size)
+        throw std::invalid_argument("thread_pool max_threads must be 0 or not less than the size");
+
+    for (const size_t weight: _lane_weights)
+    {
+        if (weight == 0)
+            throw std::invalid_argument("thread_pool lane weights must be greater than 0");
+        _lane_weight_sum += weight;
+    }
+
+    // Nothing can change while a thread spins on a single core
+    if (std::thread::hardware_concurrency() == 1)
+        _spin_pauses = 0;
 
-    _threads.reserve(size);
+    if (options.injection == injection_queue::lock_free)
+        _lock_free_injected_tasks = std::make_unique<mpmc_queue<task*>>(options.injection_capacity, options.when_full);
 
+    const size_t max_size = std::max(size, options.max_threads);
+    _workers.reserve(max_size);
+    for (size_t i = 0; i < max_size; ++i)
+        _workers.push_back(std::make_unique<worker>());
+
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    // Workers of an elastic pool are idle until they are started
+    for (size_t i = size; i < max_size; ++i)
+        _workers[i]->metrics.begin_idle(_start_time);
+#endif
+
+    // Threads are started after all deques exist, any worker may steal from any other
+    std::scoped_lock lock(_resize_mutex);
     for (size_t i = 0; i < size; ++i)
-        _threads.emplace_back(std::bind_front(&thread_pool::run, this));
+        start_worker(i);
 }
 
 thread_pool::~thread_pool()
 {
-    // Requesting all threads to stop
-    for (auto& thread: _threads)
-        thread.request_stop();
+    // Requesting all threads to stop, no worker is started after that
+    {
+        std::scoped_lock lock(_resize_mutex);
+        _stopping = true;
+        for (const auto& worker: _workers)
+            worker->thread.request_stop();
+    }
 
-    // Explicitly join all threads before the mutex and cv are destructed.
-    for (auto& thread: _threads)
+    // Explicitly join all threads before the queues and cv are destructed.
+    for (const auto& worker: _workers)
+    {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+
+    // Tasks are not performed after a stop request, their futures get broken promises
+    for (const auto& worker: _workers)
+    {
+        while (task* pending_task = worker->tasks.pop())
+            recycling_pool<task>::destroy(pending_task);
+    }
+    for (task* pending_task: _injected_tasks)
+        recycling_pool<task>::destroy(pending_task);
+    if (_lock_free_injected_tasks)
+    {
+        while (const auto pending_task = _lock_free_injected_tasks->try_pop())
+            recycling_pool<task>::destroy(*pending_task);
+    }
+    for (auto& lane: _lanes)
     {
-        if (thread.joinable())
-            thread.join();
+        for (; !lane.tasks.empty(); lane.tasks.pop())
+            recycling_pool<task>::destroy(lane.tasks.top().queued_task);
     }
 }
 
-void thread_pool::run(const std::stop_token stop_token)
+size_t thread_pool::size() const
 {
-    while (true)
-    {
-        std::function<void()> next_task;
+    return _workers.size();
+}
+
+size_t thread_pool::thread_count() const
+{
+    return _running_workers.load(std::memory_order_relaxed);
+}
 
+void thread_pool::push(task* new_task)
+{
+    push(std::span(&new_task, 1));
+}
+
+void thread_pool::push(std::span<task*> new_tasks)
+{
+    if (new_tasks.empty())
+        return;
+
+    // Counted before the tasks become visible, so the counter never goes below the real number of tasks
+    _queued_tasks.fetch_add(new_tasks.size(), std::memory_order_seq_cst);
+
+    if (current_pool == this)
+    {
+        for (task* new_task: new_tasks)
+            _workers[current_worker]->tasks.push(new_task);
+    }
+    else if (_lock_free_injected_tasks)
+    {
+        size_t woken = 0;
+        for (size_t i = 0; i < new_tasks.size(); ++i)
         {
-            std::unique_lock lock(_tasks_mutex);
-            _cv.wait(lock, stop_token, [this]()
+            if (_lock_free_injected_tasks->try_push(new_tasks[i]))
+                continue;
+
+            // The queue is full: the pushed tasks need workers before a push waiting for a free slot
+            wake_workers(i - woken);
+            woken = i;
+
+            if (!_lock_free_injected_tasks->push(new_tasks[i]))
             {
-                return !_tasks.empty();
-            });
+                const auto rejected_tasks = new_tasks.subspan(i);
+                _queued_tasks.fetch_sub(rejected_tasks.size(), std::memory_order_relaxed);
+                for (task* rejected_task: rejected_tasks)
+                    recycling_pool<task>::destroy(rejected_task);
+
+                throw std::overflow_error("thread_pool injection queue is full");
+            }
+        }
+
+        wake_workers(new_tasks.size() - woken);
+        return;
+    }
+    else
+    {
+        std::scoped_lock lock(_injection_mutex);
+        _injected_tasks.insert(_injected_tasks.end(), new_tasks.begin(), new_tasks.end());
+    }
+
+    wake_workers(new_tasks.size());
+}
+
+void thread_pool::push(task* new_task, const task_options& options)
+{
+    if (options.priority == task_priority::normal && !options.deadline)
+        return push(new_task);
+
+    lane& target = _lanes[static_cast<size_t>(options.priority)];
+    _queued_tasks.fetch_add(1, std::memory_order_seq_cst);
+    try
+    {
+        std::scoped_lock lock(target.mutex);
+        target.tasks.push({ options.deadline.value_or(std::chrono::steady_clock::time_point::max()),
+                            target.next_sequence++, new_task });
+        target.size.fetch_add(1, std::memory_order_relaxed);
+    } catch (...)
+    {
+        _queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+        recycling_pool<task>::destroy(new_task);
+        throw;
+    }
+
+    wake_workers(1);
+}
+
+void thread_pool::wake_workers(const size_t new_tasks)
+{
+    // Pairs with the sleeping workers counter increment before the wait: either the worker sees the task
+    // or the pusher sees the worker
+    if (new_tasks == 0)
+        return;
+
+    // Threads sleeping in wait_helping() run the new tasks as well, they may be all workers there are
+    if (_sleeping_helpers.load(std::memory_order_seq_cst) != 0)
+    {
+        _completions.fetch_add(1, std::memory_order_release);
+        _completions.notify_all();
+    }
+
+    if (_sleeping_workers.load(std::memory_order_seq_cst) == 0)
+    {
+        // Every running worker is busy or about to take a task
+        if (_min_workers != _workers.size())
+            grow();
+        return;
+    }
+
+    // Locking prevents a notification between the predicate check and the wait of a worker
+    {
+        std::scoped_lock lock(_sleep_mutex);
+    }
+
+    if (new_tasks == 1)
+        _cv.notify_one();
+    else
+        _cv.notify_all();
+}
+
+void thread_pool::grow()
+{
+    const size_t running_workers = _running_workers.load(std::memory_order_relaxed);
+    if (running_workers == _workers.size() ||
+        _queued_tasks.load(std::memory_order_relaxed) <= running_workers * _grow_backlog)
+        return;
+
+    // Concurrent pushes do not wait for each other, one worker is enough for one of them
+    std::unique_lock lock(_resize_mutex, std::try_to_lock);
+    if (!lock.owns_lock() || _stopping)
+        return;
+
+    for (size_t i = 0; i < _workers.size(); ++i)
+    {
+        if (!_workers[i]->running)
+        {
+            start_worker(i);
+            return;
+        }
+    }
+}
+
+void thread_pool::start_worker(const size_t index)
+{
+    worker& new_worker = *_workers[index];
+
+    // The previous thread of the worker has retired, only its exit may be left
+    if (new_worker.thread.joinable())
+        new_worker.thread.join();
+
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    if (new_worker.metrics.idle_since.load(std::memory_order_relaxed) != 0)
+        new_worker.metrics.end_idle(std::chrono::steady_clock::now());
+#endif
+
+    new_worker.thread = std::jthread(std::bind_front(&thread_pool::run, this), index);
+    new_worker.running = true;
+    _running_workers.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool thread_pool::retire(const size_t index)
+{
+    std::scoped_lock lock(_resize_mutex);
+    if (_stopping || _running_workers.load(std::memory_order_relaxed) <= _min_workers)
+        return false;
+
+    // The deque of an idle worker is empty, only the worker itself pushes to it
+    _workers[index]->running = false;
+    _running_workers.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool thread_pool::spin_for_task(const std::stop_token& stop_token) const
+{
+    auto has_work = [this, &stop_token]()
+    { return _queued_tasks.load(std::memory_order_relaxed) > 0 || stop_token.stop_requested(); };
+
+    // Exponential backoff keeps the checks of the shared counter rare while the spinning gets longer
+    for (size_t pauses = 1; pauses <= _spin_pauses; pauses *= 2)
+    {
+        for (size_t i = 0; i < pauses; ++i)
+            cpu_relax();
+        if (has_work())
+            return true;
+    }
+
+    for (size_t i = 0; i < _spin_yields; ++i)
+    {
+        std::this_thread::yield();
+        if (has_work())
+            return true;
+    }
+
+    return false;
+}
+
+bool thread_pool::run_pending_task()
+{
+    const size_t index = current_pool == this ? current_worker : _workers.size();
+    task* next_task = nullptr;
+    if (helper_depth < max_helper_depth)
+    {
+        if (helper_random_state == 0)
+            helper_random_state = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+
+        next_task = take_task(index, helper_random_state, helper_lane_turn);
+    }
+    else if (index < _workers.size())
+    {
+        next_task = _workers[index]->tasks.pop();
+        if (next_task != nullptr)
+            _queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (next_task == nullptr)
+        return false;
+
+    helper_depth++;
+    run_task(next_task, index);
+    helper_depth--;
+    return true;
+}
+
+void thread_pool::wait_helping(const std::atomic<size_t>& pending)
+{
+    // A pending task may be queued where only a helping thread finds it, e.g. in the deque of this worker while
+    // all other workers wait as well. Finding none for a while, the remaining ones are run by other threads
+    size_t failed_attempts = 0;
+    while (pending.load(std::memory_order_acquire) != 0)
+    {
+        if (run_pending_task())
+        {
+            failed_attempts = 0;
+        }
+        else if (++failed_attempts < max_failed_helping)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            // Pairs with the check of wake_workers() like the sleep of a worker: either this thread sees
+            // the queued task or the pusher sees the sleeping helper and changes the value waited for
+            _sleeping_helpers.fetch_add(1, std::memory_order_seq_cst);
+
+            // Read before the counters, so a count_down() to zero or a push after the checks changes it
+            const uint32_t completions = _completions.load(std::memory_order_acquire);
+            if (_queued_tasks.load(std::memory_order_seq_cst) == 0 && pending.load(std::memory_order_acquire) != 0)
+                _completions.wait(completions, std::memory_order_acquire);
+
+            _sleeping_helpers.fetch_sub(1, std::memory_order_relaxed);
+            failed_attempts = 0;
+        }
+    }
+}
+
+void thread_pool::count_down(std::atomic<size_t>& pending)
+{
+    // Only the pool is accessed after the decrement, the counter may be gone
+    if (pending.fetch_sub(1, std::memory_order_release) != 1)
+        return;
+
+    _completions.fetch_add(1, std::memory_order_release);
+    _completions.notify_all();
+}
+
+thread_pool::task* thread_pool::take_injected_task(const size_t index)
+{
+    if (_lock_free_injected_tasks)
+        return _lock_free_injected_tasks->try_pop().value_or(nullptr);
+
+    std::scoped_lock lock(_injection_mutex);
+    if (_injected_tasks.empty())
+        return nullptr;
+
+    task* next_task = _injected_tasks.front();
+    _injected_tasks.pop_front();
+
+    if (index == _workers.size())
+        return next_task;
+
+    // Moving a share of the remaining tasks to the own deque saves lock acquisitions, other workers can steal them
+    const size_t batch = std::min(_injected_tasks.size() / _workers.size(), max_injection_batch);
+    for (size_t i = 0; i < batch; ++i)
+    {
+        _workers[index]->tasks.push(_injected_tasks.front());
+        _injected_tasks.pop_front();
+    }
+
+    return next_task;
+}
+
+thread_pool::task* thread_pool::take_lane_task(const size_t lane_index)
+{
+    lane& source = _lanes[lane_index];
+    if (source.size.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    std::scoped_lock lock(source.mutex);
+    if (source.tasks.empty())
+        return nullptr;
+
+    task* next_task = source.tasks.top().queued_task;
+    source.tasks.pop();
+    source.size.fetch_sub(1, std::memory_order_relaxed);
+
+    return next_task;
+}
+
+thread_pool::task* thread_pool::take_task(const size_t index, uint64_t& random_state, size_t& lane_turn)
+{
+    auto take_from = [this, index, &random_state](const size_t lane_index)
+    { return lane_index == normal_lane ? take_normal_task(index, random_state) : take_lane_task(lane_index); };
+
+    task* next_task = nullptr;
+    if (_lanes[critical_lane].size.load(std::memory_order_relaxed) == 0 &&
+        _lanes[background_lane].size.load(std::memory_order_relaxed) == 0)
+    {
+        next_task = take_normal_task(index, random_state);
+    }
+    else
+    {
+        // Weighted round-robin: the turns of a round are given to the lanes in priority order by their weights
+        size_t turn = lane_turn++ % _lane_weight_sum;
+        size_t chosen_lane = 0;
+        while (turn >= _lane_weights[chosen_lane])
+            turn -= _lane_weights[chosen_lane++];
+
+        next_task = take_from(chosen_lane);
+        for (size_t lane_index = 0; lane_index < task_priority_levels && next_task == nullptr; ++lane_index)
+        {
+            if (lane_index != chosen_lane)
+                next_task = take_from(lane_index);
+        }
+    }
+
+    if (next_task != nullptr)
+        _queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+
+    return next_task;
+}
+
+thread_pool::task* thread_pool::take_normal_task(const size_t index, uint64_t& random_state)
+{
+    const bool is_worker = index < _workers.size();
+    task* next_task = is_worker ? _workers[index]->tasks.pop() : nullptr;
+
+    // Tasks with a deadline go before the injected ones
+    if (next_task == nullptr)
+        next_task = take_lane_task(normal_lane);
+
+    if (next_task == nullptr)
+        next_task = take_injected_task(index);
+
+    if (next_task == nullptr && (!is_worker || _workers.size() > 1))
+    {
+        // Stealing from all other workers once, starting at a random one
+        const size_t first_victim = next_random(random_state) % _workers.size();
+        for (size_t i = 0; i < _workers.size() && next_task == nullptr; ++i)
+        {
+            const size_t victim = (first_victim + i) % _workers.size();
+            if (victim != index)
+                next_task = _workers[victim]->tasks.steal();
+        }
+
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+        if (next_task != nullptr)
+            record_steal(index);
+#endif
+    }
+
+    return next_task;
+}
+
+void thread_pool::run_task(task* next_task, [[maybe_unused]] const size_t index)
+{
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    // Only sampled tasks are timed unless tracing, the clock is read at most twice for a task
+    const bool timed = next_task->created != std::chrono::steady_clock::time_point{} ||
+                       _tracing.load(std::memory_order_relaxed);
+    const auto started = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+#endif
+
+    try
+    {
+        (*next_task)();
+    } catch (...)
+    {
+        // Only tasks pushed by post() may throw, others keep exceptions in their futures
+        if (_exception_handler)
+            _exception_handler(std::current_exception());
+    }
+
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    if (timed)
+        record_task(index, *next_task, started, std::chrono::steady_clock::now());
+    else
+        count_task(index);
+#endif
 
-            // Tasks are not performed after a stop request
-            if (stop_token.stop_requested())
-                break;
+    recycling_pool<task>::destroy(next_task);
+}
+
+thread_pool_metrics thread_pool::metrics() const
+{
+    thread_pool_metrics snapshot;
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    snapshot.queued_tasks = _queued_tasks.load(std::memory_order_relaxed);
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto elapsed = static_cast<double>(nanoseconds(now - _start_time));
+    auto add_shard = [&snapshot, now, elapsed](const local::metrics_shard& shard, worker_metrics& target)
+    {
+        target.executed_tasks = shard.executed_tasks.load(std::memory_order_acquire);
+        target.stolen_tasks = shard.stolen_tasks.load(std::memory_order_relaxed);
+        const auto idle = static_cast<double>(shard.idle_nanoseconds_until(now));
+        target.utilization = elapsed > 0 ? std::clamp(1.0 - idle / elapsed, 0.0, 1.0) : 0.0;
+        snapshot.queue_wait.merge(shard.queue_wait);
+        snapshot.execution.merge(shard.execution);
+    };
+
+    snapshot.workers.resize(_workers.size());
+    for (size_t i = 0; i < _workers.size(); ++i)
+        add_shard(_workers[i]->metrics, snapshot.workers[i]);
+    add_shard(_other_thread_metrics, snapshot.other_threads);
+    snapshot.other_threads.utilization = 0;
+#endif
+    return snapshot;
+}
+
+void thread_pool::start_trace([[maybe_unused]] const size_t max_spans)
+{
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    for (const auto& next_worker: _workers)
+    {
+        std::scoped_lock lock(next_worker->metrics.trace_mutex);
+        next_worker->metrics.trace.clear();
+    }
+    {
+        std::scoped_lock lock(_other_thread_metrics.trace_mutex);
+        _other_thread_metrics.trace.clear();
+    }
+
+    _max_trace_spans.store(max_spans, std::memory_order_relaxed);
+    _trace_start.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    _tracing.store(true, std::memory_order_release);
+#endif
+}
+
+void thread_pool::stop_trace()
+{
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    _tracing.store(false, std::memory_order_relaxed);
+#endif
+}
+
+void thread_pool::write_trace(std::ostream& output) const
+{
+    std::vector<trace_span> spans;
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    auto add_spans = [&spans](const local::metrics_shard& shard)
+    {
+        std::scoped_lock lock(shard.trace_mutex);
+        spans.insert(spans.end(), shard.trace.begin(), shard.trace.end());
+    };
+
+    for (const auto& next_worker: _workers)
+        add_spans(next_worker->metrics);
+    add_spans(_other_thread_metrics);
+
+    std::ranges::sort(spans, {}, &trace_span::start);
+#endif
+    write_chrome_trace(output, spans);
+}
+
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+void thread_pool::record_task(const size_t index, const task& done, const std::chrono::steady_clock::time_point started,
+                              const std::chrono::steady_clock::time_point finished)
+{
+    auto record = [&](local::metrics_shard& shard)
+    {
+        const uint64_t duration = nanoseconds(finished - started);
+        if (done.created != std::chrono::steady_clock::time_point{})
+        {
+            shard.queue_wait.record(nanoseconds(started - done.created));
+            shard.execution.record(duration);
+        }
+
+        if (_tracing.load(std::memory_order_acquire))
+        {
+            // Tasks started before the trace are left out
+            const std::chrono::steady_clock::time_point trace_start(
+                    std::chrono::steady_clock::duration(_trace_start.load(std::memory_order_relaxed)));
+            std::scoped_lock lock(shard.trace_mutex);
+            if (started >= trace_start && shard.trace.size() < _max_trace_spans.load(std::memory_order_relaxed))
+                shard.trace.push_back({ index, nanoseconds(started - trace_start), duration });
+        }
 
-            next_task = std::move(_tasks.front());
-            _tasks.pop();
+        // Released last, a reader seeing the count also sees the histograms and spans of the tasks
+        shard.executed_tasks.store(shard.executed_tasks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    };
+
+    if (index < _workers.size())
+    {
+        record(_workers[index]->metrics);
+    }
+    else
+    {
+        std::scoped_lock lock(_other_thread_metrics_mutex);
+        record(_other_thread_metrics);
+    }
+}
+
+void thread_pool::count_task(const size_t index)
+{
+    if (index < _workers.size())
+    {
+        local::metrics_shard& shard = _workers[index]->metrics;
+        shard.executed_tasks.store(shard.executed_tasks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    else
+    {
+        std::scoped_lock lock(_other_thread_metrics_mutex);
+        local::metrics_shard::increase(_other_thread_metrics.executed_tasks, 1);
+    }
+}
+
+void thread_pool::record_steal(const size_t index)
+{
+    if (index < _workers.size())
+    {
+        local::metrics_shard::increase(_workers[index]->metrics.stolen_tasks, 1);
+    }
+    else
+    {
+        std::scoped_lock lock(_other_thread_metrics_mutex);
+        local::metrics_shard::increase(_other_thread_metrics.stolen_tasks, 1);
+    }
+}
+#endif
+
+void thread_pool::run(const std::stop_token stop_token, const size_t index)
+{
+    current_pool = this;
+    current_worker = index;
+
+    uint64_t random_state = 0x9E3779B97F4A7C15ull * (index + 1);
+    size_t lane_turn = 0;
+
+    // Tasks are not performed after a stop request
+    while (!stop_token.stop_requested())
+    {
+        if (task* next_task = take_task(index, random_state, lane_turn))
+        {
+            run_task(next_task, index);
+            continue;
         }
 
-        next_task();
+        // Spinning saves the sleep and the wake-up of a worker whose next task comes soon
+        if (spin_for_task(stop_token))
+            continue;
+
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+        // Utilization is measured by the parked time, so neither running a task nor spinning reads the clock
+        idle_period idle(_workers[index]->metrics);
+#endif
+
+        std::unique_lock lock(_sleep_mutex);
+        _sleeping_workers.fetch_add(1, std::memory_order_seq_cst);
+        // A task may be counted but not found by take_task (a lost steal race or it is not pushed yet),
+        // then the worker just retries
+        auto has_task = [this]() { return _queued_tasks.load(std::memory_order_seq_cst) > 0; };
+        bool timed_out = false;
+        if (_min_workers == _workers.size())
+            _cv.wait(lock, stop_token, has_task);
+        else
+            timed_out = !_cv.wait_for(lock, stop_token, _idle_timeout, has_task);
+        _sleeping_workers.fetch_sub(1, std::memory_order_relaxed);
+
+        // A task pushed meanwhile is not lost: the remaining workers check the counter before they sleep and
+        // the pusher notifies the sleeping ones
+        if (timed_out && !stop_token.stop_requested() && retire(index))
+        {
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+            idle.retire();
+#endif
+            break;
+        }
     }
+
+    current_pool = nullptr;
 }
 } // concurrent
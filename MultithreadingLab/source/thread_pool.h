@@ -1,19 +1,103 @@
 #pragma once
 
+#include "mpmc_queue.h"
+#include "recycling_pool.h"
+#include "task_future.h"
+#include "thread_pool_metrics.h"
+#include "unique_function.h"
+#include "work_stealing_deque.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
+#include <ostream>
+#include <optional>
 #include <queue>
+#include <ranges>
+#include <span>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace concurrent
 {
+/** Queue of tasks pushed from threads which are not workers of the pool */
+enum class injection_queue
+{
+    locked,    // Unbounded queue behind a mutex
+    lock_free, // Bounded mpmc_queue, a push into the full queue follows the full policy
+};
+
+/** Lane of a task: higher lanes are taken more often, but never starve the lower ones */
+enum class task_priority
+{
+    critical,
+    normal,
+    background,
+};
+
+constexpr size_t task_priority_levels = 3;
+
+/** Scheduling of one task */
+struct task_options
+{
+    task_priority priority = task_priority::normal;
+    // Tasks of a lane with a deadline are taken earliest deadline first and before the ones without it
+    std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt;
+};
+
+struct thread_pool_options
+{
+    injection_queue injection = injection_queue::locked;
+    // Only used by the lock-free injection queue
+    size_t injection_capacity = 4096;
+    full_policy when_full = full_policy::block;
+    // Receives exceptions escaping tasks pushed by post(), they are ignored if it is empty
+    std::function<void(std::exception_ptr)> exception_handler = nullptr;
+    // Shares of the critical, normal and background lanes taken by a thread while all of them have tasks
+    std::array<size_t, task_priority_levels> lane_weights = { 8, 4, 1 };
+
+    // Elastic sizing if greater than the pool size: up to max_threads workers are started while pushes find no
+    // sleeping worker and more than grow_backlog queued tasks per running worker. A worker sleeping longer than
+    // the idle timeout stops while more than the pool size are running
+    size_t max_threads = 0;
+    size_t grow_backlog = 4;
+    std::chrono::milliseconds idle_timeout{ 1000 };
+
+    // Before sleeping an idle worker checks for tasks after pause loops of exponentially growing length up to
+    // spin_pauses iterations (not on a single core), then after every of spin_yields yields. Zero for both sleeps
+    // right away
+    size_t spin_pauses = 256;
+    size_t spin_yields = 8;
+};
+
+/**
+ * Work-stealing thread pool. Every worker owns a Chase-Lev deque: tasks pushed from inside a worker go to
+ * its own deque, tasks pushed from other threads go to the shared injection queue. A worker takes tasks from
+ * its deque first (LIFO), then from the injection queue, then steals from other workers starting at a random
+ * victim (FIFO). Idle workers spin briefly, then sleep on a condition variable and are only woken if there is
+ * a sleeping one.
+ * These queues form the normal lane. Tasks pushed with a critical or background priority or a deadline wait in
+ * shared lane queues instead, ordered by deadline. While other lanes have tasks, every thread chooses the lane
+ * of its next task by weighted round-robin and falls back to the other lanes in priority order
+ */
 class thread_pool final
 {
 public:
     explicit thread_pool(const size_t size);
+    /**
+     * Starts size workers. Throws std::invalid_argument if size, the injection capacity or a lane weight is zero
+     * or max_threads is not zero and less than size
+     */
+    thread_pool(const size_t size, const thread_pool_options& options);
 
     thread_pool(const thread_pool& other) = delete;
     thread_pool& operator=(const thread_pool& other) = delete;
@@ -23,42 +107,314 @@ public:
 
     ~thread_pool();
 
+    /**
+     * The task result is provided by std::future. Throws std::overflow_error if the lock-free injection queue
+     * is full and its full policy is reject, the task is not performed then. The same holds for submit and post
+     */
     template<class F, class... Args>
     auto push_task(F&& function, Args&&... args) -> std::future<decltype(function(args...))>
     {
         using ReturnType = decltype(function(args...));
 
-        // Binding function with its args to one callable object
-        std::function<ReturnType()> callable = std::bind(std::forward<F>(function), std::forward<Args>(args)...);
-        // Creating a packaged task to provide the future object.
-        // It is encapsulated into a shared ptr in order to have a copy semantic
-        auto task_ptr = std::make_shared<std::packaged_task<ReturnType()>>(std::move(callable));
+        // Binding function with its args to one callable object, the packaged task provides the future object
+        std::packaged_task<ReturnType()> bound_task(std::bind(std::forward<F>(function), std::forward<Args>(args)...));
+        std::future<ReturnType> result_future = bound_task.get_future();
+
+        push(recycling_pool<task>::create([bound_task = std::move(bound_task)]() mutable
+        {
+            bound_task();
+        }));
+
+        return result_future;
+    }
+
+    /**
+     * Like push_task, but the result is provided by task_future with a recycled shared state and the task is
+     * stored inline if the function with its args fit, so a small task allocates nothing after a warm-up.
+     * The function and args are decay-copied and moved into the call
+     */
+    template<class F, class... Args, class ReturnType = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    task_future<ReturnType> submit(F&& function, Args&&... args)
+    {
+        return submit(task_options{}, std::forward<F>(function), std::forward<Args>(args)...);
+    }
+
+    /**
+     * submit() into the lane of the options. Lane queues are unbounded, only a normal task without a deadline
+     * goes to the injection queue and may be rejected
+     */
+    template<class F, class... Args, class ReturnType = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    task_future<ReturnType> submit(const task_options& options, F&& function, Args&&... args)
+    {
+        auto [promise, future] = make_task_promise<ReturnType>();
+
+        push(recycling_pool<task>::create(
+                     [promise = std::move(promise), function = std::forward<F>(function),
+                      ... args = std::forward<Args>(args)]() mutable
+                     { promise.set_from(std::move(function), std::move(args)...); }),
+             options);
+
+        return std::move(future);
+    }
+
+    /**
+     * Fire-and-forget task without a future, the result is discarded. Exceptions are passed to
+     * the exception handler of the options. A small task allocates nothing after a warm-up
+     */
+    template<class F, class... Args>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, task_options>)
+    void post(F&& function, Args&&... args)
+    {
+        post(task_options{}, std::forward<F>(function), std::forward<Args>(args)...);
+    }
 
-        // Getting the task's future for return
-        std::future<ReturnType> result_future = task_ptr->get_future();
+    /** post() into the lane of the options, like submit() with options */
+    template<class F, class... Args>
+    void post(const task_options& options, F&& function, Args&&... args)
+    {
+        if constexpr (sizeof...(Args) == 0)
+        {
+            push(recycling_pool<task>::create(std::forward<F>(function)), options);
+        }
+        else
+        {
+            push(recycling_pool<task>::create(
+                         [function = std::forward<F>(function), ... args = std::forward<Args>(args)]() mutable
+                         { std::invoke(std::move(function), std::move(args)...); }),
+                 options);
+        }
+    }
+
+    /**
+     * Posts every callable of the range like post(), but takes the injection lock once and wakes the workers
+     * once. Elements of an rvalue range are moved. If the lock-free injection queue rejects some of the tasks,
+     * they are not performed and std::overflow_error is thrown, the pushed ones are performed
+     */
+    template<std::ranges::input_range Range>
+    void push_tasks(Range&& tasks)
+    {
+        std::vector<task*> new_tasks;
+        if constexpr (std::ranges::sized_range<Range>)
+            new_tasks.reserve(std::ranges::size(tasks));
 
+        try
         {
-            std::scoped_lock lock(_tasks_mutex);
-            // Wrapping the task into void function to store any type of functions in the queue
-            _tasks.emplace([task_ptr]
+            for (auto&& next_task: tasks)
             {
-                (*task_ptr)();
-            });
+                if constexpr (std::is_lvalue_reference_v<Range>)
+                    new_tasks.push_back(recycling_pool<task>::create(next_task));
+                else
+                    new_tasks.push_back(recycling_pool<task>::create(std::move(next_task)));
+            }
+        } catch (...)
+        {
+            for (task* created_task: new_tasks)
+                recycling_pool<task>::destroy(created_task);
+            throw;
         }
 
-        // Waking up one waiting thread
-        _cv.notify_one();
+        push(new_tasks);
+    }
 
-        return result_future;
+    /**
+     * Awaitable which resumes the awaiting coroutine in a task of the pool: co_await pool.schedule(). The task
+     * is pushed like by post(), a rejected one throws std::overflow_error from the co_await. A coroutine whose
+     * task is dropped by the destructor of the pool is never resumed
+     */
+    auto schedule(const task_options& options = {})
+    {
+        struct schedule_awaiter
+        {
+            thread_pool& pool;
+            task_options options;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> awaiting)
+            {
+                pool.post(options, [awaiting]() { awaiting.resume(); });
+            }
+
+            void await_resume() const noexcept
+            {}
+        };
+        return schedule_awaiter{ *this, options };
     }
 
+    /**
+     * Runs one pending task on the calling thread, returns false if there is none. A worker of the pool takes it
+     * like its own next task, other threads take injected tasks or steal. A thread waiting for other tasks of
+     * the pool calls it to help instead of blocking a worker. A thread nests at most 64 tasks this way, deeper
+     * a worker only runs the tasks of its own deque and other threads get false
+     */
+    bool run_pending_task();
+
+    /**
+     * Waits for the counter of pending tasks of the pool to reach zero, helping with run_pending_task() meanwhile.
+     * When the thread finds no task for a while it sleeps until a count_down() of any counter reaches zero
+     * or a task is pushed
+     */
+    void wait_helping(const std::atomic<size_t>& pending);
+
+    /** Decrements a counter of wait_helping(), which may return and let the owner of the counter go right after */
+    void count_down(std::atomic<size_t>& pending);
+
+    /** Number of workers, the maximal one of an elastic pool */
+    [[nodiscard]] size_t size() const;
+
+    /** Number of running workers, it changes over time in an elastic pool */
+    [[nodiscard]] size_t thread_count() const;
+
+    /** Snapshot of the metrics since the start of the pool, empty unless thread_pool_metrics_enabled */
+    [[nodiscard]] thread_pool_metrics metrics() const;
+
+    /**
+     * Starts recording the spans of tasks, up to max_spans per thread, and discards the recorded ones.
+     * Tracing only works if thread_pool_metrics_enabled
+     */
+    void start_trace(const size_t max_spans = 1 << 16);
+    void stop_trace();
+    /** Writes the recorded spans as Chrome trace_event JSON */
+    void write_trace(std::ostream& output) const;
+
 private:
-    std::queue<std::function<void()>> _tasks;
-    std::mutex _tasks_mutex;
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    // A sampled task knows when it was created for the queue wait metric, others keep the zero time point.
+    // The inline storage gives up the bytes of the time point, so a task fills one cache line as without metrics
+    struct task
+    {
+        unique_function<void(), 48 - sizeof(std::chrono::steady_clock::time_point)> function;
+        std::chrono::steady_clock::time_point created;
+
+        template<class F>
+        explicit task(F&& new_function) : function(std::forward<F>(new_function))
+        {
+            if (local::sample_task())
+                created = std::chrono::steady_clock::now();
+        }
+
+        void operator()()
+        {
+            function();
+        }
+    };
+    static_assert(sizeof(task) == sizeof(unique_function<void()>));
+#else
+    using task = unique_function<void()>;
+#endif
+
+    struct worker
+    {
+        work_stealing_deque<task> tasks;
+        std::jthread thread;
+        // Guarded by the resize mutex, a stopped worker keeps its finished thread until it is started again
+        bool running = false;
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+        local::metrics_shard metrics;
+#endif
+    };
+
+    struct lane_entry
+    {
+        // Tasks without a deadline have the latest one and keep the push order
+        std::chrono::steady_clock::time_point deadline;
+        uint64_t sequence = 0;
+        task* queued_task = nullptr;
+
+        bool operator>(const lane_entry& other) const
+        {
+            return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+        }
+    };
+
+    struct lane
+    {
+        std::priority_queue<lane_entry, std::vector<lane_entry>, std::greater<>> tasks;
+        uint64_t next_sequence = 0;
+        std::mutex mutex;
+        // Read without the lock, so threads skip empty lanes cheaply
+        alignas(64) std::atomic<size_t> size = 0;
+    };
+
+    // Every worker an elastic pool may start exists from the beginning, so the vector never changes
+    std::vector<std::unique_ptr<worker>> _workers;
+    size_t _min_workers = 0;
+    size_t _grow_backlog = 0;
+    std::chrono::milliseconds _idle_timeout;
+    alignas(64) std::atomic<size_t> _running_workers = 0;
+    std::mutex _resize_mutex;
+    bool _stopping = false;
+
+    size_t _spin_pauses = 0;
+    size_t _spin_yields = 0;
+
+    // Only the tasks of the normal lane with a deadline wait in its lane queue
+    std::array<lane, task_priority_levels> _lanes;
+    std::array<size_t, task_priority_levels> _lane_weights;
+    size_t _lane_weight_sum = 0;
+
+    std::deque<task*> _injected_tasks;
+    std::mutex _injection_mutex;
+    // Replaces the locked injection queue if it is not null
+    std::unique_ptr<mpmc_queue<task*>> _lock_free_injected_tasks;
+
+    // Number of tasks in all queues, sleeping workers wait for it to become non-zero
+    alignas(64) std::atomic<size_t> _queued_tasks = 0;
+    alignas(64) std::atomic<size_t> _sleeping_workers = 0;
+    // Threads sleeping in wait_helping(), pushes wake them through _completions
+    std::atomic<size_t> _sleeping_helpers = 0;
+    // Changed by every count_down() to zero and by pushes while helpers sleep, wait_helping() waits on it
+    std::atomic<uint32_t> _completions = 0;
+    std::mutex _sleep_mutex;
     std::condition_variable_any _cv;
 
-    std::vector<std::jthread> _threads;
+    std::function<void(std::exception_ptr)> _exception_handler;
+
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+    // Shared by the threads which are not workers, guarded by the mutex for writing
+    local::metrics_shard _other_thread_metrics;
+    std::mutex _other_thread_metrics_mutex;
+    std::chrono::steady_clock::time_point _start_time = std::chrono::steady_clock::now();
+
+    alignas(64) std::atomic<bool> _tracing = false;
+    std::atomic<size_t> _max_trace_spans = 0;
+    std::atomic<std::chrono::steady_clock::rep> _trace_start = 0;
+
+    void record_task(const size_t index, const task& done, const std::chrono::steady_clock::time_point started,
+                     const std::chrono::steady_clock::time_point finished);
+    /** Counts an untimed task */
+    void count_task(const size_t index);
+    void record_steal(const size_t index);
+#endif
+
+    /** Takes the ownership of the tasks created by recycling_pool */
+    void push(task* new_task);
+    void push(std::span<task*> new_tasks);
+    void push(task* new_task, const task_options& options);
+
+    void wake_workers(const size_t new_tasks);
+
+    /** Starts a stopped worker if the pool is elastic and the backlog is large enough */
+    void grow();
+    void start_worker(const size_t index);
+    /** Called by an idle worker, returns false if it has to keep running */
+    bool retire(const size_t index);
+    /** Returns true if a task is queued or stop is requested before the spinning ends */
+    bool spin_for_task(const std::stop_token& stop_token) const;
+
+    /**
+     * The index of the worker or the number of workers for other threads, which have no deque.
+     * The lane turn counts the choices of the weighted round-robin of the calling thread
+     */
+    task* take_task(const size_t index, uint64_t& random_state, size_t& lane_turn);
+    task* take_normal_task(const size_t index, uint64_t& random_state);
+    task* take_lane_task(const size_t lane_index);
+    task* take_injected_task(const size_t index);
+    void run_task(task* next_task, const size_t index);
 
-    void run(const std::stop_token stop_token);
+    void run(const std::stop_token stop_token, const size_t index);
 };
 } // namespace concurrent
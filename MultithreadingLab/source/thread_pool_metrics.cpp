@@ -0,0 +1,112 @@
+#include "thread_pool_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+namespace concurrent
+{
+latency_histogram::latency_histogram(const latency_histogram& other)
+{
+    merge(other);
+}
+
+latency_histogram& latency_histogram::operator=(const latency_histogram& other)
+{
+    if (this == &other)
+        return *this;
+
+    for (auto& counter: _counts)
+        counter.store(0, std::memory_order_relaxed);
+    _count.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+
+    merge(other);
+    return *this;
+}
+
+void latency_histogram::merge(const latency_histogram& other)
+{
+    for (size_t i = 0; i < bucket_count; ++i)
+        increase(_counts[i], other._counts[i].load(std::memory_order_relaxed));
+    increase(_count, other._count.load(std::memory_order_relaxed));
+    increase(_sum, other._sum.load(std::memory_order_relaxed));
+
+    const uint64_t other_max = other._max.load(std::memory_order_relaxed);
+    if (other_max > _max.load(std::memory_order_relaxed))
+        _max.store(other_max, std::memory_order_relaxed);
+}
+
+uint64_t latency_histogram::count() const
+{
+    return _count.load(std::memory_order_relaxed);
+}
+
+uint64_t latency_histogram::max() const
+{
+    return _max.load(std::memory_order_relaxed);
+}
+
+double latency_histogram::mean() const
+{
+    const uint64_t values = count();
+    return values == 0 ? 0.0 : static_cast<double>(_sum.load(std::memory_order_relaxed)) / static_cast<double>(values);
+}
+
+uint64_t latency_histogram::percentile(const double percent) const
+{
+    if (!(percent >= 0.0 && percent <= 100.0))
+        throw std::invalid_argument("latency_histogram percentile must be in [0, 100]");
+
+    // The counts are summed instead of using the total, which a concurrent writer may have updated in between
+    uint64_t values = 0;
+    for (const auto& counter: _counts)
+        values += counter.load(std::memory_order_relaxed);
+    if (values == 0)
+        return 0;
+
+    const double exact_rank = std::ceil(percent / 100.0 * static_cast<double>(values));
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(exact_rank));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < bucket_count; ++i)
+    {
+        seen += _counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(bucket_upper_bound(i), max());
+    }
+
+    return max();
+}
+
+uint64_t latency_histogram::bucket_upper_bound(const size_t index)
+{
+    if (index < 2 * half_bucket_count)
+        return index;
+
+    // The inverse of bucket_index, the last bucket ends at the maximal value by the unsigned wrap-around
+    const size_t shift = index / half_bucket_count - 1;
+    const uint64_t sub_bucket = index % half_bucket_count + half_bucket_count;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+void write_chrome_trace(std::ostream& output, const std::span<const trace_span> spans)
+{
+    // Timestamps and durations of trace events are microseconds, nanoseconds are kept as three decimals
+    auto write_microseconds = [&output](const uint64_t nanoseconds)
+    { output << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000; };
+
+    output << R"({"displayTimeUnit":"ns","traceEvents":[)";
+    for (size_t i = 0; i < spans.size(); ++i)
+    {
+        output << (i == 0 ? "\n" : ",\n") << R"({"name":"task","ph":"X","pid":0,"tid":)" << spans[i].thread
+               << R"(,"ts":)";
+        write_microseconds(spans[i].start);
+        output << R"(,"dur":)";
+        write_microseconds(spans[i].duration);
+        output << '}';
+    }
+    output << "\n]}\n";
+}
+} // namespace concurrent
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace concurrent
+{
+/** thread_pool collects metrics and traces only if CONCURRENT_THREAD_POOL_METRICS is defined for all its users */
+#ifdef CONCURRENT_THREAD_POOL_METRICS
+constexpr bool thread_pool_metrics_enabled = true;
+#else
+constexpr bool thread_pool_metrics_enabled = false;
+#endif
+
+/**
+ * One of so many tasks is timed for the latency histograms, the counters include every task. A timed task reads
+ * the clock three times, sampling spreads that over the other tasks, which are only counted
+ */
+constexpr size_t metrics_sample_period = 256;
+
+/**
+ * Histogram of durations in nanoseconds in the style of HdrHistogram: buckets are linear below 64 and log-linear
+ * above with 32 buckets per power of two, so any value is kept with a relative error under 3.2%.
+ * One thread may record while others read or merge the histogram, the counters are relaxed atomics which the
+ * only writer updates without read-modify-write instructions
+ */
+class latency_histogram final
+{
+public:
+    latency_histogram() = default;
+
+    latency_histogram(const latency_histogram& other);
+    latency_histogram& operator=(const latency_histogram& other);
+
+    void record(const uint64_t value) noexcept
+    {
+        increase(_counts[bucket_index(value)], 1);
+        increase(_count, 1);
+        increase(_sum, value);
+        if (value > _max.load(std::memory_order_relaxed))
+            _max.store(value, std::memory_order_relaxed);
+    }
+
+    /** Adds the values of other, which may be recorded concurrently */
+    void merge(const latency_histogram& other);
+
+    [[nodiscard]] uint64_t count() const;
+    [[nodiscard]] uint64_t max() const;
+    [[nodiscard]] double mean() const;
+
+    /**
+     * The value below or at which the given percent of values are, the upper bound of its bucket but not more
+     * than the maximum. 0 for an empty histogram, throws std::invalid_argument if percent is not in [0, 100]
+     */
+    [[nodiscard]] uint64_t percentile(const double percent) const;
+
+private:
+    static constexpr unsigned precision_bits = 6;
+    static constexpr size_t half_bucket_count = size_t{ 1 } << (precision_bits - 1);
+    static constexpr size_t bucket_count = (66 - precision_bits) * half_bucket_count;
+
+    std::array<std::atomic<uint64_t>, bucket_count> _counts{};
+    std::atomic<uint64_t> _count = 0;
+    std::atomic<uint64_t> _sum = 0;
+    std::atomic<uint64_t> _max = 0;
+
+    static size_t bucket_index(const uint64_t value) noexcept
+    {
+        // The highest precision_bits bits of the value select the bucket within its power of two
+        const auto width = static_cast<unsigned>(std::bit_width(value));
+        if (width <= precision_bits)
+            return static_cast<size_t>(value);
+
+        const unsigned shift = width - precision_bits;
+        return shift * half_bucket_count + static_cast<size_t>(value >> shift);
+    }
+
+    static uint64_t bucket_upper_bound(const size_t index);
+
+    static void increase(std::atomic<uint64_t>& counter, const uint64_t value) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+};
+
+/** Metrics of one worker since the start of the pool */
+struct worker_metrics
+{
+    uint64_t executed_tasks = 0;
+    // Tasks taken from the deques of other workers
+    uint64_t stolen_tasks = 0;
+    // Share of the time since the start of the pool not spent parked (sleeping or stopped), spinning counts as busy
+    double utilization = 0;
+};
+
+/** Snapshot of the metrics of a thread_pool, merged from the shards of its threads when read */
+struct thread_pool_metrics
+{
+    // Tasks in all queues at the time of reading
+    size_t queued_tasks = 0;
+    std::vector<worker_metrics> workers;
+    // Tasks run by other threads helping with pending tasks, their utilization is not measured
+    worker_metrics other_threads;
+    // Of the sampled tasks from their creation to their start
+    latency_histogram queue_wait;
+    // Of the sampled tasks, a task running other pending tasks like a task_group::sync() includes them
+    latency_histogram execution;
+};
+
+/** Task run by a thread of a pool, the thread is the index of a worker or the number of workers for others */
+struct trace_span
+{
+    size_t thread = 0;
+    // Nanoseconds since the start of the trace
+    uint64_t start = 0;
+    uint64_t duration = 0;
+};
+
+/** Writes Chrome trace_event JSON with a complete event per span, it opens in chrome://tracing or Perfetto */
+void write_chrome_trace(std::ostream& output, std::span<const trace_span> spans);
+
+namespace local
+{
+/** Whether the task created next by the calling thread is timed */
+inline bool sample_task() noexcept
+{
+    static_assert(std::has_single_bit(metrics_sample_period));
+    static thread_local size_t created_tasks = 0;
+    return (created_tasks++ & (metrics_sample_period - 1)) == 0;
+}
+
+/** Metrics written by one thread at a time and read by any */
+struct alignas(64) metrics_shard
+{
+    std::atomic<uint64_t> executed_tasks = 0;
+    std::atomic<uint64_t> stolen_tasks = 0;
+    // Finished parked periods of a worker, the current one started at idle_since unless it is zero
+    std::atomic<uint64_t> idle_nanoseconds = 0;
+    std::atomic<std::chrono::steady_clock::rep> idle_since = 0;
+    latency_histogram queue_wait;
+    latency_histogram execution;
+
+    mutable std::mutex trace_mutex;
+    std::vector<trace_span> trace;
+
+    static void increase(std::atomic<uint64_t>& counter, const uint64_t value) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    void begin_idle(const std::chrono::steady_clock::time_point now) noexcept
+    {
+        idle_since.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    void end_idle(const std::chrono::steady_clock::time_point now) noexcept
+    {
+        increase(idle_nanoseconds, idle_nanoseconds_until(now));
+        idle_since.store(0, std::memory_order_relaxed);
+    }
+
+    /** Including the current idle period */
+    uint64_t idle_nanoseconds_until(const std::chrono::steady_clock::time_point now) const noexcept
+    {
+        const auto since = idle_since.load(std::memory_order_relaxed);
+        const auto current = since == 0 ? std::chrono::steady_clock::duration::zero()
+                                        : now.time_since_epoch() - std::chrono::steady_clock::duration(since);
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(current).count());
+    }
+};
+} // namespace local
+} // namespace concurrent
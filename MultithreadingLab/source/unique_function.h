@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace concurrent
+{
+template<class Signature, size_t InlineSize = 48>
+class unique_function;
+
+/**
+ * Move-only type-erased callable, like std::move_only_function. Callables of at most InlineSize bytes
+ * which are nothrow movable are stored inline, so wrapping them allocates nothing; bigger ones are
+ * allocated on the heap. Calling an empty unique_function throws std::bad_function_call
+ */
+template<class R, class... Args, size_t InlineSize>
+class unique_function<R(Args...), InlineSize> final
+{
+    static_assert(InlineSize >= sizeof(void*), "Inline storage must fit a pointer to a heap allocated callable");
+
+public:
+    /** True if F is stored without a heap allocation */
+    template<class F>
+    static constexpr bool is_inline = sizeof(F) <= InlineSize && alignof(F) <= alignof(std::max_align_t) &&
+                                      std::is_nothrow_move_constructible_v<F>;
+
+    unique_function() noexcept = default;
+
+    unique_function(std::nullptr_t) noexcept
+    {}
+
+    template<class F>
+        requires(!std::is_same_v<std::decay_t<F>, unique_function> &&
+                 std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    unique_function(F&& function)
+    {
+        using Function = std::decay_t<F>;
+
+        if constexpr (is_inline<Function>)
+        {
+            std::construct_at(reinterpret_cast<Function*>(_storage), std::forward<F>(function));
+            _operations = &inline_operations<Function>;
+        }
+        else
+        {
+            *reinterpret_cast<Function**>(_storage) = new Function(std::forward<F>(function));
+            _operations = &heap_operations<Function>;
+        }
+    }
+
+    unique_function(const unique_function& other) = delete;
+    unique_function& operator=(const unique_function& other) = delete;
+
+    unique_function(unique_function&& other) noexcept
+    {
+        take(other);
+    }
+
+    unique_function& operator=(unique_function&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~unique_function()
+    {
+        reset();
+    }
+
+    R operator()(Args... args)
+    {
+        if (_operations == nullptr)
+            throw std::bad_function_call();
+
+        return _operations->invoke(_storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return _operations != nullptr;
+    }
+
+private:
+    struct operations
+    {
+        R (*invoke)(std::byte* storage, Args&&... args);
+        // Move-constructs the callable into the empty destination and destroys the source
+        void (*relocate)(std::byte* from, std::byte* to) noexcept;
+        void (*destroy)(std::byte* storage) noexcept;
+    };
+
+    template<class F>
+    static F* inline_callable(std::byte* storage)
+    {
+        return std::launder(reinterpret_cast<F*>(storage));
+    }
+
+    template<class F>
+    static F*& heap_callable(std::byte* storage)
+    {
+        return *std::launder(reinterpret_cast<F**>(storage));
+    }
+
+    template<class F>
+    static constexpr operations inline_operations{
+        [](std::byte* storage, Args&&... args) -> R
+        { return std::invoke(*inline_callable<F>(storage), std::forward<Args>(args)...); },
+        [](std::byte* from, std::byte* to) noexcept
+        {
+            std::construct_at(reinterpret_cast<F*>(to), std::move(*inline_callable<F>(from)));
+            std::destroy_at(inline_callable<F>(from));
+        },
+        [](std::byte* storage) noexcept { std::destroy_at(inline_callable<F>(storage)); },
+    };
+
+    template<class F>
+    static constexpr operations heap_operations{
+        [](std::byte* storage, Args&&... args) -> R
+        { return std::invoke(*heap_callable<F>(storage), std::forward<Args>(args)...); },
+        [](std::byte* from, std::byte* to) noexcept
+        { *reinterpret_cast<F**>(to) = std::exchange(heap_callable<F>(from), nullptr); },
+        [](std::byte* storage) noexcept { delete heap_callable<F>(storage); },
+    };
+
+    alignas(std::max_align_t) std::byte _storage[InlineSize];
+    const operations* _operations = nullptr;
+
+    void take(unique_function& other) noexcept
+    {
+        if (other._operations != nullptr)
+        {
+            other._operations->relocate(other._storage, _storage);
+            _operations = std::exchange(other._operations, nullptr);
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (_operations != nullptr)
+        {
+            _operations->destroy(_storage);
+            _operations = nullptr;
+        }
+    }
+};
+} // namespace concurrent
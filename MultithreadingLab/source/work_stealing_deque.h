@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace concurrent
+{
+/**
+ * Chase-Lev work-stealing deque of pointers (Le, Pop, Cohen, Nardelli, "Correct and Efficient Work-Stealing
+ * for Weak Memory Models"). The owner thread pushes and pops at the bottom (LIFO), any other thread steals
+ * from the top (FIFO). Push and pop are lock-free and take no read-modify-write unless the deque has one
+ * element left, steal is a single CAS. The deque does not own the pointed objects.
+ * Seq-cst accesses are used instead of stand-alone fences, which thread sanitizer does not understand
+ */
+template<class T>
+class work_stealing_deque final
+{
+public:
+    explicit work_stealing_deque(const size_t capacity = 256)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("work_stealing_deque capacity must be greater than 0");
+
+        _arrays.push_back(std::make_unique<circular_array>(std::bit_ceil(capacity)));
+        _array.store(_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    work_stealing_deque(const work_stealing_deque& other) = delete;
+    work_stealing_deque& operator=(const work_stealing_deque& other) = delete;
+
+    work_stealing_deque(work_stealing_deque&& other) = delete;
+    work_stealing_deque& operator=(work_stealing_deque&& other) = delete;
+
+    ~work_stealing_deque() = default;
+
+    /** Owner thread only. The storage grows when it is full */
+    void push(T* item)
+    {
+        const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        const int64_t top = _top.load(std::memory_order_acquire);
+        circular_array* array = _array.load(std::memory_order_relaxed);
+
+        if (bottom - top >= static_cast<int64_t>(array->capacity()))
+            array = grow(array, top, bottom);
+
+        array->put(bottom, item);
+        // Publishes the item to thieves which read the bottom
+        _bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    /** Owner thread only. Returns the most recently pushed item or nullptr if the deque is empty */
+    T* pop()
+    {
+        const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        circular_array* array = _array.load(std::memory_order_relaxed);
+        // Reserving the bottom item must be ordered before reading the top
+        _bottom.exchange(bottom, std::memory_order_seq_cst);
+        int64_t top = _top.load(std::memory_order_seq_cst);
+
+        if (top > bottom)
+        {
+            // Empty
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = array->get(bottom);
+        if (top == bottom)
+        {
+            // The last item, racing with thieves for it
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = nullptr;
+
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    /** Any thread. Returns the least recently pushed item or nullptr if the deque is empty or a race was lost */
+    T* steal()
+    {
+        int64_t top = _top.load(std::memory_order_seq_cst);
+        const int64_t bottom = _bottom.load(std::memory_order_seq_cst);
+
+        if (top >= bottom)
+            return nullptr;
+
+        // The array may be replaced by the owner meanwhile, but old arrays stay alive until destruction
+        T* item = _array.load(std::memory_order_acquire)->get(top);
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return item;
+    }
+
+    /** Approximate number of items, exact for the owner if there are no concurrent thieves */
+    [[nodiscard]] size_t size() const
+    {
+        const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        const int64_t top = _top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return size() == 0;
+    }
+
+    [[nodiscard]] size_t capacity() const
+    {
+        return _array.load(std::memory_order_relaxed)->capacity();
+    }
+
+private:
+    class circular_array
+    {
+    public:
+        explicit circular_array(const size_t capacity) : _mask(capacity - 1), _items(capacity)
+        {}
+
+        [[nodiscard]] size_t capacity() const
+        {
+            return _items.size();
+        }
+
+        [[nodiscard]] T* get(const int64_t index) const
+        {
+            return _items[static_cast<size_t>(index) & _mask].load(std::memory_order_relaxed);
+        }
+
+        void put(const int64_t index, T* item)
+        {
+            _items[static_cast<size_t>(index) & _mask].store(item, std::memory_order_relaxed);
+        }
+
+    private:
+        size_t _mask;
+        std::vector<std::atomic<T*>> _items;
+    };
+
+    alignas(64) std::atomic<int64_t> _top = 0;
+    alignas(64) std::atomic<int64_t> _bottom = 0;
+    alignas(64) std::atomic<circular_array*> _array;
+
+    // Retired arrays are kept, a thief may still read an item from them. Owner thread only
+    std::vector<std::unique_ptr<circular_array>> _arrays;
+
+    circular_array* grow(const circular_array* array, const int64_t top, const int64_t bottom)
+    {
+        auto bigger = std::make_unique<circular_array>(array->capacity() * 2);
+        for (int64_t i = top; i < bottom; ++i)
+            bigger->put(i, array->get(i));
+
+        _arrays.push_back(std::move(bigger));
+        _array.store(_arrays.back().get(), std::memory_order_release);
+
+        return _arrays.back().get();
+    }
+};
+} // namespace concurrent
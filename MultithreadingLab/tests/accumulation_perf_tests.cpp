@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include "accumulation.h"
+#include "thread_pool.h"
+#include "thread_scaling.h"
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+/**
+ * Accumulation of size ones by the given number of threads.
+ * Speedup and efficiency are reported relative to the single thread run of the same size
+ */
+static void BM_AccumulateScaling(benchmark::State& state)
+{
+    const auto threads = static_cast<size_t>(state.range(0));
+    const auto size = static_cast<size_t>(state.range(1));
+    if (!utility::tests::fits_in_memory(size * sizeof(int)))
+    {
+        state.SkipWithError("Not enough memory for the input");
+        return;
+    }
+
+    // The input is shared by all thread counts of the same size, which run one after another because the first list
+    // of ArgsProduct varies fastest. Ones do not overflow the sum
+    static std::vector<int> nums;
+    if (nums.size() != size)
+    {
+        nums.clear();
+        nums.shrink_to_fit();
+        nums.resize(size, 1);
+    }
+
+    double seconds = 0;
+    for (auto _: state)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(concurrent::accumulate(nums, threads));
+        const auto finish = std::chrono::steady_clock::now();
+
+        const double iteration_seconds = std::chrono::duration<double>(finish - start).count();
+        state.SetIterationTime(iteration_seconds);
+        seconds += iteration_seconds;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.SetBytesProcessed(state.iterations() * state.range(1) * static_cast<int64_t>(sizeof(int)));
+    utility::tests::publish_scaling(state, "accumulate/" + std::to_string(size), threads, seconds);
+}
+
+BENCHMARK(BM_AccumulateScaling)
+        ->ArgNames({ "threads", "size" })
+        ->ArgsProduct({ utility::tests::scaling_thread_counts(), utility::tests::scaling_sizes() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+
+/**
+ * Accumulation of size ones by parallel_for on the calling thread and a pool of threads - 1 workers. The single
+ * thread run sums on the calling thread alone, so it is a true baseline
+ */
+static void BM_PoolAccumulateScaling(benchmark::State& state)
+{
+    const auto threads = static_cast<size_t>(state.range(0));
+    const auto size = static_cast<size_t>(state.range(1));
+    if (!utility::tests::fits_in_memory(size * sizeof(int)))
+    {
+        state.SkipWithError("Not enough memory for the input");
+        return;
+    }
+
+    const std::vector<int> nums(size, 1);
+    std::optional<concurrent::thread_pool> pool;
+    if (threads > 1)
+        pool.emplace(threads - 1);
+
+    double seconds = 0;
+    for (auto _: state)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(pool ? concurrent::accumulate(*pool, nums) : concurrent::accumulate(nums, 1));
+        const auto finish = std::chrono::steady_clock::now();
+
+        const double iteration_seconds = std::chrono::duration<double>(finish - start).count();
+        state.SetIterationTime(iteration_seconds);
+        seconds += iteration_seconds;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.SetBytesProcessed(state.iterations() * state.range(1) * static_cast<int64_t>(sizeof(int)));
+    utility::tests::publish_scaling(state, "pool_accumulate/" + std::to_string(size), threads, seconds);
+}
+
+BENCHMARK(BM_PoolAccumulateScaling)
+        ->ArgNames({ "threads", "size" })
+        ->ArgsProduct({ utility::tests::scaling_thread_counts(), utility::tests::scaling_sizes() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+
+//--benchmark_filter=<regex>
+BENCHMARK_MAIN();
@@ -0,0 +1,45 @@
+#include "accumulation.h"
+#include "thread_pool.h"
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+TEST(AccumulationTest, ZeroThreads)
+{
+    EXPECT_THROW(concurrent::accumulate({ 1, 2, 3 }, 0), std::invalid_argument);
+}
+
+TEST(AccumulationTest, Empty)
+{
+    EXPECT_EQ(concurrent::accumulate({}), 0);
+}
+
+TEST(AccumulationTest, SmallInput)
+{
+    EXPECT_EQ(concurrent::accumulate({ 1, 2, 3, 4, 5 }, 4), 15);
+}
+
+TEST(AccumulationTest, ThreadCounts)
+{
+    std::vector<int> nums(10'007);
+    std::iota(nums.begin(), nums.end(), -5'000);
+    const int expected = std::accumulate(nums.begin(), nums.end(), 0);
+
+    for (const size_t threads: { 1, 2, 3, 7, 16 })
+        EXPECT_EQ(concurrent::accumulate(nums, threads), expected) << "threads: " << threads;
+}
+
+TEST(AccumulationTest, ThreadPool)
+{
+    std::vector<int> nums(100'003);
+    std::iota(nums.begin(), nums.end(), -50'000);
+    const int expected = std::accumulate(nums.begin(), nums.end(), 0);
+
+    for (const size_t threads: { 1, 2, 5 })
+    {
+        concurrent::thread_pool pool(threads);
+        EXPECT_EQ(concurrent::accumulate(pool, nums), expected) << "threads: " << threads;
+        EXPECT_EQ(concurrent::accumulate(pool, {}), 0);
+    }
+}
@@ -0,0 +1,178 @@
+#include "mpmc_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static_assert(!std::is_copy_constructible_v<concurrent::mpmc_queue<int>>);
+static_assert(!std::is_move_constructible_v<concurrent::mpmc_queue<int>>);
+
+TEST(MpmcQueueTest, ZeroCapacity)
+{
+    EXPECT_THROW(concurrent::mpmc_queue<int>(0), std::invalid_argument);
+}
+
+TEST(MpmcQueueTest, CapacityIsPowerOfTwo)
+{
+    const concurrent::mpmc_queue<int> queue(100);
+    EXPECT_EQ(queue.capacity(), 128);
+}
+
+TEST(MpmcQueueTest, MinimalCapacity)
+{
+    concurrent::mpmc_queue<int> queue(1);
+    EXPECT_EQ(queue.capacity(), 2);
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_FALSE(queue.try_push(3));
+}
+
+TEST(MpmcQueueTest, EmptyQueue)
+{
+    concurrent::mpmc_queue<int> queue(4);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop().has_value());
+}
+
+TEST(MpmcQueueTest, Fifo)
+{
+    concurrent::mpmc_queue<int> queue(4);
+    for (int i = 0; i < 10; ++i)
+    {
+        // Wrapping around the ring several times
+        EXPECT_TRUE(queue.try_push(i));
+        EXPECT_TRUE(queue.try_push(i + 100));
+        EXPECT_EQ(queue.size(), 2);
+        EXPECT_EQ(queue.try_pop(), i);
+        EXPECT_EQ(queue.try_pop(), i + 100);
+    }
+}
+
+TEST(MpmcQueueTest, TryPushIntoFullQueue)
+{
+    concurrent::mpmc_queue<std::unique_ptr<int>> queue(2);
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(1)));
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(2)));
+
+    // The rejected value is not moved from
+    auto value = std::make_unique<int>(3);
+    EXPECT_FALSE(queue.try_push(std::move(value)));
+    ASSERT_NE(value, nullptr);
+
+    EXPECT_EQ(*queue.try_pop().value(), 1);
+    EXPECT_TRUE(queue.try_push(std::move(value)));
+    EXPECT_EQ(*queue.try_pop().value(), 2);
+    EXPECT_EQ(*queue.try_pop().value(), 3);
+}
+
+TEST(MpmcQueueTest, RejectPolicy)
+{
+    concurrent::mpmc_queue<int> queue(2, concurrent::full_policy::reject);
+    EXPECT_EQ(queue.policy(), concurrent::full_policy::reject);
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_FALSE(queue.push(3));
+    EXPECT_EQ(queue.try_pop(), 1);
+}
+
+TEST(MpmcQueueTest, DestroysRemainingValues)
+{
+    const auto value = std::make_shared<int>(1);
+    {
+        concurrent::mpmc_queue<std::shared_ptr<int>> queue(4);
+        queue.try_push(value);
+        queue.try_push(value);
+        EXPECT_EQ(value.use_count(), 3);
+    }
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+class MpmcQueuePolicyTest : public testing::TestWithParam<concurrent::full_policy>
+{};
+
+// Producers fill the tiny queue much faster than it is drained, so they hit the full policy all the time
+TEST_P(MpmcQueuePolicyTest, BlockedProducersResume)
+{
+    concurrent::mpmc_queue<int> queue(2, GetParam());
+
+    std::jthread producer([&queue]()
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            // Rejected values are pushed again
+            while (!queue.push(i))
+                std::this_thread::yield();
+        }
+    });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        std::optional<int> value;
+        while (!(value = queue.try_pop()))
+            std::this_thread::yield();
+        EXPECT_EQ(value, i);
+    }
+}
+
+// Every pushed value is popped exactly once, values of one producer are popped in the order of pushes
+TEST_P(MpmcQueuePolicyTest, StressTest)
+{
+    constexpr size_t producer_num = 4;
+    constexpr size_t consumer_num = 4;
+    constexpr size_t value_num = 5000;
+
+    concurrent::mpmc_queue<std::pair<size_t, size_t>> queue(64, GetParam());
+    std::vector<std::atomic<int>> popped(producer_num * value_num);
+    std::atomic<size_t> popped_num{ 0 };
+    std::atomic<bool> in_order{ true };
+
+    std::vector<std::jthread> threads;
+    for (size_t c = 0; c < consumer_num; ++c)
+    {
+        threads.emplace_back([&]()
+        {
+            std::vector<size_t> last(producer_num, 0);
+            while (popped_num.load() != popped.size())
+            {
+                if (const auto value = queue.try_pop())
+                {
+                    const auto [producer, index] = *value;
+                    if (index + 1 <= last[producer])
+                        in_order = false;
+                    last[producer] = index + 1;
+
+                    popped[producer * value_num + index].fetch_add(1);
+                    popped_num.fetch_add(1);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (size_t p = 0; p < producer_num; ++p)
+    {
+        threads.emplace_back([&queue, p]()
+        {
+            for (size_t i = 0; i < value_num;)
+            {
+                // Rejected values are pushed again
+                if (queue.push(std::pair{ p, i }))
+                    ++i;
+            }
+        });
+    }
+    threads.clear();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(std::ranges::all_of(popped, [](const std::atomic<int>& count) { return count.load() == 1; }));
+}
+
+INSTANTIATE_TEST_SUITE_P(FullPolicies, MpmcQueuePolicyTest,
+                         testing::Values(concurrent::full_policy::block, concurrent::full_policy::spin,
+                                         concurrent::full_policy::reject));
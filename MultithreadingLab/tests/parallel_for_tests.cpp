@@ -0,0 +1,139 @@
+#include "parallel_for.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class ParallelForTest : public testing::TestWithParam<concurrent::chunking>
+{};
+
+TEST_P(ParallelForTest, VisitsEveryIndexOnce)
+{
+    concurrent::thread_pool pool(3);
+
+    for (const int grain: { 1, 3, 16, 1000 })
+    {
+        std::vector<std::atomic<int>> visits(997);
+        concurrent::parallel_for(
+                pool, 0, static_cast<int>(visits.size()), grain, [&visits](const int i) { visits[i]++; },
+                GetParam());
+
+        for (size_t i = 0; i < visits.size(); ++i)
+            ASSERT_EQ(visits[i].load(), 1) << "grain: " << grain << ", index: " << i;
+    }
+}
+
+TEST_P(ParallelForTest, ChunksCoverRange)
+{
+    concurrent::thread_pool pool(2);
+    std::vector<std::atomic<int>> visits(500);
+    std::atomic<int> chunks{ 0 };
+
+    concurrent::parallel_for(
+            pool, size_t{ 100 }, visits.size(), size_t{ 7 },
+            [&visits, &chunks](const size_t first, const size_t last)
+            {
+                EXPECT_LT(first, last);
+                for (size_t i = first; i < last; ++i)
+                    visits[i]++;
+                chunks++;
+            },
+            GetParam());
+
+    for (size_t i = 0; i < visits.size(); ++i)
+        ASSERT_EQ(visits[i].load(), i < 100 ? 0 : 1) << "index: " << i;
+    EXPECT_GE(chunks.load(), 1);
+}
+
+TEST_P(ParallelForTest, NegativeIndices)
+{
+    concurrent::thread_pool pool(2);
+    std::atomic<int> sum{ 0 };
+    concurrent::parallel_for(pool, -50, 51, 4, [&sum](const int i) { sum += i; }, GetParam());
+    EXPECT_EQ(sum.load(), 0);
+}
+
+TEST_P(ParallelForTest, ExceptionIsRethrown)
+{
+    concurrent::thread_pool pool(2);
+    EXPECT_THROW(concurrent::parallel_for(
+                         pool, 0, 1000, 10,
+                         [](const int i)
+                         {
+                             if (i == 555)
+                                 throw std::runtime_error("failed");
+                         },
+                         GetParam()),
+                 std::runtime_error);
+
+    // The pool is still usable
+    std::atomic<int> counter{ 0 };
+    concurrent::parallel_for(pool, 0, 100, 10, [&counter](int) { counter++; }, GetParam());
+    EXPECT_EQ(counter.load(), 100);
+}
+
+TEST_P(ParallelForTest, NestedInPoolTasks)
+{
+    // Every worker is busy with an outer iteration, the inner loops are done by the waiting threads
+    concurrent::thread_pool pool(2);
+    std::atomic<int> counter{ 0 };
+    concurrent::parallel_for(
+            pool, 0, 8, 1,
+            [&pool, &counter](int)
+            { concurrent::parallel_for(pool, 0, 100, 5, [&counter](int) { counter++; }, GetParam()); },
+            GetParam());
+    EXPECT_EQ(counter.load(), 800);
+}
+
+TEST_P(ParallelForTest, ForEach)
+{
+    concurrent::thread_pool pool(3);
+    std::vector<int> nums(1001);
+    std::iota(nums.begin(), nums.end(), 0);
+
+    concurrent::parallel_for_each(pool, nums, 8, [](int& x) { x *= 2; }, GetParam());
+
+    for (size_t i = 0; i < nums.size(); ++i)
+        ASSERT_EQ(nums[i], 2 * static_cast<int>(i));
+}
+
+INSTANTIATE_TEST_SUITE_P(Chunkings, ParallelForTest,
+                         testing::Values(concurrent::chunking::static_chunks, concurrent::chunking::dynamic_chunks,
+                                         concurrent::chunking::guided_chunks));
+
+TEST(ParallelForTest, InvalidArguments)
+{
+    concurrent::thread_pool pool(1);
+    EXPECT_THROW(concurrent::parallel_for(pool, 0, 10, 0, [](int) {}), std::invalid_argument);
+    EXPECT_THROW(concurrent::parallel_for(pool, 10, 0, 1, [](int) {}), std::invalid_argument);
+}
+
+TEST(ParallelForTest, EmptyRange)
+{
+    concurrent::thread_pool pool(1);
+    bool called = false;
+    concurrent::parallel_for(pool, 5, 5, 1, [&called](int) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(ParallelForTest, CallingThreadParticipates)
+{
+    // The only worker is blocked, the calling thread has to do all the iterations
+    concurrent::thread_pool pool(1);
+    std::atomic<bool> release{ false };
+    pool.post(
+            [&release]()
+            {
+                while (!release.load())
+                    std::this_thread::yield();
+            });
+
+    int sum = 0;
+    concurrent::parallel_for(pool, 0, 100, 10, [&sum](const int i) { sum += i; });
+    EXPECT_EQ(sum, 4950);
+
+    release = true;
+}
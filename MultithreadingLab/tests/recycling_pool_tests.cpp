@@ -0,0 +1,91 @@
+#include "recycling_pool.h"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct tracked
+{
+    static inline int alive = 0;
+    int value;
+
+    explicit tracked(const int in_value) : value(in_value)
+    {
+        if (value < 0)
+            throw std::invalid_argument("Negative value");
+        alive++;
+    }
+
+    ~tracked()
+    {
+        alive--;
+    }
+};
+
+using pool = concurrent::recycling_pool<tracked>;
+} // namespace
+
+TEST(RecyclingPoolTest, CreateAndDestroy)
+{
+    tracked* object = pool::create(5);
+    EXPECT_EQ(object->value, 5);
+    EXPECT_EQ(tracked::alive, 1);
+
+    pool::destroy(object);
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(RecyclingPoolTest, ReusesReleasedBlocks)
+{
+    tracked* first = pool::create(1);
+    pool::destroy(first);
+
+    tracked* second = pool::create(2);
+    EXPECT_EQ(second, first);
+    pool::destroy(second);
+}
+
+TEST(RecyclingPoolTest, ConstructorExceptionReleasesBlock)
+{
+    EXPECT_THROW(pool::create(-1), std::invalid_argument);
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(RecyclingPoolTest, DistinctLiveObjects)
+{
+    std::vector<tracked*> objects;
+    for (int i = 0; i < 1000; ++i)
+        objects.push_back(pool::create(i));
+
+    EXPECT_EQ(std::set(objects.begin(), objects.end()).size(), objects.size());
+    for (size_t i = 0; i < objects.size(); ++i)
+        EXPECT_EQ(objects[i]->value, static_cast<int>(i));
+
+    for (tracked* object: objects)
+        pool::destroy(object);
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+// Objects created by one thread and destroyed by another move through the shared list in batches
+TEST(RecyclingPoolTest, ProducerAndConsumerThreads)
+{
+    constexpr int object_num = 10000;
+    std::vector<tracked*> objects(object_num);
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < object_num; ++i)
+            objects[i] = pool::create(i);
+
+        std::jthread consumer([&objects]()
+        {
+            for (tracked* object: objects)
+                pool::destroy(object);
+        });
+    }
+    EXPECT_EQ(tracked::alive, 0);
+}
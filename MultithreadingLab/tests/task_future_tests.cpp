@@ -0,0 +1,180 @@
+#include "task_future.h"
+#include "thread_pool.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+static_assert(!std::is_copy_constructible_v<concurrent::task_future<int>>);
+static_assert(std::is_nothrow_move_constructible_v<concurrent::task_future<int>>);
+static_assert(!std::is_copy_constructible_v<concurrent::task_promise<int>>);
+
+TEST(TaskFutureTest, DefaultFutureHasNoState)
+{
+    concurrent::task_future<int> future;
+    EXPECT_FALSE(future.valid());
+    EXPECT_THROW(future.get(), std::future_error);
+    EXPECT_THROW(future.wait(), std::future_error);
+}
+
+TEST(TaskFutureTest, SetValue)
+{
+    auto [promise, future] = concurrent::make_task_promise<std::string>();
+    EXPECT_TRUE(future.valid());
+    EXPECT_FALSE(future.is_ready());
+
+    promise.set_value("result");
+    EXPECT_TRUE(future.is_ready());
+    EXPECT_EQ(future.get(), "result");
+    EXPECT_FALSE(future.valid());
+}
+
+TEST(TaskFutureTest, VoidValue)
+{
+    auto [promise, future] = concurrent::make_task_promise<void>();
+    promise.set_value();
+    EXPECT_NO_THROW(future.get());
+}
+
+TEST(TaskFutureTest, MoveOnlyValue)
+{
+    auto [promise, future] = concurrent::make_task_promise<std::unique_ptr<int>>();
+    promise.set_value(std::make_unique<int>(7));
+    EXPECT_EQ(*future.get(), 7);
+}
+
+TEST(TaskFutureTest, SetException)
+{
+    auto [promise, future] = concurrent::make_task_promise<int>();
+    promise.set_exception(std::make_exception_ptr(std::runtime_error("Error")));
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(TaskFutureTest, PromiseIsSatisfiedOnce)
+{
+    auto [promise, future] = concurrent::make_task_promise<int>();
+    promise.set_value(1);
+    EXPECT_THROW(promise.set_value(2), std::future_error);
+    EXPECT_EQ(future.get(), 1);
+}
+
+TEST(TaskFutureTest, SetFrom)
+{
+    auto [value_promise, value_future] = concurrent::make_task_promise<int>();
+    value_promise.set_from([](const int a, const int b) { return a * b; }, 3, 4);
+    EXPECT_EQ(value_future.get(), 12);
+
+    auto [error_promise, error_future] = concurrent::make_task_promise<void>();
+    error_promise.set_from([]() { throw std::runtime_error("Error"); });
+    EXPECT_THROW(error_future.get(), std::runtime_error);
+}
+
+TEST(TaskFutureTest, BrokenPromise)
+{
+    concurrent::task_future<int> future;
+    {
+        auto [promise, connected_future] = concurrent::make_task_promise<int>();
+        future = std::move(connected_future);
+    }
+
+    try
+    {
+        future.get();
+        FAIL() << "std::future_error expected";
+    } catch (const std::future_error& error)
+    {
+        EXPECT_EQ(error.code(), std::future_errc::broken_promise);
+    }
+}
+
+TEST(TaskFutureTest, FutureDestroyedFirst)
+{
+    auto [promise, future] = concurrent::make_task_promise<int>();
+    {
+        auto destroyed = std::move(future);
+    }
+    EXPECT_NO_THROW(promise.set_value(1));
+}
+
+TEST(TaskFutureTest, GetWaitsForAnotherThread)
+{
+    auto [promise, future] = concurrent::make_task_promise<int>();
+    std::jthread thread([promise = std::move(promise)]() mutable
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        promise.set_value(5);
+    });
+
+    EXPECT_EQ(future.get(), 5);
+}
+
+TEST(TaskFutureTest, ThenAfterResult)
+{
+    concurrent::thread_pool pool(1);
+    auto [promise, future] = concurrent::make_task_promise<int>();
+    promise.set_value(20);
+
+    auto continued = future.then(pool, [](const int x) { return x + 1; });
+    EXPECT_FALSE(future.valid());
+    EXPECT_EQ(continued.get(), 21);
+}
+
+TEST(TaskFutureTest, ThenBeforeResult)
+{
+    concurrent::thread_pool pool(2);
+    auto [promise, future] = concurrent::make_task_promise<std::string>();
+
+    auto continued = future.then(pool, [](const std::string& text) { return text.size(); });
+    EXPECT_FALSE(continued.is_ready());
+    promise.set_value("text");
+    EXPECT_EQ(continued.get(), 4);
+}
+
+TEST(TaskFutureTest, ThenChain)
+{
+    concurrent::thread_pool pool(2);
+    auto result = pool.submit([]() { return 2; })
+                          .then(pool, [](const int x) { return x * 10; })
+                          .then(pool, [](const int x) { EXPECT_EQ(x, 20); })
+                          .then(pool, []() { return std::string("done"); });
+    EXPECT_EQ(result.get(), "done");
+}
+
+TEST(TaskFutureTest, ThenPassesExceptionOn)
+{
+    concurrent::thread_pool pool(1);
+    std::atomic<bool> called{ false };
+    auto result = pool.submit([]() -> int { throw std::runtime_error("failed"); })
+                          .then(pool, [&called](int) { called = true; });
+    EXPECT_THROW(result.get(), std::runtime_error);
+    EXPECT_FALSE(called.load());
+}
+
+TEST(TaskFutureTest, ThenPassesBrokenPromiseOn)
+{
+    concurrent::thread_pool pool(1);
+    concurrent::task_future<void> continued;
+    {
+        auto [promise, future] = concurrent::make_task_promise<int>();
+        continued = future.then(pool, [](int) {});
+    }
+    try
+    {
+        continued.get();
+        FAIL() << "broken_promise expected";
+    } catch (const std::future_error& error)
+    {
+        EXPECT_EQ(error.code(), std::future_errc::broken_promise);
+    }
+}
+
+TEST(TaskFutureTest, ThenOnInvalidFuture)
+{
+    concurrent::thread_pool pool(1);
+    concurrent::task_future<int> future;
+    EXPECT_THROW(future.then(pool, [](int) {}), std::future_error);
+}
+
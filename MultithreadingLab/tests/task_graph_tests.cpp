@@ -0,0 +1,179 @@
+#include "task_graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST(TaskGraphTest, EmptyGraph)
+{
+    concurrent::thread_pool pool(1);
+    concurrent::task_graph graph;
+    graph.run(pool);
+    EXPECT_EQ(graph.size(), 0);
+}
+
+TEST(TaskGraphTest, InvalidEdges)
+{
+    concurrent::task_graph graph;
+    const auto node = graph.add([]() {});
+    EXPECT_THROW(graph.precede(node, node), std::invalid_argument);
+    EXPECT_THROW(graph.precede(node, 5), std::invalid_argument);
+    EXPECT_THROW(graph.precede(5, node), std::invalid_argument);
+}
+
+TEST(TaskGraphTest, Cycle)
+{
+    concurrent::thread_pool pool(1);
+    concurrent::task_graph graph;
+    const auto first = graph.add([]() {});
+    const auto second = graph.add([]() {});
+    const auto third = graph.add([]() {});
+    graph.precede(first, second);
+    graph.precede(second, third);
+    graph.precede(third, second);
+    EXPECT_THROW(graph.run(pool), std::logic_error);
+}
+
+TEST(TaskGraphTest, DependenciesComplete)
+{
+    // A diamond: load -> (left, right) -> merge
+    concurrent::thread_pool pool(3);
+    concurrent::task_graph graph;
+    std::mutex mutex;
+    std::vector<char> order;
+    auto record = [&mutex, &order](const char name)
+    {
+        return [&mutex, &order, name]()
+        {
+            std::scoped_lock lock(mutex);
+            order.push_back(name);
+        };
+    };
+
+    const auto load = graph.add(record('l'));
+    const auto left = graph.add(record('a'));
+    const auto right = graph.add(record('b'));
+    const auto merge = graph.add(record('m'));
+    graph.precede(load, left);
+    graph.precede(load, right);
+    graph.precede(left, merge);
+    graph.precede(right, merge);
+
+    graph.run(pool);
+
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_EQ(order.front(), 'l');
+    EXPECT_EQ(order.back(), 'm');
+}
+
+TEST(TaskGraphTest, ReusedManyTimes)
+{
+    // Load -> sort chunks -> merge pairs -> aggregate, run repeatedly
+    constexpr size_t chunks = 8;
+    concurrent::thread_pool pool(2);
+    concurrent::task_graph graph;
+
+    std::vector<std::vector<int>> data(chunks);
+    std::vector<long long> merged(chunks / 2);
+    long long total = 0;
+
+    const auto load = graph.add(
+            [&data]()
+            {
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    data[i].assign(100, 0);
+                    std::iota(data[i].begin(), data[i].end(), static_cast<int>(i * 100));
+                }
+            });
+    std::vector<concurrent::task_graph::node_id> sorted;
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        sorted.push_back(graph.add([&data, i]() { std::sort(data[i].rbegin(), data[i].rend()); }));
+        graph.precede(load, sorted.back());
+    }
+    const auto aggregate = graph.add([&merged, &total]()
+                                     { total = std::accumulate(merged.begin(), merged.end(), 0ll); });
+    for (size_t i = 0; i < chunks / 2; ++i)
+    {
+        const auto merge = graph.add(
+                [&data, &merged, i]()
+                {
+                    merged[i] = std::accumulate(data[2 * i].begin(), data[2 * i].end(), 0ll) +
+                                std::accumulate(data[2 * i + 1].begin(), data[2 * i + 1].end(), 0ll);
+                });
+        graph.precede(sorted[2 * i], merge);
+        graph.precede(sorted[2 * i + 1], merge);
+        graph.precede(merge, aggregate);
+    }
+
+    for (int run = 0; run < 50; ++run)
+    {
+        total = 0;
+        graph.run(pool);
+        ASSERT_EQ(total, 799 * 800 / 2) << "run: " << run;
+    }
+}
+
+TEST(TaskGraphTest, ManyRoots)
+{
+    concurrent::thread_pool pool(2);
+    concurrent::task_graph graph;
+    std::atomic<int> counter{ 0 };
+    for (int i = 0; i < 100; ++i)
+        graph.add([&counter]() { counter++; });
+
+    graph.run(pool);
+    graph.run(pool);
+    EXPECT_EQ(counter.load(), 200);
+}
+
+TEST(TaskGraphTest, ExceptionSkipsRemainingNodes)
+{
+    concurrent::thread_pool pool(2);
+    concurrent::task_graph graph;
+    std::atomic<bool> after_failure{ false };
+    const auto failing = graph.add([]() { throw std::runtime_error("failed"); });
+    const auto successor = graph.add([&after_failure]() { after_failure = true; });
+    graph.precede(failing, successor);
+
+    EXPECT_THROW(graph.run(pool), std::runtime_error);
+    EXPECT_FALSE(after_failure.load());
+
+    // The failure is not kept for the next run
+    EXPECT_THROW(graph.run(pool), std::runtime_error);
+}
+
+TEST(TaskGraphTest, RunFromPoolTask)
+{
+    // The worker running the graph runs its nodes instead of blocking
+    concurrent::thread_pool pool(1);
+    concurrent::task_graph graph;
+    std::atomic<int> counter{ 0 };
+    const auto first = graph.add([&counter]() { counter++; });
+    for (int i = 0; i < 10; ++i)
+        graph.precede(first, graph.add([&counter]() { counter++; }));
+
+    pool.submit([&graph, &pool]() { graph.run(pool); }).get();
+    EXPECT_EQ(counter.load(), 11);
+}
+
+TEST(TaskGraphTest, GraphCanGrowBetweenRuns)
+{
+    concurrent::thread_pool pool(1);
+    concurrent::task_graph graph;
+    std::vector<int> order;
+    const auto first = graph.add([&order]() { order.push_back(1); });
+    graph.run(pool);
+
+    const auto second = graph.add([&order]() { order.push_back(2); });
+    graph.precede(second, first);
+    order.clear();
+    graph.run(pool);
+
+    EXPECT_EQ(order, (std::vector<int>{ 2, 1 }));
+}
@@ -0,0 +1,183 @@
+#include "task_group.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static_assert(!std::is_copy_constructible_v<concurrent::task_group>);
+static_assert(!std::is_move_constructible_v<concurrent::task_group>);
+
+namespace
+{
+long long fibonacci(concurrent::thread_pool& pool, const int n)
+{
+    if (n < 2)
+        return n;
+
+    long long first = 0;
+    long long second = 0;
+    concurrent::task_group group(pool);
+    group.spawn([&pool, &first, n]() { first = fibonacci(pool, n - 1); });
+    second = fibonacci(pool, n - 2);
+    group.sync();
+
+    return first + second;
+}
+
+void merge_sort(concurrent::thread_pool& pool, std::vector<int>& nums, std::vector<int>& buffer, const size_t begin,
+                const size_t end)
+{
+    if (end - begin <= 64)
+    {
+        std::sort(nums.begin() + static_cast<std::ptrdiff_t>(begin), nums.begin() + static_cast<std::ptrdiff_t>(end));
+        return;
+    }
+
+    const size_t middle = begin + (end - begin) / 2;
+    concurrent::task_group group(pool);
+    group.spawn(merge_sort, std::ref(pool), std::ref(nums), std::ref(buffer), begin, middle);
+    group.spawn(merge_sort, std::ref(pool), std::ref(nums), std::ref(buffer), middle, end);
+    group.sync();
+
+    const auto first = nums.begin();
+    std::merge(first + static_cast<std::ptrdiff_t>(begin), first + static_cast<std::ptrdiff_t>(middle),
+               first + static_cast<std::ptrdiff_t>(middle), first + static_cast<std::ptrdiff_t>(end),
+               buffer.begin() + static_cast<std::ptrdiff_t>(begin));
+    std::copy(buffer.begin() + static_cast<std::ptrdiff_t>(begin), buffer.begin() + static_cast<std::ptrdiff_t>(end),
+              first + static_cast<std::ptrdiff_t>(begin));
+}
+} // namespace
+
+TEST(TaskGroupTest, SyncWaitsForChildren)
+{
+    concurrent::thread_pool pool(2);
+    std::atomic<int> counter{ 0 };
+
+    concurrent::task_group group(pool);
+    for (int i = 0; i < 100; ++i)
+        group.spawn([&counter](const int x) { counter += x; }, 1);
+    group.sync();
+
+    EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(TaskGroupTest, SyncWithoutChildren)
+{
+    concurrent::thread_pool pool(1);
+    concurrent::task_group group(pool);
+    group.sync();
+}
+
+TEST(TaskGroupTest, DestructorWaitsForChildren)
+{
+    concurrent::thread_pool pool(2);
+    std::atomic<int> counter{ 0 };
+    {
+        concurrent::task_group group(pool);
+        for (int i = 0; i < 10; ++i)
+            group.spawn([&counter]() { counter++; });
+    }
+    EXPECT_EQ(counter.load(), 10);
+}
+
+TEST(TaskGroupTest, ExceptionIsRethrownBySync)
+{
+    concurrent::thread_pool pool(2);
+    concurrent::task_group group(pool);
+    std::atomic<int> counter{ 0 };
+
+    group.spawn([]() { throw std::runtime_error("failed"); });
+    group.spawn([&counter]() { counter++; });
+    EXPECT_THROW(group.sync(), std::runtime_error);
+    EXPECT_EQ(counter.load(), 1);
+
+    // The group is reusable and the exception is not thrown again
+    group.spawn([&counter]() { counter++; });
+    group.sync();
+    EXPECT_EQ(counter.load(), 2);
+}
+
+TEST(TaskGroupTest, RecursionOnSingleWorker)
+{
+    // Blocking a worker on a child future would deadlock here, the syncing worker runs its children instead
+    concurrent::thread_pool pool(1);
+    auto future = pool.submit([&pool]() { return fibonacci(pool, 18); });
+    EXPECT_EQ(future.get(), 2584);
+}
+
+TEST(TaskGroupTest, ExternalThreadHelps)
+{
+    // The only worker is blocked, the syncing thread has to run the children itself
+    concurrent::thread_pool pool(1);
+    std::atomic<bool> started{ false };
+    std::atomic<bool> release{ false };
+    pool.post(
+            [&started, &release]()
+            {
+                started = true;
+                while (!release.load())
+                    std::this_thread::yield();
+            });
+    while (!started.load())
+        std::this_thread::yield();
+
+    std::atomic<int> counter{ 0 };
+    concurrent::task_group group(pool);
+    for (int i = 0; i < 10; ++i)
+        group.spawn([&counter]() { counter++; });
+    group.sync();
+    EXPECT_EQ(counter.load(), 10);
+
+    release = true;
+}
+
+TEST(TaskGroupTest, SyncWaitsForChildRunningElsewhere)
+{
+    // Finding nothing to help with, the syncing thread sleeps until the child counts the group down
+    concurrent::thread_pool pool(1);
+    concurrent::task_group group(pool);
+    std::atomic<bool> release{ false };
+    std::atomic<bool> finished{ false };
+    group.spawn(
+            [&release, &finished]()
+            {
+                release.wait(false);
+                finished = true;
+            });
+    std::jthread releaser(
+            [&release]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                release = true;
+                release.notify_one();
+            });
+
+    group.sync();
+    EXPECT_TRUE(finished);
+}
+
+TEST(TaskGroupTest, ParallelMergeSort)
+{
+    std::vector<int> nums(20'000);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(-1000, 1000);
+    std::generate(nums.begin(), nums.end(), [&]() { return distribution(generator); });
+
+    std::vector<int> expected = nums;
+    std::sort(expected.begin(), expected.end());
+
+    for (const size_t threads: { 1, 2, 4 })
+    {
+        std::vector<int> sorted = nums;
+        std::vector<int> buffer(sorted.size());
+        concurrent::thread_pool pool(threads);
+        merge_sort(pool, sorted, buffer, 0, sorted.size());
+        EXPECT_EQ(sorted, expected) << "threads: " << threads;
+    }
+}
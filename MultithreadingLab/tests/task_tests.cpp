@@ -0,0 +1,242 @@
+#include "task.h"
+#include "thread_pool.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+static_assert(!std::is_copy_constructible_v<concurrent::task<int>>);
+static_assert(std::is_nothrow_move_constructible_v<concurrent::task<int>>);
+
+namespace
+{
+concurrent::task<int> value(const int x)
+{
+    co_return x;
+}
+
+concurrent::task<int> square_on_pool(concurrent::thread_pool& pool, const int x)
+{
+    co_await pool.schedule();
+    co_return x * x;
+}
+
+concurrent::task<> fail()
+{
+    throw std::runtime_error("failed");
+    co_return;
+}
+
+concurrent::task<int> sum_sequentially(const int count)
+{
+    int sum = 0;
+    for (int i = 0; i < count; ++i)
+        sum += co_await value(1);
+    co_return sum;
+}
+} // namespace
+
+TEST(TaskTest, LazyStart)
+{
+    bool started = false;
+    auto lazy = [](bool& flag) -> concurrent::task<>
+    {
+        flag = true;
+        co_return;
+    }(started);
+
+    EXPECT_FALSE(started);
+    concurrent::sync_wait(std::move(lazy));
+    EXPECT_TRUE(started);
+}
+
+TEST(TaskTest, SyncWaitValue)
+{
+    EXPECT_EQ(concurrent::sync_wait(value(42)), 42);
+}
+
+TEST(TaskTest, SyncWaitException)
+{
+    EXPECT_THROW(concurrent::sync_wait(fail()), std::runtime_error);
+}
+
+TEST(TaskTest, MoveOnlyResult)
+{
+    auto make = []() -> concurrent::task<std::unique_ptr<int>> { co_return std::make_unique<int>(7); };
+    EXPECT_EQ(*concurrent::sync_wait(make()), 7);
+}
+
+TEST(TaskTest, AwaitingInvalidTask)
+{
+    auto await_default = []() -> concurrent::task<int> { co_return co_await concurrent::task<int>(); };
+    EXPECT_THROW(concurrent::sync_wait(await_default()), std::future_error);
+}
+
+TEST(TaskTest, ManySynchronousAwaits)
+{
+    // Every child completes synchronously and resumes the parent by symmetric transfer. The stack only stays
+    // flat if the compiler emits the transfer as a tail call, which sanitizers may prevent, so the chain is short
+    EXPECT_EQ(concurrent::sync_wait(sum_sequentially(10'000)), 10'000);
+}
+
+TEST(TaskTest, ScheduleResumesOnPool)
+{
+    concurrent::thread_pool pool(1);
+    auto thread_id = [](concurrent::thread_pool& on) -> concurrent::task<std::thread::id>
+    {
+        co_await on.schedule();
+        co_return std::this_thread::get_id();
+    };
+    EXPECT_NE(concurrent::sync_wait(thread_id(pool)), std::this_thread::get_id());
+}
+
+TEST(TaskTest, ScheduleIntoLane)
+{
+    concurrent::thread_pool pool(1);
+    auto thread_id = [](concurrent::thread_pool& on) -> concurrent::task<std::thread::id>
+    {
+        co_await on.schedule({ .priority = concurrent::task_priority::background });
+        co_return std::this_thread::get_id();
+    };
+    EXPECT_NE(concurrent::sync_wait(thread_id(pool)), std::this_thread::get_id());
+}
+
+TEST(TaskTest, WhenAllVector)
+{
+    concurrent::thread_pool pool(3);
+    std::vector<concurrent::task<int>> tasks;
+    for (int i = 0; i < 100; ++i)
+        tasks.push_back(square_on_pool(pool, i));
+
+    const std::vector<int> squares = concurrent::sync_wait(concurrent::when_all(std::move(tasks)));
+
+    ASSERT_EQ(squares.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(squares[static_cast<size_t>(i)], i * i);
+}
+
+TEST(TaskTest, WhenAllEmptyVector)
+{
+    EXPECT_TRUE(concurrent::sync_wait(concurrent::when_all(std::vector<concurrent::task<int>>{})).empty());
+}
+
+TEST(TaskTest, WhenAllVoidVector)
+{
+    concurrent::thread_pool pool(2);
+    std::atomic<int> counter{ 0 };
+    auto increment = [](concurrent::thread_pool& on, std::atomic<int>& value) -> concurrent::task<>
+    {
+        co_await on.schedule();
+        value++;
+    };
+
+    std::vector<concurrent::task<>> tasks;
+    for (int i = 0; i < 10; ++i)
+        tasks.push_back(increment(pool, counter));
+    concurrent::sync_wait(concurrent::when_all(std::move(tasks)));
+
+    EXPECT_EQ(counter.load(), 10);
+}
+
+TEST(TaskTest, WhenAllTuple)
+{
+    concurrent::thread_pool pool(2);
+    auto text = [](concurrent::thread_pool& on) -> concurrent::task<std::string>
+    {
+        co_await on.schedule();
+        co_return "text";
+    };
+    auto nothing = []() -> concurrent::task<> { co_return; };
+
+    const auto [number, empty, string] =
+            concurrent::sync_wait(concurrent::when_all(square_on_pool(pool, 3), nothing(), text(pool)));
+
+    EXPECT_EQ(number, 9);
+    EXPECT_EQ(empty, std::monostate{});
+    EXPECT_EQ(string, "text");
+}
+
+TEST(TaskTest, WhenAllException)
+{
+    concurrent::thread_pool pool(2);
+    std::vector<concurrent::task<>> tasks;
+    tasks.push_back(fail());
+    tasks.push_back([](concurrent::thread_pool& on) -> concurrent::task<> { co_await on.schedule(); }(pool));
+
+    EXPECT_THROW(concurrent::sync_wait(concurrent::when_all(std::move(tasks))), std::runtime_error);
+    EXPECT_THROW(concurrent::sync_wait(concurrent::when_all(value(1), fail())), std::runtime_error);
+}
+
+TEST(TaskTest, WhenAnyFirstCompleted)
+{
+    concurrent::thread_pool pool(2);
+    std::atomic<bool> release{ false };
+    std::atomic<bool> slow_done{ false };
+
+    auto slow = [](concurrent::thread_pool& on, std::atomic<bool>& go,
+                   std::atomic<bool>& done) -> concurrent::task<int>
+    {
+        co_await on.schedule();
+        while (!go.load())
+            std::this_thread::yield();
+        done = true;
+        co_return 1;
+    };
+
+    std::vector<concurrent::task<int>> tasks;
+    tasks.push_back(slow(pool, release, slow_done));
+    tasks.push_back(value(2));
+
+    const auto [index, result] = concurrent::sync_wait(concurrent::when_any(std::move(tasks)));
+    EXPECT_EQ(index, 1);
+    EXPECT_EQ(result, 2);
+
+    // The other task keeps running after when_any completes
+    release = true;
+    while (!slow_done.load())
+        std::this_thread::yield();
+}
+
+TEST(TaskTest, WhenAnyException)
+{
+    std::vector<concurrent::task<>> tasks;
+    tasks.push_back(fail());
+    EXPECT_THROW(concurrent::sync_wait(concurrent::when_any(std::move(tasks))), std::runtime_error);
+}
+
+TEST(TaskTest, WhenAnyEmpty)
+{
+    EXPECT_THROW(concurrent::sync_wait(concurrent::when_any(std::vector<concurrent::task<int>>{})),
+                 std::invalid_argument);
+}
+
+TEST(TaskTest, ScheduleRejected)
+{
+    concurrent::thread_pool pool(1, { .injection = concurrent::injection_queue::lock_free,
+                                      .injection_capacity = 2,
+                                      .when_full = concurrent::full_policy::reject });
+
+    std::atomic<bool> started{ false };
+    std::atomic<bool> release{ false };
+    pool.post(
+            [&started, &release]()
+            {
+                started = true;
+                while (!release.load())
+                    std::this_thread::yield();
+            });
+    while (!started.load())
+        std::this_thread::yield();
+    pool.post([]() {});
+    pool.post([]() {});
+
+    auto hop = [](concurrent::thread_pool& on) -> concurrent::task<> { co_await on.schedule(); };
+    EXPECT_THROW(concurrent::sync_wait(hop(pool)), std::overflow_error);
+
+    release = true;
+}
@@ -0,0 +1,105 @@
+#include "thread_pool_metrics.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST(LatencyHistogramTest, Empty)
+{
+    const concurrent::latency_histogram histogram;
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.max(), 0);
+    EXPECT_EQ(histogram.mean(), 0.0);
+    EXPECT_EQ(histogram.percentile(50), 0);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    concurrent::latency_histogram histogram;
+    for (uint64_t value = 1; value <= 60; ++value)
+        histogram.record(value);
+
+    EXPECT_EQ(histogram.count(), 60);
+    EXPECT_EQ(histogram.max(), 60);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 30.5);
+    EXPECT_EQ(histogram.percentile(0), 1);
+    EXPECT_EQ(histogram.percentile(50), 30);
+    EXPECT_EQ(histogram.percentile(90), 54);
+    EXPECT_EQ(histogram.percentile(100), 60);
+}
+
+TEST(LatencyHistogramTest, RelativeError)
+{
+    for (uint64_t value = 64; value < uint64_t{ 1 } << 62; value = value * 3 + 7)
+    {
+        concurrent::latency_histogram histogram;
+        histogram.record(value);
+        histogram.record(value + value / 2);
+
+        // The upper bound of the bucket of value, the maximum is recorded exactly
+        const uint64_t median = histogram.percentile(50);
+        EXPECT_GE(median, value);
+        EXPECT_LE(static_cast<double>(median - value), static_cast<double>(value) * 0.032) << "value: " << value;
+        EXPECT_EQ(histogram.percentile(100), value + value / 2);
+    }
+}
+
+TEST(LatencyHistogramTest, LargestValue)
+{
+    concurrent::latency_histogram histogram;
+    histogram.record(UINT64_MAX);
+    EXPECT_EQ(histogram.percentile(50), UINT64_MAX);
+}
+
+TEST(LatencyHistogramTest, MergeAndCopy)
+{
+    concurrent::latency_histogram first;
+    concurrent::latency_histogram second;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        first.record(10);
+        second.record(1000);
+    }
+
+    concurrent::latency_histogram merged = first;
+    merged.merge(second);
+    EXPECT_EQ(merged.count(), 200);
+    EXPECT_EQ(merged.max(), 1000);
+    EXPECT_DOUBLE_EQ(merged.mean(), 505.0);
+    EXPECT_EQ(merged.percentile(50), 10);
+    EXPECT_GE(merged.percentile(51), 1000);
+
+    merged = first;
+    EXPECT_EQ(merged.count(), 100);
+    EXPECT_EQ(merged.max(), 10);
+    EXPECT_EQ(first.count(), 100);
+}
+
+TEST(LatencyHistogramTest, InvalidPercentile)
+{
+    const concurrent::latency_histogram histogram;
+    EXPECT_THROW(std::ignore = histogram.percentile(-1), std::invalid_argument);
+    EXPECT_THROW(std::ignore = histogram.percentile(101), std::invalid_argument);
+}
+
+TEST(ChromeTraceTest, Spans)
+{
+    const std::vector<concurrent::trace_span> spans = { { 0, 1500, 250 }, { 2, 2000, 1'000'000 } };
+    std::ostringstream output;
+    concurrent::write_chrome_trace(output, spans);
+
+    EXPECT_EQ(output.str(), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                            "{\"name\":\"task\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":1.500,\"dur\":0.250},\n"
+                            "{\"name\":\"task\",\"ph\":\"X\",\"pid\":0,\"tid\":2,\"ts\":2.000,\"dur\":1000.000}\n"
+                            "]}\n");
+}
+
+TEST(ChromeTraceTest, Empty)
+{
+    std::ostringstream output;
+    concurrent::write_chrome_trace(output, {});
+    EXPECT_EQ(output.str(), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n");
+}
@@ -0,0 +1,640 @@
+#include <benchmark/benchmark.h>
+
+#include "parallel_for.h"
+#include "task.h"
+#include "task_graph.h"
+#include "task_group.h"
+#include "thread_pool.h"
+#include "thread_scaling.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+/** The previous thread_pool design kept as the reference: one task queue behind one mutex */
+class single_queue_thread_pool final
+{
+public:
+    explicit single_queue_thread_pool(const size_t size)
+    {
+        _threads.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+            _threads.emplace_back(std::bind_front(&single_queue_thread_pool::run, this));
+    }
+
+    single_queue_thread_pool(const single_queue_thread_pool& other) = delete;
+    single_queue_thread_pool& operator=(const single_queue_thread_pool& other) = delete;
+
+    single_queue_thread_pool(single_queue_thread_pool&& other) = delete;
+    single_queue_thread_pool& operator=(single_queue_thread_pool&& other) = delete;
+
+    ~single_queue_thread_pool()
+    {
+        for (auto& thread: _threads)
+            thread.request_stop();
+
+        for (auto& thread: _threads)
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+    }
+
+    template<class F, class... Args>
+    auto push_task(F&& function, Args&&... args) -> std::future<decltype(function(args...))>
+    {
+        using ReturnType = decltype(function(args...));
+
+        std::function<ReturnType()> callable = std::bind(std::forward<F>(function), std::forward<Args>(args)...);
+        auto task_ptr = std::make_shared<std::packaged_task<ReturnType()>>(std::move(callable));
+        std::future<ReturnType> result_future = task_ptr->get_future();
+
+        {
+            std::scoped_lock lock(_tasks_mutex);
+            _tasks.emplace([task_ptr] { (*task_ptr)(); });
+        }
+        _cv.notify_one();
+
+        return result_future;
+    }
+
+private:
+    std::queue<std::function<void()>> _tasks;
+    std::mutex _tasks_mutex;
+    std::condition_variable_any _cv;
+
+    std::vector<std::jthread> _threads;
+
+    void run(const std::stop_token stop_token)
+    {
+        while (true)
+        {
+            std::function<void()> next_task;
+            {
+                std::unique_lock lock(_tasks_mutex);
+                _cv.wait(lock, stop_token, [this]() { return !_tasks.empty(); });
+
+                if (stop_token.stop_requested())
+                    break;
+
+                next_task = std::move(_tasks.front());
+                _tasks.pop();
+            }
+            next_task();
+        }
+    }
+};
+
+/** The work-stealing pool with the lock-free injection queue */
+class lock_free_injection_thread_pool final
+{
+public:
+    explicit lock_free_injection_thread_pool(const size_t size) :
+        _pool(size, { .injection = concurrent::injection_queue::lock_free })
+    {}
+
+    template<class F, class... Args>
+    auto push_task(F&& function, Args&&... args)
+    {
+        return _pool.push_task(std::forward<F>(function), std::forward<Args>(args)...);
+    }
+
+private:
+    concurrent::thread_pool _pool;
+};
+
+constexpr size_t external_task_num = 1 << 16;
+constexpr size_t fan_out_depth = 16;
+constexpr size_t fan_out_task_num = (size_t{ 1 } << (fan_out_depth + 1)) - 1;
+
+void wait_for(const std::atomic<size_t>& counter, const size_t expected)
+{
+    while (counter.load(std::memory_order_acquire) != expected)
+        std::this_thread::yield();
+}
+
+template<class Pool>
+void spawn_tree(Pool& pool, const size_t depth, std::atomic<size_t>& counter)
+{
+    if (depth > 0)
+    {
+        pool.push_task(spawn_tree<Pool>, std::ref(pool), depth - 1, std::ref(counter));
+        pool.push_task(spawn_tree<Pool>, std::ref(pool), depth - 1, std::ref(counter));
+    }
+    counter.fetch_add(1, std::memory_order_release);
+}
+
+/** spawn_tree where every task also waits for its children */
+void sync_tree(concurrent::thread_pool& pool, const size_t depth, std::atomic<size_t>& counter)
+{
+    if (depth > 0)
+    {
+        concurrent::task_group group(pool);
+        group.spawn(sync_tree, std::ref(pool), depth - 1, std::ref(counter));
+        group.spawn(sync_tree, std::ref(pool), depth - 1, std::ref(counter));
+        group.sync();
+    }
+    counter.fetch_add(1, std::memory_order_release);
+}
+
+constexpr size_t round_trip_num = 1 << 12;
+
+concurrent::task<size_t> ready_value(const size_t x)
+{
+    co_return x;
+}
+
+/** Awaits synchronously completing children, every await is two switches by symmetric transfer */
+concurrent::task<size_t> await_children(const size_t count)
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < count; ++i)
+        sum += co_await ready_value(i);
+    co_return sum;
+}
+
+/** Hops onto the pool count times, every hop is a posted task resuming the coroutine */
+concurrent::task<size_t> hop_onto_pool(concurrent::thread_pool& pool, const size_t count)
+{
+    size_t hops = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        co_await pool.schedule();
+        hops++;
+    }
+    co_return hops;
+}
+
+constexpr size_t dag_layers = 64;
+constexpr size_t dag_width = 8;
+
+/** A few hundred nanoseconds of work for every DAG node */
+void dag_work(std::atomic<size_t>& counter)
+{
+    size_t x = 0;
+    for (size_t i = 0; i < 256; ++i)
+        benchmark::DoNotOptimize(x += i);
+    counter.fetch_add(1, std::memory_order_release);
+}
+
+template<class Pool>
+constexpr const char* pool_name = "work_stealing";
+
+template<>
+constexpr const char* pool_name<single_queue_thread_pool> = "single_queue";
+
+template<>
+constexpr const char* pool_name<lock_free_injection_thread_pool> = "lock_free_injection";
+
+/** Items per second are tasks per second */
+void publish_tasks(benchmark::State& state, const std::string& key, const size_t tasks, const double seconds)
+{
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tasks));
+    utility::tests::publish_scaling(state, key, static_cast<size_t>(state.range(0)), seconds);
+}
+
+/** Mean, median and 99th percentile of queueing latencies in microseconds */
+void publish_latency(benchmark::State& state, const std::string& name, std::vector<double>& waits)
+{
+    std::sort(waits.begin(), waits.end());
+    const double total = std::accumulate(waits.begin(), waits.end(), 0.0);
+    state.counters[name + "_mean_us"] = total / static_cast<double>(waits.size());
+    state.counters[name + "_p50_us"] = waits[waits.size() / 2];
+    state.counters[name + "_p99_us"] = waits[waits.size() * 99 / 100];
+}
+} // namespace
+
+/** Tiny tasks pushed by the benchmark thread (the injection queue of the work-stealing pools) */
+template<class Pool>
+static void BM_ExternalTasks(benchmark::State& state)
+{
+    Pool pool(static_cast<size_t>(state.range(0)));
+
+    double seconds = 0;
+    for (auto _: state)
+    {
+        std::atomic<size_t> counter{ 0 };
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < external_task_num; ++i)
+            pool.push_task([&counter]() { counter.fetch_add(1, std::memory_order_release); });
+        wait_for(counter, external_task_num);
+        const auto finish = std::chrono::steady_clock::now();
+
+        const double iteration_seconds = std::chrono::duration<double>(finish - start).count();
+        state.SetIterationTime(iteration_seconds);
+        seconds += iteration_seconds;
+    }
+
+    publish_tasks(state, std::string(pool_name<Pool>) + "/external", external_task_num, seconds);
+}
+
+/** A binary tree of tiny tasks where every task pushes its children (the local deques of the work-stealing pool) */
+template<class Pool>
+static void BM_FanOutTasks(benchmark::State& state)
+{
+    Pool pool(static_cast<size_t>(state.range(0)));
+
+    double seconds = 0;
+    for (auto _: state)
+    {
+        std::atomic<size_t> counter{ 0 };
+
+        const auto start = std::chrono::steady_clock::now();
+        pool.push_task(spawn_tree<Pool>, std::ref(pool), fan_out_depth, std::ref(counter));
+        wait_for(counter, fan_out_task_num);
+        const auto finish = std::chrono::steady_clock::now();
+
+        const double iteration_seconds = std::chrono::duration<double>(finish - start).count();
+        state.SetIterationTime(iteration_seconds);
+        seconds += iteration_seconds;
+    }
+
+    publish_tasks(state, std::string(pool_name<Pool>) + "/fan_out", fan_out_task_num, seconds);
+}
+
+/** BM_FanOutTasks with a join of the children in every task, waiting tasks run other tasks instead of blocking */
+static void BM_ForkJoinTasks(benchmark::State& state)
+{
+    concurrent::thread_pool pool(static_cast<size_t>(state.range(0)));
+
+    double seconds = 0;
+    for (auto _: state)
+    {
+        std::atomic<size_t> counter{ 0 };
+
+        const auto start = std::chrono::steady_clock::now();
+        concurrent::task_group group(pool);
+        group.spawn(sync_tree, std::ref(pool), fan_out_depth, std::ref(counter));
+        group.sync();
+        const auto finish = std::chrono::steady_clock::now();
+
+        const double iteration_seconds = std::chrono::duration<double>(finish - start).count();
+        state.SetIterationTime(iteration_seconds);
+        seconds += iteration_seconds;
+    }
+
+    publish_tasks(state, "work_stealing/fork_join", fan_out_task_num, seconds);
+}
+
+BENCHMARK(BM_ForkJoinTasks)
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+
+/**
+ * Tiny tasks pushed by the benchmark thread through the submission paths of the work-stealing pool:
+ * push_task allocates a std::packaged_task state and the task node, submit and post recycle them
+ */
+template<class Push>
+static void BM_SubmissionPath(benchmark::State& state, Push push)
+{
+    concurrent::thread_pool pool(static_cast<size_t>(state.range(0)),
+                                 { .injection = concurrent::injection_queue::lock_free });
+
+    for (auto _: state)
+    {
+        std::atomic<size_t> counter{ 0 };
+        auto increment = [&counter]() { counter.fetch_add(1, std::memory_order_release); };
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < external_task_num; ++i)
+            push(pool, increment);
+        wait_for(counter, external_task_num);
+        const auto finish = std::chrono::steady_clock::now();
+
+        state.SetIterationTime(std::chrono::duration<double>(finish - start).count());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(external_task_num));
+}
+
+BENCHMARK_CAPTURE(BM_SubmissionPath, push_task, [](concurrent::thread_pool& pool, auto task) { pool.push_task(task); })
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SubmissionPath, submit, [](concurrent::thread_pool& pool, auto task) { pool.submit(task); })
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SubmissionPath, post, [](concurrent::thread_pool& pool, auto task) { pool.post(task); })
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+
+/** The tasks of BM_SubmissionPath pushed as one batch: one injection lock and one wake-up */
+static void BM_BatchSubmission(benchmark::State& state)
+{
+    concurrent::thread_pool pool(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state)
+    {
+        std::atomic<size_t> counter{ 0 };
+        auto increment = [&counter]() { counter.fetch_add(1, std::memory_order_release); };
+
+        const auto start = std::chrono::steady_clock::now();
+        pool.push_tasks(std::vector(external_task_num, increment));
+        wait_for(counter, external_task_num);
+        const auto finish = std::chrono::steady_clock::now();
+
+        state.SetIterationTime(std::chrono::duration<double>(finish - start).count());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(external_task_num));
+}
+
+BENCHMARK(BM_BatchSubmission)
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+
+/** A loop whose iterations get more expensive towards the end, which static chunks balance worst */
+static void BM_ParallelForChunking(benchmark::State& state, const concurrent::chunking mode)
+{
+    constexpr size_t iterations = 1 << 12;
+    constexpr size_t grain = 16;
+    concurrent::thread_pool pool(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state)
+    {
+        std::atomic<size_t> total{ 0 };
+
+        const auto start = std::chrono::steady_clock::now();
+        concurrent::parallel_for(
+                pool, size_t{ 0 }, iterations, grain,
+                [&total](const size_t i)
+                {
+                    size_t local = 0;
+                    for (size_t j = 0; j < i; ++j)
+                        benchmark::DoNotOptimize(local += j);
+                    total.fetch_add(local, std::memory_order_relaxed);
+                },
+                mode);
+        const auto finish = std::chrono::steady_clock::now();
+
+        state.SetIterationTime(std::chrono::duration<double>(finish - start).count());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(iterations));
+}
+
+BENCHMARK_CAPTURE(BM_ParallelForChunking, static, concurrent::chunking::static_chunks)
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ParallelForChunking, dynamic, concurrent::chunking::dynamic_chunks)
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ParallelForChunking, guided, concurrent::chunking::guided_chunks)
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+
+/** The cost of a coroutine switch without a pool: awaiting a task which completes synchronously */
+static void BM_CoroutineAwait(benchmark::State& state)
+{
+    for (auto _: state)
+        benchmark::DoNotOptimize(concurrent::sync_wait(await_children(round_trip_num)));
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(round_trip_num));
+}
+
+BENCHMARK(BM_CoroutineAwait)->Unit(benchmark::kMicrosecond);
+
+/** A coroutine continuing on the pool: every item is a co_await pool.schedule() */
+static void BM_CoroutineHop(benchmark::State& state)
+{
+    concurrent::thread_pool pool(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state)
+        benchmark::DoNotOptimize(concurrent::sync_wait(hop_onto_pool(pool, round_trip_num)));
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(round_trip_num));
+}
+
+/** The blocking equivalent of BM_CoroutineHop: every item is push_task and future.get() */
+static void BM_FutureRoundTrip(benchmark::State& state)
+{
+    concurrent::thread_pool pool(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state)
+    {
+        size_t hops = 0;
+        for (size_t i = 0; i < round_trip_num; ++i)
+            hops += pool.push_task([]() { return size_t{ 1 }; }).get();
+        benchmark::DoNotOptimize(hops);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(round_trip_num));
+}
+
+BENCHMARK(BM_CoroutineHop)->ArgName("threads")->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FutureRoundTrip)->ArgName("threads")->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+/**
+ * A layered DAG where every node depends on two nodes of the previous layer, built once and run every
+ * iteration: nodes start as soon as their own inputs complete
+ */
+static void BM_TaskGraphLayers(benchmark::State& state)
+{
+    concurrent::thread_pool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<size_t> counter{ 0 };
+
+    concurrent::task_graph graph;
+    for (size_t layer = 0; layer < dag_layers; ++layer)
+    {
+        for (size_t i = 0; i < dag_width; ++i)
+        {
+            const auto node = graph.add([&counter]() { dag_work(counter); });
+            if (layer > 0)
+            {
+                const size_t previous_layer = (layer - 1) * dag_width;
+                graph.precede(previous_layer + i, node);
+                graph.precede(previous_layer + (i + 1) % dag_width, node);
+            }
+        }
+    }
+
+    for (auto _: state)
+        graph.run(pool);
+
+    benchmark::DoNotOptimize(counter.load());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(dag_layers * dag_width));
+}
+
+/** The same DAG run as a barrier per layer: push_task for every node and get() on the whole layer */
+static void BM_LayerBarriers(benchmark::State& state)
+{
+    concurrent::thread_pool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<size_t> counter{ 0 };
+
+    for (auto _: state)
+    {
+        for (size_t layer = 0; layer < dag_layers; ++layer)
+        {
+            std::vector<std::future<void>> futures;
+            futures.reserve(dag_width);
+            for (size_t i = 0; i < dag_width; ++i)
+                futures.push_back(pool.push_task(dag_work, std::ref(counter)));
+            for (auto& future: futures)
+                future.get();
+        }
+    }
+
+    benchmark::DoNotOptimize(counter.load());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(dag_layers * dag_width));
+}
+
+BENCHMARK(BM_TaskGraphLayers)
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LayerBarriers)
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+
+/**
+ * A burst of background tasks with a few latency-critical ones pushed in between. With lanes the critical tasks
+ * overtake the backlog, without them all tasks share the normal lane and wait in push order
+ */
+static void BM_PriorityQueueingLatency(benchmark::State& state, const bool lanes)
+{
+    constexpr size_t background_num = 1024;
+    constexpr size_t critical_every = 16;
+    concurrent::thread_pool pool(static_cast<size_t>(state.range(0)));
+
+    std::vector<double> critical_waits;
+    std::vector<double> background_waits;
+    for (auto _: state)
+    {
+        std::vector<double> waits(background_num);
+        std::vector<bool> critical(background_num);
+        std::atomic<size_t> counter{ 0 };
+
+        for (size_t i = 0; i < background_num; ++i)
+        {
+            critical[i] = i % critical_every == 0;
+            const concurrent::task_options options = {
+                .priority = !lanes ? concurrent::task_priority::normal
+                            : critical[i] ? concurrent::task_priority::critical
+                                          : concurrent::task_priority::background
+            };
+            const auto pushed = std::chrono::steady_clock::now();
+            pool.post(options,
+                      [&waits, &counter, i, pushed]()
+                      {
+                          waits[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() -
+                                                                               pushed).count();
+                          // The release count publishes the wait to the thread reading all waits
+                          dag_work(counter);
+                      });
+        }
+        wait_for(counter, background_num);
+
+        for (size_t i = 0; i < background_num; ++i)
+            (critical[i] ? critical_waits : background_waits).push_back(waits[i]);
+    }
+
+    publish_latency(state, "critical", critical_waits);
+    publish_latency(state, "background", background_waits);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(background_num));
+}
+
+BENCHMARK_CAPTURE(BM_PriorityQueueingLatency, lanes, true)
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PriorityQueueingLatency, single_lane, false)
+        ->ArgName("threads")
+        ->ArgsProduct({ utility::tests::scaling_thread_counts() })
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Sporadic submissions: one task at a time with a pause of the given microseconds before the next one. The latency
+ * from the post to the start of the task is the wake-up cost of an idle worker, spinning workers avoid it for
+ * short pauses
+ */
+static void BM_SporadicLatency(benchmark::State& state, const concurrent::thread_pool_options& options)
+{
+    constexpr size_t submission_num = 64;
+    const auto pause = std::chrono::microseconds(state.range(0));
+    concurrent::thread_pool pool(1, options);
+
+    std::vector<double> waits;
+    for (auto _: state)
+    {
+        for (size_t i = 0; i < submission_num; ++i)
+        {
+            std::atomic<bool> started{ false };
+            double wait = 0;
+            const auto pushed = std::chrono::steady_clock::now();
+            pool.post(
+                    [&started, &wait, pushed]()
+                    {
+                        wait = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - pushed)
+                                       .count();
+                        started.store(true, std::memory_order_release);
+                    });
+            while (!started.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            waits.push_back(wait);
+
+            if (pause.count() > 0)
+                std::this_thread::sleep_for(pause);
+        }
+    }
+
+    publish_latency(state, "task", waits);
+}
+
+BENCHMARK_CAPTURE(BM_SporadicLatency, parking, concurrent::thread_pool_options{ .spin_pauses = 0, .spin_yields = 0 })
+        ->ArgName("pause_us")
+        ->Arg(0)
+        ->Arg(20)
+        ->Arg(200)
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SporadicLatency, spinning, concurrent::thread_pool_options{})
+        ->ArgName("pause_us")
+        ->Arg(0)
+        ->Arg(20)
+        ->Arg(200)
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+
+#define BENCHMARK_THREAD_POOL(benchmark_name, pool)                                                                   \
+    BENCHMARK_TEMPLATE(benchmark_name, pool)                                                                           \
+            ->ArgName("threads")                                                                                       \
+            ->ArgsProduct({ utility::tests::scaling_thread_counts() })                                                 \
+            ->UseManualTime()                                                                                          \
+            ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_THREAD_POOL(BM_ExternalTasks, single_queue_thread_pool)
+BENCHMARK_THREAD_POOL(BM_ExternalTasks, concurrent::thread_pool)
+BENCHMARK_THREAD_POOL(BM_ExternalTasks, lock_free_injection_thread_pool)
+BENCHMARK_THREAD_POOL(BM_FanOutTasks, single_queue_thread_pool)
+BENCHMARK_THREAD_POOL(BM_FanOutTasks, concurrent::thread_pool)
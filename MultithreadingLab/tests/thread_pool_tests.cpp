@@ -2,9 +2,38 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdlib>
+#include <functional>
 #include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 
+// Counting scalar heap allocations of the whole test executable. Not inlined, otherwise the compiler
+// pairs inlined free with new expressions and reports mismatched deallocations
+static std::atomic<size_t> allocation_count{ 0 };
+
+[[gnu::noinline]] void* operator new(const size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
 static_assert(!std::is_copy_constructible_v<concurrent::thread_pool>);
 static_assert(!std::is_copy_assignable_v<concurrent::thread_pool>);
 static_assert(!std::is_move_constructible_v<concurrent::thread_pool>);
@@ -193,6 +222,753 @@ TEST(ThreadPoolTest, StressTest)
     EXPECT_EQ(counter.load(), task_num);
 }
 
+TEST(ThreadPoolTest, Size)
+{
+    concurrent::thread_pool pool(3);
+    EXPECT_EQ(pool.size(), 3);
+}
+
+// Tasks pushed by workers go to their own deques and must be stolen by idle workers
+static void spawn_tree(concurrent::thread_pool& pool, const size_t depth, std::atomic<size_t>& counter)
+{
+    ++counter;
+    if (depth == 0)
+        return;
+
+    pool.push_task(spawn_tree, std::ref(pool), depth - 1, std::ref(counter));
+    pool.push_task(spawn_tree, std::ref(pool), depth - 1, std::ref(counter));
+}
+
+TEST(ThreadPoolTest, NestedTasksFanOut)
+{
+    constexpr size_t depth = 14;
+    constexpr size_t task_num = (size_t{ 1 } << (depth + 1)) - 1;
+
+    std::atomic<size_t> counter{ 0 };
+    {
+        concurrent::thread_pool pool(4);
+        pool.push_task(spawn_tree, std::ref(pool), depth, std::ref(counter));
+
+        while (counter.load() != task_num)
+            std::this_thread::yield();
+    }
+    EXPECT_EQ(counter.load(), task_num);
+}
+
+TEST(ThreadPoolTest, ExternalAndNestedPushesFromManyThreads)
+{
+    concurrent::thread_pool pool(4);
+
+    constexpr size_t pusher_num = 4;
+    constexpr size_t task_num = 2000;
+    std::atomic<size_t> counter{ 0 };
+    {
+        std::vector<std::jthread> pushers;
+        for (size_t p = 0; p < pusher_num; ++p)
+        {
+            pushers.emplace_back([&]()
+            {
+                for (size_t i = 0; i < task_num; ++i)
+                    pool.push_task([&]() { pool.push_task([&counter]() { ++counter; }); });
+            });
+        }
+    }
+
+    while (counter.load() != pusher_num * task_num)
+        std::this_thread::yield();
+
+    EXPECT_EQ(counter.load(), pusher_num * task_num);
+}
+
+TEST(ThreadPoolTest, ZeroInjectionCapacity)
+{
+    EXPECT_THROW(concurrent::thread_pool(1, { .injection = concurrent::injection_queue::lock_free,
+                                              .injection_capacity = 0 }),
+                 std::invalid_argument);
+}
+
+class LockFreeInjectionTest : public testing::TestWithParam<concurrent::full_policy>
+{};
+
+// External pushes outpace the workers, so the small injection queue is full most of the time
+TEST_P(LockFreeInjectionTest, StressTest)
+{
+    concurrent::thread_pool pool(4, { .injection = concurrent::injection_queue::lock_free,
+                                      .injection_capacity = 8,
+                                      .when_full = GetParam() });
+
+    constexpr size_t pusher_num = 4;
+    constexpr size_t task_num = 2000;
+    std::atomic<size_t> counter{ 0 };
+    {
+        std::vector<std::jthread> pushers;
+        for (size_t p = 0; p < pusher_num; ++p)
+        {
+            pushers.emplace_back([&]()
+            {
+                for (size_t i = 0; i < task_num;)
+                {
+                    try
+                    {
+                        pool.push_task([&counter]() { ++counter; });
+                        ++i;
+                    } catch (const std::overflow_error&)
+                    {
+                        // Only the reject policy throws, the task is pushed again
+                        EXPECT_EQ(GetParam(), concurrent::full_policy::reject);
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+    }
+
+    while (counter.load() != pusher_num * task_num)
+        std::this_thread::yield();
+
+    EXPECT_EQ(counter.load(), pusher_num * task_num);
+}
+
+INSTANTIATE_TEST_SUITE_P(FullPolicies, LockFreeInjectionTest,
+                         testing::Values(concurrent::full_policy::block, concurrent::full_policy::spin,
+                                         concurrent::full_policy::reject));
+
+TEST(ThreadPoolTest, SubmitLambda)
+{
+    concurrent::thread_pool pool(1);
+    auto future = pool.submit([](const int a, const int b) { return a * b; }, 3, 4);
+    EXPECT_EQ(future.get(), 12);
+}
+
+TEST(ThreadPoolTest, SubmitMoveOnlyArgument)
+{
+    concurrent::thread_pool pool(1);
+    auto future = pool.submit([](std::unique_ptr<int> value) { return value; }, std::make_unique<int>(3));
+    EXPECT_EQ(*future.get(), 3);
+}
+
+TEST(ThreadPoolTest, SubmitMemberFunction)
+{
+    concurrent::thread_pool pool(1);
+    const test_class object;
+    auto future = pool.submit(&test_class::multiply, &object, 3, 4);
+    EXPECT_EQ(future.get(), 12);
+}
+
+TEST(ThreadPoolTest, SubmitException)
+{
+    concurrent::thread_pool pool(1);
+    auto future = pool.submit([]() { throw std::runtime_error("Error"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, PostRunsTasks)
+{
+    concurrent::thread_pool pool(2);
+    std::atomic<int> counter{ 0 };
+    for (int i = 0; i < 100; ++i)
+        pool.post([&counter](const int x) { counter += x; }, 1);
+
+    while (counter.load() != 100)
+        std::this_thread::yield();
+}
+
+TEST(ThreadPoolTest, PushTasksRunsEveryTask)
+{
+    std::atomic<int> counter{ 0 };
+
+    for (const auto injection: { concurrent::injection_queue::locked, concurrent::injection_queue::lock_free })
+    {
+        counter = 0;
+        std::vector<std::function<void()>> tasks(100, [&counter]() { counter++; });
+        concurrent::thread_pool pool(3, { .injection = injection, .injection_capacity = 16 });
+        pool.push_tasks(tasks);
+        pool.push_tasks(std::move(tasks));
+
+        while (counter.load() != 200)
+            std::this_thread::yield();
+    }
+}
+
+TEST(ThreadPoolTest, PushTasksFromTask)
+{
+    concurrent::thread_pool pool(2);
+    std::atomic<int> counter{ 0 };
+    pool.post(
+            [&pool, &counter]()
+            {
+                std::vector<std::function<void()>> tasks(50, [&counter]() { counter++; });
+                pool.push_tasks(tasks);
+            });
+
+    while (counter.load() != 50)
+        std::this_thread::yield();
+}
+
+TEST(ThreadPoolTest, PushTasksEmptyRange)
+{
+    concurrent::thread_pool pool(1);
+    pool.push_tasks(std::vector<std::function<void()>>{});
+}
+
+TEST(ThreadPoolTest, PushTasksRejected)
+{
+    concurrent::thread_pool pool(1, { .injection = concurrent::injection_queue::lock_free,
+                                      .injection_capacity = 2,
+                                      .when_full = concurrent::full_policy::reject });
+
+    std::atomic<bool> release{ false };
+    std::atomic<int> counter{ 0 };
+    pool.post(
+            [&release]()
+            {
+                while (!release.load())
+                    std::this_thread::yield();
+            });
+
+    // The worker may take the blocking task from the queue or not, either way 8 tasks do not fit
+    std::vector<std::function<void()>> tasks(8, [&counter]() { counter++; });
+    EXPECT_THROW(pool.push_tasks(tasks), std::overflow_error);
+    release = true;
+
+    // The accepted tasks still run
+    while (counter.load() == 0)
+        std::this_thread::yield();
+}
+
+TEST(ThreadPoolTest, PostExceptionGoesToHandler)
+{
+    std::atomic<int> handled{ 0 };
+    concurrent::thread_pool pool(1, { .exception_handler = [&handled](const std::exception_ptr& exception)
+    {
+        try
+        {
+            std::rethrow_exception(exception);
+        } catch (const std::runtime_error&)
+        {
+            ++handled;
+        }
+    } });
+
+    pool.post([]() { throw std::runtime_error("Error"); });
+    auto future = pool.submit([]() { return 1; });
+    EXPECT_EQ(future.get(), 1);
+
+    while (handled.load() != 1)
+        std::this_thread::yield();
+}
+
+TEST(ThreadPoolTest, PendingSubmittedTasksBreakPromises)
+{
+    concurrent::task_future<int> future;
+    {
+        concurrent::thread_pool pool(1);
+        std::atomic<bool> first_task_started{ false };
+        pool.post([&first_task_started]()
+        {
+            first_task_started = true;
+            first_task_started.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        });
+        future = pool.submit([]() { return 1; });
+        first_task_started.wait(false);
+    }
+    EXPECT_THROW(future.get(), std::future_error);
+}
+
+// After a warm-up tasks and future states are recycled, the lock-free injection queue does not allocate
+TEST(ThreadPoolTest, SmallTasksAllocateNothing)
+{
+    concurrent::thread_pool pool(2, { .injection = concurrent::injection_queue::lock_free });
+
+    constexpr size_t task_num = 1000;
+    std::atomic<size_t> counter{ 0 };
+    std::vector<concurrent::task_future<size_t>> futures(task_num);
+
+    // The warm-up queues all tasks at once with the workers blocked, more than any later run has in flight. Spare
+    // tasks and futures make up for the recycled blocks the workers keep in their caches
+    auto run_tasks = [&](const size_t spare_tasks)
+    {
+        std::atomic<size_t> blocked{ 0 };
+        std::atomic<bool> released{ false };
+        // Waited for, the blocking tasks use the flags of this run until they return
+        std::vector<concurrent::task_future<void>> blocking_tasks;
+        if (spare_tasks > 0)
+        {
+            for (size_t i = 0; i < pool.size(); ++i)
+            {
+                blocking_tasks.push_back(pool.submit([&blocked, &released]()
+                {
+                    ++blocked;
+                    blocked.notify_one();
+                    released.wait(false);
+                }));
+            }
+            for (size_t n = blocked.load(); n != pool.size(); n = blocked.load())
+                blocked.wait(n);
+        }
+
+        for (size_t i = 0; i < task_num; ++i)
+        {
+            pool.post([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+            futures[i] = pool.submit([](const size_t x) { return x; }, i);
+        }
+        std::vector<concurrent::task_future<size_t>> spare_futures;
+        for (size_t i = 0; i < spare_tasks; ++i)
+            spare_futures.push_back(pool.submit([](const size_t x) { return x; }, i));
+        released = true;
+        released.notify_all();
+        for (auto& blocking_task: blocking_tasks)
+            blocking_task.get();
+        for (auto& future: futures)
+            future.get();
+        for (auto& future: spare_futures)
+            future.get();
+        while (counter.load() != task_num)
+            std::this_thread::yield();
+        counter = 0;
+    };
+
+    for (int warm_up = 0; warm_up < 2; ++warm_up)
+        run_tasks(task_num);
+
+    const size_t allocations_before = allocation_count.load();
+    run_tasks(0);
+    EXPECT_EQ(allocation_count.load() - allocations_before, 0);
+}
+
+TEST(ThreadPoolTest, RunPendingTask)
+{
+    concurrent::thread_pool pool(1);
+    EXPECT_FALSE(pool.run_pending_task());
+
+    // Blocking the only worker, so the calling thread is the only one to run the next task
+    std::atomic<bool> started{ false };
+    std::atomic<bool> release{ false };
+    pool.post(
+            [&started, &release]()
+            {
+                started = true;
+                while (!release.load())
+                    std::this_thread::yield();
+            });
+    while (!started.load())
+        std::this_thread::yield();
+
+    auto future = pool.submit([]() { return std::this_thread::get_id(); });
+    EXPECT_TRUE(pool.run_pending_task());
+    EXPECT_EQ(future.get(), std::this_thread::get_id());
+    EXPECT_FALSE(pool.run_pending_task());
+
+    release = true;
+}
+
+namespace
+{
+/** Blocks the only worker of the pool until release is set, so the next tasks wait in their queues */
+void block_worker(concurrent::thread_pool& pool, std::atomic<bool>& release)
+{
+    std::atomic<bool> started{ false };
+    pool.post(
+            [&started, &release]()
+            {
+                started = true;
+                while (!release.load())
+                    std::this_thread::yield();
+            });
+    while (!started.load())
+        std::this_thread::yield();
+}
+
+/** Records the names of tasks run by one worker, a record is published by the counter */
+struct order_recorder
+{
+    std::string order;
+    std::atomic<size_t> recorded{ 0 };
+
+    auto record(const char name)
+    {
+        return [this, name]()
+        {
+            order.push_back(name);
+            recorded.fetch_add(1, std::memory_order_release);
+        };
+    }
+
+    const std::string& wait_for(const size_t count)
+    {
+        while (recorded.load(std::memory_order_acquire) != count)
+            std::this_thread::yield();
+        return order;
+    }
+};
+} // namespace
+
+TEST(ThreadPoolTest, NestedHelpingOfOtherThreadsIsBounded)
+{
+    concurrent::thread_pool pool(1);
+    std::atomic<bool> release{ false };
+    block_worker(pool, release);
+
+    // Every task helps with the next one, a thread which is not a worker stops nesting at the limit
+    constexpr size_t task_num = 100;
+    size_t depth = 0;
+    size_t max_depth = 0;
+    for (size_t i = 0; i < task_num; ++i)
+    {
+        pool.post(
+                [&pool, &depth, &max_depth]()
+                {
+                    max_depth = std::max(max_depth, ++depth);
+                    pool.run_pending_task();
+                    depth--;
+                });
+    }
+
+    EXPECT_TRUE(pool.run_pending_task());
+    EXPECT_EQ(max_depth, 64);
+
+    while (pool.run_pending_task())
+    {}
+    release = true;
+}
+
+TEST(ThreadPoolTest, NestedHelpingOfWorkersIsBounded)
+{
+    // The lock-free injection queue moves no tasks to the deque of the worker, so the limit is exact
+    concurrent::thread_pool pool(1, { .injection = concurrent::injection_queue::lock_free });
+    std::atomic<bool> release{ false };
+    block_worker(pool, release);
+
+    // The worker helps with injected tasks up to the limit, deeper it still runs the children in its own deque
+    constexpr size_t task_num = 100;
+    size_t depth = 0;
+    size_t max_depth = 0;
+    size_t declined = 0;
+    size_t children = 0;
+    std::atomic<size_t> done{ 0 };
+    for (size_t i = 0; i < task_num; ++i)
+    {
+        pool.post(
+                [&]()
+                {
+                    max_depth = std::max(max_depth, ++depth);
+                    if (!pool.run_pending_task())
+                    {
+                        declined++;
+                        pool.post([&children]() { children++; });
+                        pool.run_pending_task();
+                    }
+                    depth--;
+                    done.fetch_add(1, std::memory_order_release);
+                });
+    }
+    release = true;
+
+    while (done.load(std::memory_order_acquire) != task_num)
+        std::this_thread::yield();
+    EXPECT_EQ(max_depth, 65);
+    EXPECT_EQ(children, declined);
+}
+
+TEST(ThreadPoolTest, WaitHelpingIsWokenByCountDown)
+{
+    concurrent::thread_pool pool(1);
+    std::atomic<size_t> pending{ 1 };
+    std::atomic<bool> returned{ false };
+    std::jthread waiter(
+            [&]()
+            {
+                pool.wait_helping(pending);
+                returned = true;
+            });
+
+    // Nothing to help with, the waiter sleeps until the counter reaches zero
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(returned);
+
+    pool.count_down(pending);
+    waiter.join();
+    EXPECT_TRUE(returned);
+}
+
+TEST(ThreadPoolTest, WaitingWorkerRunsPushedTasks)
+{
+    // The only worker sleeps in wait_helping(), a task pushed meanwhile wakes it, nobody else can run it
+    concurrent::thread_pool pool(1);
+    std::atomic<size_t> pending{ 1 };
+    auto waiting = pool.submit([&]() { pool.wait_helping(pending); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto pushed = pool.submit([]() { return 42; });
+    EXPECT_EQ(pushed.get(), 42);
+
+    pool.count_down(pending);
+    waiting.get();
+}
+
+TEST(ThreadPoolTest, ZeroLaneWeight)
+{
+    EXPECT_THROW(concurrent::thread_pool(1, { .lane_weights = { 1, 0, 1 } }), std::invalid_argument);
+}
+
+TEST(ThreadPoolTest, LanesWeightedRoundRobin)
+{
+    // Rounds of four turns: two critical, one normal and one background. The normal lane is empty, its turn
+    // goes to the critical lane, so the background lane gets every fourth turn until the critical one is empty
+    concurrent::thread_pool pool(1, { .lane_weights = { 2, 1, 1 } });
+    std::atomic<bool> release{ false };
+    block_worker(pool, release);
+
+    order_recorder recorder;
+    for (int i = 0; i < 4; ++i)
+        pool.post({ .priority = concurrent::task_priority::background }, recorder.record('b'));
+    for (int i = 0; i < 6; ++i)
+        pool.post({ .priority = concurrent::task_priority::critical }, recorder.record('c'));
+
+    release = true;
+    EXPECT_EQ(recorder.wait_for(10), "cccbcccbbb");
+}
+
+TEST(ThreadPoolTest, LaneTasksAndNormalTasks)
+{
+    concurrent::thread_pool pool(1, { .lane_weights = { 1, 1, 1 } });
+    std::atomic<bool> release{ false };
+    block_worker(pool, release);
+
+    order_recorder recorder;
+    for (int i = 0; i < 3; ++i)
+    {
+        pool.post(recorder.record('n'));
+        pool.post({ .priority = concurrent::task_priority::background }, recorder.record('b'));
+        pool.post({ .priority = concurrent::task_priority::critical }, recorder.record('c'));
+    }
+
+    release = true;
+    EXPECT_EQ(recorder.wait_for(9), "cnbcnbcnb");
+}
+
+TEST(ThreadPoolTest, EarliestDeadlineFirstInLane)
+{
+    concurrent::thread_pool pool(1);
+    std::atomic<bool> release{ false };
+    block_worker(pool, release);
+
+    const auto now = std::chrono::steady_clock::now();
+    order_recorder recorder;
+    pool.post({ .priority = concurrent::task_priority::critical }, recorder.record('x'));
+    pool.post({ .priority = concurrent::task_priority::critical, .deadline = now + std::chrono::seconds(3) },
+              recorder.record('3'));
+    pool.post({ .priority = concurrent::task_priority::critical, .deadline = now + std::chrono::seconds(1) },
+              recorder.record('1'));
+    pool.post({ .priority = concurrent::task_priority::critical }, recorder.record('y'));
+    pool.post({ .priority = concurrent::task_priority::critical, .deadline = now + std::chrono::seconds(2) },
+              recorder.record('2'));
+
+    release = true;
+    EXPECT_EQ(recorder.wait_for(5), "123xy");
+}
+
+TEST(ThreadPoolTest, NormalTasksWithDeadlineGoFirst)
+{
+    concurrent::thread_pool pool(1);
+    std::atomic<bool> release{ false };
+    block_worker(pool, release);
+
+    order_recorder recorder;
+    pool.post(recorder.record('n'));
+    pool.post({ .deadline = std::chrono::steady_clock::now() }, recorder.record('d'));
+    auto future = pool.submit({ .priority = concurrent::task_priority::background }, []() { return 5; });
+
+    release = true;
+    EXPECT_EQ(recorder.wait_for(2), "dn");
+    EXPECT_EQ(future.get(), 5);
+}
+
+TEST(ThreadPoolTest, PendingLaneTasksBreakPromises)
+{
+    concurrent::task_future<int> future;
+    {
+        concurrent::thread_pool pool(1);
+        std::atomic<bool> first_task_started{ false };
+        pool.post([&first_task_started]()
+        {
+            first_task_started = true;
+            first_task_started.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        });
+        future = pool.submit({ .priority = concurrent::task_priority::background }, []() { return 1; });
+        first_task_started.wait(false);
+    }
+    EXPECT_THROW(future.get(), std::future_error);
+}
+
+TEST(ThreadPoolTest, MaxThreadsLessThanSize)
+{
+    EXPECT_THROW(concurrent::thread_pool(4, { .max_threads = 2 }), std::invalid_argument);
+    EXPECT_EQ(concurrent::thread_pool(2, { .max_threads = 0 }).size(), 2);
+}
+
+TEST(ThreadPoolTest, ElasticPoolGrowsAndShrinks)
+{
+    concurrent::thread_pool pool(
+            1, { .max_threads = 4, .grow_backlog = 1, .idle_timeout = std::chrono::milliseconds(10) });
+    EXPECT_EQ(pool.size(), 4);
+    EXPECT_EQ(pool.thread_count(), 1);
+
+    // Twice, the second time stopped workers are started again
+    for (int round = 0; round < 2; ++round)
+    {
+        // Blocked tasks keep the backlog until every worker is running
+        std::atomic<bool> release{ false };
+        std::atomic<int> completed{ 0 };
+        constexpr int task_num = 32;
+        for (int i = 0; i < task_num; ++i)
+        {
+            pool.post(
+                    [&release, &completed]()
+                    {
+                        while (!release.load())
+                            std::this_thread::yield();
+                        completed++;
+                    });
+        }
+        while (pool.thread_count() != 4)
+            std::this_thread::yield();
+
+        release = true;
+        while (completed.load() != task_num)
+            std::this_thread::yield();
+
+        while (pool.thread_count() != 1)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EXPECT_EQ(pool.submit([]() { return 1; }).get(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, IdleStrategies)
+{
+    for (const auto& options: { concurrent::thread_pool_options{ .spin_pauses = 0, .spin_yields = 0 },
+                               concurrent::thread_pool_options{ .spin_pauses = 1024, .spin_yields = 0 },
+                               concurrent::thread_pool_options{ .spin_pauses = 0, .spin_yields = 16 } })
+    {
+        concurrent::thread_pool pool(2, options);
+        for (int i = 0; i < 100; ++i)
+            EXPECT_EQ(pool.submit([i]() { return i; }).get(), i);
+    }
+}
+
+namespace
+{
+/** A task is recorded after it completes its future, so the metrics may lag behind */
+void wait_for_recorded_tasks(const concurrent::thread_pool& pool, const uint64_t count)
+{
+    auto recorded_tasks = [&pool]()
+    {
+        const concurrent::thread_pool_metrics metrics = pool.metrics();
+        uint64_t executed = metrics.other_threads.executed_tasks;
+        for (const auto& worker: metrics.workers)
+            executed += worker.executed_tasks;
+        return executed;
+    };
+
+    if constexpr (concurrent::thread_pool_metrics_enabled)
+    {
+        while (recorded_tasks() < count)
+            std::this_thread::yield();
+    }
+}
+} // namespace
+
+TEST(ThreadPoolTest, Metrics)
+{
+    concurrent::thread_pool pool(2);
+    constexpr size_t task_num = 2 * concurrent::metrics_sample_period;
+    for (size_t i = 0; i < task_num; ++i)
+        pool.submit([]() { std::this_thread::sleep_for(std::chrono::microseconds(10)); }).get();
+    wait_for_recorded_tasks(pool, task_num);
+
+    const concurrent::thread_pool_metrics metrics = pool.metrics();
+    if constexpr (!concurrent::thread_pool_metrics_enabled)
+    {
+        EXPECT_TRUE(metrics.workers.empty());
+        EXPECT_EQ(metrics.execution.count(), 0);
+        return;
+    }
+
+    ASSERT_EQ(metrics.workers.size(), 2);
+    uint64_t executed = 0;
+    for (const auto& worker: metrics.workers)
+    {
+        executed += worker.executed_tasks;
+        EXPECT_GE(worker.utilization, 0.0);
+        EXPECT_LE(worker.utilization, 1.0);
+    }
+    EXPECT_EQ(executed, task_num);
+    EXPECT_EQ(metrics.other_threads.executed_tasks, 0);
+    EXPECT_EQ(metrics.queued_tasks, 0);
+
+    // One of metrics_sample_period consecutively created tasks is timed
+    EXPECT_GE(metrics.execution.count(), task_num / concurrent::metrics_sample_period);
+    EXPECT_LE(metrics.execution.count(), task_num / concurrent::metrics_sample_period + 1);
+    EXPECT_GE(metrics.execution.percentile(50), 10'000);
+    EXPECT_EQ(metrics.queue_wait.count(), metrics.execution.count());
+}
+
+TEST(ThreadPoolTest, MetricsOfOtherThreads)
+{
+    concurrent::thread_pool pool(1);
+    std::atomic<bool> release{ false };
+    block_worker(pool, release);
+
+    pool.post([]() {});
+    EXPECT_TRUE(pool.run_pending_task());
+    if constexpr (concurrent::thread_pool_metrics_enabled)
+    {
+        EXPECT_EQ(pool.metrics().other_threads.executed_tasks, 1);
+    }
+
+    release = true;
+}
+
+TEST(ThreadPoolTest, Trace)
+{
+    auto count_spans = [](const std::string& trace)
+    {
+        size_t spans = 0;
+        for (size_t position = trace.find("\"ph\":\"X\""); position != std::string::npos;
+             position = trace.find("\"ph\":\"X\"", position + 1))
+            spans++;
+        return spans;
+    };
+
+    concurrent::thread_pool pool(2);
+    pool.start_trace();
+    for (int i = 0; i < 10; ++i)
+        pool.submit([]() {}).get();
+    wait_for_recorded_tasks(pool, 10);
+    pool.stop_trace();
+    pool.submit([]() {}).get();
+
+    std::ostringstream output;
+    pool.write_trace(output);
+    EXPECT_EQ(count_spans(output.str()), concurrent::thread_pool_metrics_enabled ? 10 : 0);
+
+    // Restarting discards the spans, every thread records up to the maximum
+    pool.start_trace(2);
+    for (int i = 0; i < 10; ++i)
+        pool.submit([]() {}).get();
+    wait_for_recorded_tasks(pool, 21);
+
+    output.str("");
+    pool.write_trace(output);
+    if constexpr (concurrent::thread_pool_metrics_enabled)
+    {
+        EXPECT_GE(count_spans(output.str()), 2);
+        EXPECT_LE(count_spans(output.str()), 4);
+    }
+}
+
 TEST(ThreadPoolTest, ExceptionDoesNotAffectOtherTasks)
 {
     concurrent::thread_pool pool(2);
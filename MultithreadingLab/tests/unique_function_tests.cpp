@@ -0,0 +1,113 @@
+#include "unique_function.h"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using function_type = concurrent::unique_function<int(int)>;
+
+static_assert(!std::is_copy_constructible_v<function_type>);
+static_assert(std::is_nothrow_move_constructible_v<function_type>);
+static_assert(sizeof(function_type) <= 64);
+
+TEST(UniqueFunctionTest, EmptyFunction)
+{
+    function_type function;
+    EXPECT_FALSE(function);
+    EXPECT_THROW(function(1), std::bad_function_call);
+
+    function_type null_function = nullptr;
+    EXPECT_FALSE(null_function);
+}
+
+TEST(UniqueFunctionTest, CallsLambda)
+{
+    function_type function = [](const int x) { return x * 2; };
+    EXPECT_TRUE(function);
+    EXPECT_EQ(function(21), 42);
+}
+
+int add_one(const int x)
+{
+    return x + 1;
+}
+
+TEST(UniqueFunctionTest, CallsFunctionPointer)
+{
+    function_type function = add_one;
+    EXPECT_EQ(function(1), 2);
+}
+
+TEST(UniqueFunctionTest, MoveOnlyCapture)
+{
+    function_type function = [value = std::make_unique<int>(10)](const int x) { return *value + x; };
+    EXPECT_EQ(function(1), 11);
+}
+
+TEST(UniqueFunctionTest, MutableState)
+{
+    concurrent::unique_function<int()> counter = [count = 0]() mutable { return ++count; };
+    EXPECT_EQ(counter(), 1);
+    EXPECT_EQ(counter(), 2);
+}
+
+TEST(UniqueFunctionTest, MoveOnlyArgument)
+{
+    concurrent::unique_function<int(std::unique_ptr<int>)> function = [](std::unique_ptr<int> value)
+    { return *value; };
+    EXPECT_EQ(function(std::make_unique<int>(5)), 5);
+}
+
+TEST(UniqueFunctionTest, SmallCallablesAreInline)
+{
+    auto small = [value = std::array<int64_t, 6>{}](int) { return static_cast<int>(value[0]); };
+    auto big = [value = std::array<int64_t, 7>{}](int) { return static_cast<int>(value[0]); };
+
+    EXPECT_TRUE(function_type::is_inline<decltype(small)>);
+    EXPECT_FALSE(function_type::is_inline<decltype(big)>);
+    EXPECT_TRUE((concurrent::unique_function<int(int), 64>::is_inline<decltype(big)>));
+}
+
+class UniqueFunctionStorageTest : public testing::Test
+{
+protected:
+    template<size_t Size>
+    static function_type make_function(const std::shared_ptr<int>& value)
+    {
+        return [value, padding = std::array<char, Size>{}](const int x) { return *value + x + padding[0]; };
+    }
+
+    // Moves, move assignments and destruction must keep exactly one copy of the callable alive
+    template<size_t Size>
+    static void check_ownership()
+    {
+        const auto value = std::make_shared<int>(1);
+        {
+            function_type function = make_function<Size>(value);
+            EXPECT_EQ(value.use_count(), 2);
+
+            function_type moved = std::move(function);
+            EXPECT_FALSE(function);
+            EXPECT_EQ(moved(1), 2);
+            EXPECT_EQ(value.use_count(), 2);
+
+            function_type assigned = make_function<Size>(value);
+            EXPECT_EQ(value.use_count(), 3);
+            assigned = std::move(moved);
+            EXPECT_EQ(value.use_count(), 2);
+            EXPECT_EQ(assigned(2), 3);
+        }
+        EXPECT_EQ(value.use_count(), 1);
+    }
+};
+
+TEST_F(UniqueFunctionStorageTest, InlineOwnership)
+{
+    check_ownership<8>();
+}
+
+TEST_F(UniqueFunctionStorageTest, HeapOwnership)
+{
+    check_ownership<128>();
+}
@@ -0,0 +1,125 @@
+#include "work_stealing_deque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+static_assert(!std::is_copy_constructible_v<concurrent::work_stealing_deque<int>>);
+static_assert(!std::is_move_constructible_v<concurrent::work_stealing_deque<int>>);
+
+TEST(WorkStealingDequeTest, ZeroCapacity)
+{
+    EXPECT_THROW(concurrent::work_stealing_deque<int>(0), std::invalid_argument);
+}
+
+TEST(WorkStealingDequeTest, CapacityIsPowerOfTwo)
+{
+    const concurrent::work_stealing_deque<int> deque(100);
+    EXPECT_EQ(deque.capacity(), 128);
+}
+
+TEST(WorkStealingDequeTest, EmptyDeque)
+{
+    concurrent::work_stealing_deque<int> deque;
+    EXPECT_TRUE(deque.empty());
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, PopIsLifo)
+{
+    concurrent::work_stealing_deque<int> deque;
+    int items[3]{ 0, 1, 2 };
+    for (int& item: items)
+        deque.push(&item);
+
+    EXPECT_EQ(deque.size(), 3);
+    EXPECT_EQ(deque.pop(), &items[2]);
+    EXPECT_EQ(deque.pop(), &items[1]);
+    EXPECT_EQ(deque.pop(), &items[0]);
+    EXPECT_EQ(deque.pop(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, StealIsFifo)
+{
+    concurrent::work_stealing_deque<int> deque;
+    int items[3]{ 0, 1, 2 };
+    for (int& item: items)
+        deque.push(&item);
+
+    EXPECT_EQ(deque.steal(), &items[0]);
+    EXPECT_EQ(deque.steal(), &items[1]);
+    EXPECT_EQ(deque.pop(), &items[2]);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, Grows)
+{
+    concurrent::work_stealing_deque<int> deque(2);
+    std::vector<int> items(100);
+    for (size_t i = 0; i < 50; ++i)
+        deque.push(&items[i]);
+
+    // Wrapping around the circular storage before the next growth
+    for (size_t i = 0; i < 25; ++i)
+        EXPECT_EQ(deque.steal(), &items[i]);
+    for (size_t i = 50; i < items.size(); ++i)
+        deque.push(&items[i]);
+
+    EXPECT_GE(deque.capacity(), 75);
+    for (size_t i = items.size(); i > 25; --i)
+        EXPECT_EQ(deque.pop(), &items[i - 1]);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealsTakeEveryItemOnce)
+{
+    constexpr size_t item_num = 100000;
+    constexpr size_t thief_num = 3;
+
+    concurrent::work_stealing_deque<size_t> deque(16);
+    std::vector<size_t> items(item_num);
+    std::vector<std::atomic<int>> taken(item_num);
+    std::atomic<size_t> taken_num{ 0 };
+
+    auto take = [&](const size_t* item)
+    {
+        taken[*item].fetch_add(1);
+        taken_num.fetch_add(1);
+    };
+
+    std::vector<std::jthread> thieves;
+    for (size_t t = 0; t < thief_num; ++t)
+    {
+        thieves.emplace_back([&]()
+        {
+            while (taken_num.load() != item_num)
+            {
+                if (const size_t* item = deque.steal())
+                    take(item);
+            }
+        });
+    }
+
+    // The owner interleaves pushes with pops to race with thieves for the last items
+    for (size_t i = 0; i < item_num; ++i)
+    {
+        items[i] = i;
+        deque.push(&items[i]);
+
+        if (i % 3 == 0)
+        {
+            if (const size_t* item = deque.pop())
+                take(item);
+        }
+    }
+    while (const size_t* item = deque.pop())
+        take(item);
+
+    for (auto& thief: thieves)
+        thief.join();
+
+    EXPECT_TRUE(std::ranges::all_of(taken, [](const std::atomic<int>& count) { return count.load() == 1; }));
+}
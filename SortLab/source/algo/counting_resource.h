@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+namespace algo
+{
+/** Allocation statistics of a counting_resource since its creation or the last reset */
+struct memory_stats
+{
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    /** Total bytes of all allocations */
+    size_t allocated_bytes = 0;
+    /** Bytes of allocations which are not returned yet */
+    size_t bytes_in_use = 0;
+    /** High-water mark of bytes in use */
+    size_t peak_bytes = 0;
+};
+
+/**
+ * Memory resource which passes allocations to the upstream resource and counts them. Counters are relaxed
+ * atomics, so a resource can be shared by threads and is cheap enough to stay enabled in production: pass it as
+ * the scratch resource of sorts (or wrap a sampled part of calls) and read stats() after them
+ */
+class counting_resource final : public std::pmr::memory_resource
+{
+public:
+    explicit counting_resource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    counting_resource(const counting_resource& other) = delete;
+    counting_resource& operator=(const counting_resource& other) = delete;
+
+    counting_resource(counting_resource&& other) = delete;
+    counting_resource& operator=(counting_resource&& other) = delete;
+
+    ~counting_resource() override = default;
+
+    [[nodiscard]] std::pmr::memory_resource* upstream() const;
+
+    [[nodiscard]] memory_stats stats() const;
+
+    /** Starts counting from zero, the high-water mark starts from bytes which are still in use */
+    void reset();
+
+private:
+    std::pmr::memory_resource* _upstream;
+
+    std::atomic<size_t> _allocations{ 0 };
+    std::atomic<size_t> _deallocations{ 0 };
+    std::atomic<size_t> _allocated_bytes{ 0 };
+    std::atomic<size_t> _bytes_in_use{ 0 };
+    std::atomic<size_t> _peak_bytes{ 0 };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+
+inline counting_resource::counting_resource(std::pmr::memory_resource* upstream) : _upstream(upstream) {}
+
+inline std::pmr::memory_resource* counting_resource::upstream() const
+{
+    return _upstream;
+}
+
+inline memory_stats counting_resource::stats() const
+{
+    return { _allocations.load(std::memory_order_relaxed), _deallocations.load(std::memory_order_relaxed),
+             _allocated_bytes.load(std::memory_order_relaxed), _bytes_in_use.load(std::memory_order_relaxed),
+             _peak_bytes.load(std::memory_order_relaxed) };
+}
+
+inline void counting_resource::reset()
+{
+    _allocations.store(0, std::memory_order_relaxed);
+    _deallocations.store(0, std::memory_order_relaxed);
+    _allocated_bytes.store(0, std::memory_order_relaxed);
+    _peak_bytes.store(_bytes_in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+inline void* counting_resource::do_allocate(const size_t bytes, const size_t alignment)
+{
+    void* pointer = _upstream->allocate(bytes, alignment);
+
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    _allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    const size_t in_use = _bytes_in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    // Atomic maximum
+    size_t peak = _peak_bytes.load(std::memory_order_relaxed);
+    while (peak < in_use && !_peak_bytes.compare_exchange_weak(peak, in_use, std::memory_order_relaxed))
+    {
+    }
+
+    return pointer;
+}
+
+inline void counting_resource::do_deallocate(void* pointer, const size_t bytes, const size_t alignment)
+{
+    _upstream->deallocate(pointer, bytes, alignment);
+
+    _deallocations.fetch_add(1, std::memory_order_relaxed);
+    _bytes_in_use.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+inline bool counting_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+} // namespace algo
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory_resource>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define ALGO_HAS_MMAP
+#endif
+
+namespace algo
+{
+/** Size of a transparent huge page on x86-64 and AArch64 Linux */
+inline constexpr size_t huge_page_size = size_t{ 2 } << 20;
+
+namespace local
+{
+    /** Regular page size, every page is touched once */
+    inline constexpr size_t page_size = 4096;
+
+    inline constexpr size_t min_bytes_for_threading = size_t{ 32 } << 20;
+
+    inline size_t round_up(const size_t value, const size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    /** Every allocation takes at least one huge page, even an empty one */
+    inline size_t huge_pages_size(const size_t bytes)
+    {
+        return round_up(std::max(bytes, size_t{ 1 }), huge_page_size);
+    }
+
+    /**
+     * Touches pages by at most threads threads with the same halving of the range and of the threads budget as
+     * the concurrent sorts: the right half is touched by a new thread with the half of the budget
+     */
+    inline void first_touch(std::byte* data, const size_t bytes, const size_t threads)
+    {
+        if (threads <= 1 || bytes <= min_bytes_for_threading)
+        {
+            for (size_t offset = 0; offset < bytes; offset += page_size)
+                data[offset] = std::byte{ 0 };
+            return;
+        }
+
+        // Both halves start at a huge page boundary, so every huge page is touched by one thread only
+        const size_t mid = round_up(bytes / 2, huge_page_size);
+
+        // This thread touches the left part, a new thread touches the right part
+        auto right_future = std::async(std::launch::async, first_touch, data + mid, bytes - mid, threads / 2);
+        first_touch(data, mid, threads - threads / 2);
+
+        // Waiting for the right part to be touched
+        right_future.get();
+    }
+} // namespace local
+
+/**
+ * Memory resource for large sort buffers: memory is mapped at 2 MB boundaries and marked for transparent
+ * huge pages, which reduces TLB misses of random accesses. Pages are touched on allocation by at most
+ * first_touch_threads threads, so page faults are not paid by the first sort pass. The touching threads are
+ * neither pinned nor the ones sorting later, so NUMA placement of the pages is not controlled.
+ * With zero threads pages are not touched in advance. Falls back to aligned operator new where mmap is not available
+ */
+class huge_page_resource final : public std::pmr::memory_resource
+{
+public:
+    explicit huge_page_resource(
+            const size_t first_touch_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1))
+        : _first_touch_threads(first_touch_threads)
+    {}
+
+private:
+    size_t _first_touch_threads;
+
+    void* do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        assert(alignment <= huge_page_size);
+
+        const size_t size = local::huge_pages_size(bytes);
+        std::byte* data = nullptr;
+
+#ifdef ALGO_HAS_MMAP
+        // Mapping one more huge page and trimming both ends to get a 2 MB aligned mapping
+        const size_t mapped_size = size + huge_page_size;
+        void* mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED)
+            throw std::bad_alloc();
+
+        auto* mapped_begin = static_cast<std::byte*>(mapped);
+        data = mapped_begin + (huge_page_size - reinterpret_cast<uintptr_t>(mapped) % huge_page_size) % huge_page_size;
+
+        if (data != mapped_begin)
+            munmap(mapped_begin, static_cast<size_t>(data - mapped_begin));
+        if (data + size != mapped_begin + mapped_size)
+            munmap(data + size, static_cast<size_t>(mapped_begin + mapped_size - (data + size)));
+
+#ifdef MADV_HUGEPAGE
+        // Only a hint, memory is still usable with regular pages if huge pages are disabled
+        madvise(data, size, MADV_HUGEPAGE);
+#endif
+#else
+        data = static_cast<std::byte*>(::operator new(size, std::align_val_t{ huge_page_size }));
+#endif
+
+        if (_first_touch_threads != 0)
+            local::first_touch(data, size, _first_touch_threads);
+
+        return data;
+    }
+
+    void do_deallocate(void* pointer, const size_t bytes, [[maybe_unused]] const size_t alignment) override
+    {
+        const size_t size = local::huge_pages_size(bytes);
+#ifdef ALGO_HAS_MMAP
+        munmap(pointer, size);
+#else
+        ::operator delete(pointer, size, std::align_val_t{ huge_page_size });
+#endif
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/** Huge page resource with first touch by all hardware threads shared by all large buffers */
+inline huge_page_resource& default_huge_page_resource()
+{
+    static huge_page_resource resource;
+    return resource;
+}
+
+/**
+ * Fixed size array of trivial elements for large data sets (e.g. generated data for sorts).
+ * Elements are not initialized
+ */
+template<class T>
+class large_buffer final
+{
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_default_constructible_v<T>);
+
+public:
+    explicit large_buffer(const size_t size, std::pmr::memory_resource* resource = &default_huge_page_resource())
+        : _resource(resource), _size(size)
+    {
+        if (size != 0)
+            _data = static_cast<T*>(_resource->allocate(size * sizeof(T), alignof(T)));
+    }
+
+    large_buffer(const large_buffer& other) = delete;
+    large_buffer& operator=(const large_buffer& other) = delete;
+
+    ~large_buffer()
+    {
+        if (_data != nullptr)
+            _resource->deallocate(_data, _size * sizeof(T), alignof(T));
+    }
+
+    T* data()
+    {
+        return _data;
+    }
+
+    const T* data() const
+    {
+        return _data;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return _size;
+    }
+
+    T* begin()
+    {
+        return _data;
+    }
+
+    T* end()
+    {
+        return _data + _size;
+    }
+
+    const T* begin() const
+    {
+        return _data;
+    }
+
+    const T* end() const
+    {
+        return _data + _size;
+    }
+
+    T& operator[](const size_t index)
+    {
+        return _data[index];
+    }
+
+    const T& operator[](const size_t index) const
+    {
+        return _data[index];
+    }
+
+private:
+    std::pmr::memory_resource* _resource;
+    T* _data = nullptr;
+    size_t _size;
+};
+} // namespace algo
@@ -0,0 +1,472 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ALGO_SIMD_AVX2
+#else
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ALGO_SIMD_SSE2
+#endif
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#define ALGO_SIMD_SSE41
+#endif
+#endif
+
+namespace algo::local
+{
+/** Classic merge of [first, first + size1) and [second, second + size2) into result */
+template<class T>
+void merge_branchy(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+{
+    size_t i = 0, j = 0;
+
+    while (i < size1 && j < size2)
+    {
+        if (first[i] < second[j])
+        {
+            result[i + j] = first[i];
+            i++;
+        }
+        else
+        {
+            result[i + j] = second[j];
+            j++;
+        }
+    }
+
+    std::copy(first + i, first + size1, result + i + j);
+    std::copy(second + j, second + size2, result + size1 + j);
+}
+
+/** Merge without data dependent branches, the next element is selected with a conditional move */
+template<class T>
+void merge_branchless(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+{
+    const T* const first_end = first + size1;
+    const T* const second_end = second + size2;
+
+    while (first != first_end && second != second_end)
+    {
+        const bool take_second = *second < *first;
+        *result++ = take_second ? *second : *first;
+        second += take_second;
+        first += !take_second;
+    }
+
+    result = std::copy(first, first_end, result);
+    std::copy(second, second_end, result);
+}
+
+namespace simd
+{
+    /**
+     * Merge kernel sorts 2 * lanes elements of two sorted registers with a bitonic merge network:
+     * a receives the lower half and b receives the upper half, both in ascending order.
+     */
+    template<class T>
+    struct merge_kernel
+    {
+        static constexpr bool available = false;
+    };
+
+#ifdef ALGO_SIMD_AVX2
+    template<>
+    struct merge_kernel<std::int32_t>
+    {
+        static constexpr bool available = true;
+        static constexpr size_t lanes = 8;
+        using vector = __m256i;
+
+        static vector load(const std::int32_t* data)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        }
+
+        static void store(std::int32_t* data, const vector v)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), v);
+        }
+
+        static vector bitonic_sort(vector v)
+        {
+            // Compare-exchange of lanes at distance 4
+            vector swapped = _mm256_permute2x128_si256(v, v, 0x01);
+            v = _mm256_permute2x128_si256(_mm256_min_epi32(v, swapped), _mm256_max_epi32(v, swapped), 0x20);
+
+            // Compare-exchange of lanes at distance 2 inside of both 128-bit halves
+            swapped = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+            v = _mm256_unpacklo_epi64(_mm256_min_epi32(v, swapped), _mm256_max_epi32(v, swapped));
+
+            // Compare-exchange of neighbour lanes
+            const vector even = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 0, 2, 0));
+            const vector odd = _mm256_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 3, 1));
+            return _mm256_unpacklo_epi32(_mm256_min_epi32(even, odd), _mm256_max_epi32(even, odd));
+        }
+
+        static void merge(vector& a, vector& b)
+        {
+            // a and reversed b form a bitonic sequence, which is split into lower and upper bitonic halves
+            b = _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+            const vector lower = _mm256_min_epi32(a, b);
+            const vector upper = _mm256_max_epi32(a, b);
+            a = bitonic_sort(lower);
+            b = bitonic_sort(upper);
+        }
+    };
+
+    template<>
+    struct merge_kernel<float>
+    {
+        static constexpr bool available = true;
+        static constexpr size_t lanes = 8;
+        using vector = __m256;
+
+        static vector load(const float* data)
+        {
+            return _mm256_loadu_ps(data);
+        }
+
+        static void store(float* data, const vector v)
+        {
+            _mm256_storeu_ps(data, v);
+        }
+
+        static void min_max(const vector a, const vector b, vector& lower, vector& upper)
+        {
+            // Blending by a comparison moves whole values, unlike min/max it keeps signed zeros and NaN operands,
+            // so the output is always a permutation of the input
+            const vector greater = _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+            lower = _mm256_blendv_ps(a, b, greater);
+            upper = _mm256_blendv_ps(b, a, greater);
+        }
+
+        static vector bitonic_sort(vector v)
+        {
+            vector lower, upper;
+
+            // Compare-exchange of lanes at distance 4
+            min_max(v, _mm256_permute2f128_ps(v, v, 0x01), lower, upper);
+            v = _mm256_permute2f128_ps(lower, upper, 0x20);
+
+            // Compare-exchange of lanes at distance 2 inside of both 128-bit halves
+            min_max(v, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)), lower, upper);
+            v = _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(lower), _mm256_castps_pd(upper)));
+
+            // Compare-exchange of neighbour lanes
+            min_max(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 0, 2, 0)), _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 3, 1)),
+                    lower, upper);
+            return _mm256_unpacklo_ps(lower, upper);
+        }
+
+        static void merge(vector& a, vector& b)
+        {
+            vector lower, upper;
+            min_max(a, _mm256_permutevar8x32_ps(b, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)), lower, upper);
+            a = bitonic_sort(lower);
+            b = bitonic_sort(upper);
+        }
+    };
+
+    template<>
+    struct merge_kernel<std::int64_t>
+    {
+        static constexpr bool available = true;
+        static constexpr size_t lanes = 4;
+        using vector = __m256i;
+
+        static vector load(const std::int64_t* data)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        }
+
+        static void store(std::int64_t* data, const vector v)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), v);
+        }
+
+        static void min_max(const vector a, const vector b, vector& lower, vector& upper)
+        {
+            // There are no 64-bit min/max instructions before AVX-512, so they are emulated with blending
+            const vector greater = _mm256_cmpgt_epi64(a, b);
+            lower = _mm256_blendv_epi8(a, b, greater);
+            upper = _mm256_blendv_epi8(b, a, greater);
+        }
+
+        static vector bitonic_sort(vector v)
+        {
+            vector lower, upper;
+
+            // Compare-exchange of lanes at distance 2
+            min_max(v, _mm256_permute2x128_si256(v, v, 0x01), lower, upper);
+            v = _mm256_permute2x128_si256(lower, upper, 0x20);
+
+            // Compare-exchange of neighbour lanes
+            min_max(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), lower, upper);
+            return _mm256_unpacklo_epi64(lower, upper);
+        }
+
+        static void merge(vector& a, vector& b)
+        {
+            vector lower, upper;
+            min_max(a, _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 1, 2, 3)), lower, upper);
+            a = bitonic_sort(lower);
+            b = bitonic_sort(upper);
+        }
+    };
+
+    template<>
+    struct merge_kernel<double>
+    {
+        static constexpr bool available = true;
+        static constexpr size_t lanes = 4;
+        using vector = __m256d;
+
+        static vector load(const double* data)
+        {
+            return _mm256_loadu_pd(data);
+        }
+
+        static void store(double* data, const vector v)
+        {
+            _mm256_storeu_pd(data, v);
+        }
+
+        static void min_max(const vector a, const vector b, vector& lower, vector& upper)
+        {
+            // Blending keeps signed zeros and NaN operands, see the float kernel
+            const vector greater = _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+            lower = _mm256_blendv_pd(a, b, greater);
+            upper = _mm256_blendv_pd(b, a, greater);
+        }
+
+        static vector bitonic_sort(vector v)
+        {
+            vector lower, upper;
+
+            // Compare-exchange of lanes at distance 2
+            min_max(v, _mm256_permute2f128_pd(v, v, 0x01), lower, upper);
+            v = _mm256_permute2f128_pd(lower, upper, 0x20);
+
+            // Compare-exchange of neighbour lanes
+            min_max(v, _mm256_shuffle_pd(v, v, 0b0101), lower, upper);
+            return _mm256_unpacklo_pd(lower, upper);
+        }
+
+        static void merge(vector& a, vector& b)
+        {
+            vector lower, upper;
+            min_max(a, _mm256_permute4x64_pd(b, _MM_SHUFFLE(0, 1, 2, 3)), lower, upper);
+            a = bitonic_sort(lower);
+            b = bitonic_sort(upper);
+        }
+    };
+#endif
+
+#ifdef ALGO_SIMD_SSE41
+    template<>
+    struct merge_kernel<std::int32_t>
+    {
+        static constexpr bool available = true;
+        static constexpr size_t lanes = 4;
+        using vector = __m128i;
+
+        static vector load(const std::int32_t* data)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        }
+
+        static void store(std::int32_t* data, const vector v)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data), v);
+        }
+
+        static vector bitonic_sort(vector v)
+        {
+            // Compare-exchange of lanes (0, 2) and (1, 3)
+            const vector swapped = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+            v = _mm_unpacklo_epi64(_mm_min_epi32(v, swapped), _mm_max_epi32(v, swapped));
+
+            // Compare-exchange of lanes (0, 1) and (2, 3)
+            const vector even = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 0, 2, 0));
+            const vector odd = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 3, 1));
+            return _mm_unpacklo_epi32(_mm_min_epi32(even, odd), _mm_max_epi32(even, odd));
+        }
+
+        static void merge(vector& a, vector& b)
+        {
+            // a and reversed b form a bitonic sequence, which is split into lower and upper bitonic halves
+            b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 1, 2, 3));
+            const vector lower = _mm_min_epi32(a, b);
+            const vector upper = _mm_max_epi32(a, b);
+            a = bitonic_sort(lower);
+            b = bitonic_sort(upper);
+        }
+    };
+#endif
+
+#ifdef ALGO_SIMD_SSE2
+    template<>
+    struct merge_kernel<float>
+    {
+        static constexpr bool available = true;
+        static constexpr size_t lanes = 4;
+        using vector = __m128;
+
+        static vector load(const float* data)
+        {
+            return _mm_loadu_ps(data);
+        }
+
+        static void store(float* data, const vector v)
+        {
+            _mm_storeu_ps(data, v);
+        }
+
+        static void min_max(const vector a, const vector b, vector& lower, vector& upper)
+        {
+            // Unlike min/max, swapping the lanes selected by a comparison keeps signed zeros and NaN operands.
+            // SSE2 has no blend instruction, the mask of the difference swaps the lanes
+            const vector swap = _mm_and_ps(_mm_cmpgt_ps(a, b), _mm_xor_ps(a, b));
+            lower = _mm_xor_ps(a, swap);
+            upper = _mm_xor_ps(b, swap);
+        }
+
+        static vector bitonic_sort(vector v)
+        {
+            vector lower, upper;
+
+            // Compare-exchange of lanes (0, 2) and (1, 3)
+            min_max(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)), lower, upper);
+            v = _mm_movelh_ps(lower, upper);
+
+            // Compare-exchange of lanes (0, 1) and (2, 3)
+            min_max(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 3, 1)), lower,
+                    upper);
+            return _mm_unpacklo_ps(lower, upper);
+        }
+
+        static void merge(vector& a, vector& b)
+        {
+            vector lower, upper;
+            min_max(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), lower, upper);
+            a = bitonic_sort(lower);
+            b = bitonic_sort(upper);
+        }
+    };
+
+    template<>
+    struct merge_kernel<double>
+    {
+        static constexpr bool available = true;
+        static constexpr size_t lanes = 2;
+        using vector = __m128d;
+
+        static vector load(const double* data)
+        {
+            return _mm_loadu_pd(data);
+        }
+
+        static void store(double* data, const vector v)
+        {
+            _mm_storeu_pd(data, v);
+        }
+
+        static void min_max(const vector a, const vector b, vector& lower, vector& upper)
+        {
+            // Swapping the lanes selected by the comparison keeps signed zeros and NaN operands, see the float kernel
+            const vector swap = _mm_and_pd(_mm_cmpgt_pd(a, b), _mm_xor_pd(a, b));
+            lower = _mm_xor_pd(a, swap);
+            upper = _mm_xor_pd(b, swap);
+        }
+
+        static vector bitonic_sort(const vector v)
+        {
+            vector lower, upper;
+            min_max(v, _mm_shuffle_pd(v, v, 1), lower, upper);
+            return _mm_unpacklo_pd(lower, upper);
+        }
+
+        static void merge(vector& a, vector& b)
+        {
+            vector lower, upper;
+            min_max(a, _mm_shuffle_pd(b, b, 1), lower, upper);
+            a = bitonic_sort(lower);
+            b = bitonic_sort(upper);
+        }
+    };
+#endif
+
+    template<class T>
+    void merge(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+    {
+        using kernel = merge_kernel<T>;
+        static constexpr size_t lanes = kernel::lanes;
+
+        if (size1 < lanes || size2 < lanes)
+        {
+            merge_branchless(first, size1, second, size2, result);
+            return;
+        }
+
+        typename kernel::vector a = kernel::load(first);
+        typename kernel::vector b = kernel::load(second);
+        size_t i = lanes, j = lanes;
+
+        kernel::merge(a, b);
+        kernel::store(result, a);
+        result += lanes;
+
+        // b always keeps the largest merged elements, which can not be written yet.
+        // The next block is loaded from the range with the smaller head, so that all of b's elements
+        // and the new block's lower elements are not greater than any element left in both ranges
+        while (i + lanes <= size1 && j + lanes <= size2)
+        {
+            const bool take_second = second[j] < first[i];
+            a = kernel::load(take_second ? second + j : first + i);
+            j += take_second ? lanes : 0;
+            i += take_second ? 0 : lanes;
+
+            kernel::merge(a, b);
+            kernel::store(result, a);
+            result += lanes;
+        }
+
+        // At least one of the ranges has less than lanes elements left, they are merged with b's elements first
+        T pending[lanes];
+        kernel::store(pending, b);
+
+        T tail[2 * lanes];
+        if (size1 - i < lanes)
+        {
+            merge_branchless(pending, lanes, first + i, size1 - i, tail);
+            merge_branchless(tail, lanes + size1 - i, second + j, size2 - j, result);
+        }
+        else
+        {
+            merge_branchless(pending, lanes, second + j, size2 - j, tail);
+            merge_branchless(tail, lanes + size2 - j, first + i, size1 - i, result);
+        }
+    }
+} // namespace simd
+
+/**
+ * Default merge kernel: vectorized bitonic merge for arithmetic types which have SIMD support on the target,
+ * branchless merge for other arithmetic types and the classic merge for everything else
+ */
+template<class T>
+void merge_into(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+{
+    if constexpr (simd::merge_kernel<T>::available)
+        simd::merge(first, size1, second, size2, result);
+    else if constexpr (std::is_arithmetic_v<T>)
+        merge_branchless(first, size1, second, size2, result);
+    else
+        merge_branchy(first, size1, second, size2, result);
+}
+} // namespace algo::local
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+
+namespace algo
+{
+/**
+ * Memory resource for temporary buffers of sorts which is reused between calls.
+ * Allocations are taken from one block, the block is reset when all allocations are returned.
+ * Allocations which do not fit are served by the upstream resource, and the block grows to the peak usage
+ * on the next allocation after a reset, so a loop of sorts of similar sizes does not allocate after warm-up.
+ * Deallocations never allocate, so they do not throw.
+ * The arena is not thread-safe, use one arena per thread (see thread_local_scratch_arena)
+ */
+class scratch_arena final : public std::pmr::memory_resource
+{
+public:
+    /** Alignment of the block, allocations with larger alignment are always served by the upstream resource */
+    static constexpr size_t block_alignment = 64;
+
+    explicit scratch_arena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    scratch_arena(const scratch_arena& other) = delete;
+    scratch_arena& operator=(const scratch_arena& other) = delete;
+
+    scratch_arena(scratch_arena&& other) = delete;
+    scratch_arena& operator=(scratch_arena&& other) = delete;
+
+    ~scratch_arena() override;
+
+    /** Size of the reusable block in bytes */
+    [[nodiscard]] size_t capacity() const;
+
+    /** Returns the block to the upstream resource, all allocations must be returned before */
+    void release();
+
+private:
+    std::pmr::memory_resource* _upstream;
+
+    std::byte* _block = nullptr;
+    size_t _capacity = 0;
+    size_t _used = 0;
+
+    /** Number of allocations which are not returned yet and bytes requested by them (including overflows) */
+    size_t _active_allocations = 0;
+    size_t _requested = 0;
+    size_t _peak_requested = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    /** Replaces the block by one of the peak usage, only when no allocation is active */
+    void grow();
+};
+
+/** Scratch arena of the calling thread */
+scratch_arena& thread_local_scratch_arena();
+
+
+inline scratch_arena::scratch_arena(std::pmr::memory_resource* upstream) : _upstream(upstream) {}
+
+inline scratch_arena::~scratch_arena()
+{
+    release();
+}
+
+inline size_t scratch_arena::capacity() const
+{
+    return _capacity;
+}
+
+inline void scratch_arena::release()
+{
+    if (_block != nullptr)
+        _upstream->deallocate(_block, _capacity, block_alignment);
+
+    _block = nullptr;
+    _capacity = 0;
+    _used = 0;
+}
+
+inline void* scratch_arena::do_allocate(const size_t bytes, const size_t alignment)
+{
+    if (_active_allocations == 0 && _peak_requested > _capacity)
+        grow();
+
+    void* pointer = nullptr;
+    if (alignment <= block_alignment && _block != nullptr)
+    {
+        // An allocation must start inside the block, even an empty one, so that do_deallocate recognizes it
+        const size_t offset = (_used + alignment - 1) / alignment * alignment;
+        if (offset < _capacity && offset + bytes <= _capacity)
+        {
+            _used = offset + bytes;
+            pointer = _block + offset;
+        }
+    }
+
+    if (pointer == nullptr)
+        pointer = _upstream->allocate(bytes, alignment);
+
+    // Counted only after a successful allocation, a failed one leaves the arena as it was.
+    // Requested bytes are counted with the worst case padding, so that the grown block always fits them
+    _requested += bytes + alignment;
+    _peak_requested = std::max(_peak_requested, _requested);
+    _active_allocations++;
+
+    return pointer;
+}
+
+inline void scratch_arena::do_deallocate(void* pointer, const size_t bytes, const size_t alignment)
+{
+    const auto* byte_pointer = static_cast<std::byte*>(pointer);
+    if (_block == nullptr || byte_pointer < _block || byte_pointer >= _block + _capacity)
+        _upstream->deallocate(pointer, bytes, alignment);
+
+    _requested -= bytes + alignment;
+    if (--_active_allocations == 0)
+        _used = 0;
+}
+
+inline bool scratch_arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+inline void scratch_arena::grow()
+{
+    // Some allocations of the previous calls did not fit, the block grows to serve all of them
+    release();
+
+    // Set only after a successful allocation, otherwise the arena stays without a block
+    const size_t capacity = (_peak_requested + block_alignment - 1) / block_alignment * block_alignment;
+    _block = static_cast<std::byte*>(_upstream->allocate(capacity, block_alignment));
+    _capacity = capacity;
+}
+
+inline scratch_arena& thread_local_scratch_arena()
+{
+    thread_local scratch_arena arena;
+    return arena;
+}
+} // namespace algo
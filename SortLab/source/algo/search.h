@@ -0,0 +1,32 @@
+#pragma once
+
+#include "sort.h"
+
+#include <concepts>
+#include <ranges>
+
+namespace algo
+{
+/** Contiguous range of lookup keys of the same type as the searched range */
+template<typename RangeType, typename ValueType>
+concept ContiguousQueryRange = std::ranges::contiguous_range<RangeType> && std::ranges::sized_range<RangeType> &&
+                               std::same_as<std::ranges::range_value_t<RangeType>, ValueType>;
+
+/** Contiguous range for storing found positions */
+template<typename RangeType>
+concept ContiguousIndexRange = std::ranges::contiguous_range<RangeType> && std::ranges::sized_range<RangeType> &&
+                               std::same_as<std::ranges::range_value_t<RangeType>, size_t>;
+
+/**
+ * Finds std::lower_bound positions in the sorted range for every query: out[i] is the index of the first element
+ * which is not less than queries[i]. The out range must have at least queries.size() elements.
+ * Large batches are split between at most threads threads, including the calling one.
+ * Throws std::invalid_argument if threads is zero
+ */
+template<ContiguousSortableRange SortedRange, ContiguousQueryRange<std::ranges::range_value_t<SortedRange>> QueryRange,
+         ContiguousIndexRange OutputRange>
+void batch_lower_bound(const SortedRange& sorted, const QueryRange& queries, OutputRange&& out,
+                       size_t threads = concurrent::default_threads());
+} // namespace algo
+
+#include "search.inl"
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <future>
+#include <stdexcept>
+
+namespace algo
+{
+namespace local
+{
+    inline void prefetch(const void* address)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void) address;
+#endif
+    }
+
+    /**
+     * Number of searches advanced in lockstep. Each of them issues its own independent load on every step,
+     * so up to this number of cache misses are in flight at once.
+     */
+    static constexpr size_t lookup_group_size = 32;
+
+    template<class T>
+    void lower_bound_group(const T* range, const size_t size, const T* queries, const size_t count, size_t* out)
+    {
+        assert(count <= lookup_group_size);
+
+        if (size == 0)
+        {
+            std::fill(out, out + count, 0);
+            return;
+        }
+
+        // Branchless search: the remaining length depends only on the range size and not on the compared values,
+        // that is why all the searches in the group make the same number of steps and can be interleaved
+        const T* bases[lookup_group_size];
+        std::fill(bases, bases + count, range);
+
+        size_t length = size;
+        while (length > 1)
+        {
+            const size_t half = length / 2;
+            length -= half;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                bases[i] = bases[i][half] < queries[i] ? bases[i] + half : bases[i];
+                // Requesting the element of the next step while the other searches are processed
+                prefetch(bases[i] + length / 2);
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            out[i] = static_cast<size_t>(bases[i] - range) + (*bases[i] < queries[i] ? 1 : 0);
+    }
+
+    template<class T>
+    void batch_lower_bound(const T* range, const size_t size, const T* queries, const size_t count, size_t* out)
+    {
+        for (size_t start = 0; start < count; start += lookup_group_size)
+        {
+            const size_t group_count = std::min(lookup_group_size, count - start);
+            lower_bound_group(range, size, queries + start, group_count, out + start);
+        }
+    }
+
+    namespace concurrent
+    {
+        static constexpr size_t min_queries_for_threading = 1 << 16;
+
+        /** The threads budget is shared like by concurrent sorts */
+        template<class T>
+        void batch_lower_bound(const T* range, const size_t size, const T* queries, const size_t count, size_t* out,
+                               const size_t threads)
+        {
+            if (threads <= 1 || count <= min_queries_for_threading)
+            {
+                local::batch_lower_bound(range, size, queries, count, out);
+                return;
+            }
+
+            const size_t mid = count / 2;
+
+            // This thread searches the left part of queries, a new thread searches the right part
+            auto right_future = std::async(std::launch::async, concurrent::batch_lower_bound<T>, range, size,
+                                           queries + mid, count - mid, out + mid, threads / 2);
+            concurrent::batch_lower_bound(range, size, queries, mid, out, threads - threads / 2);
+
+            // Waiting for the right part to be searched
+            right_future.get();
+        }
+    } // namespace concurrent
+} // namespace local
+
+template<ContiguousSortableRange SortedRange, ContiguousQueryRange<std::ranges::range_value_t<SortedRange>> QueryRange,
+         ContiguousIndexRange OutputRange>
+void batch_lower_bound(const SortedRange& sorted, const QueryRange& queries, OutputRange&& out, const size_t threads)
+{
+    local::concurrent::check_threads(threads);
+    if (out.size() < queries.size())
+        throw std::invalid_argument("batch_lower_bound output range must be at least as large as queries");
+
+    local::concurrent::batch_lower_bound(sorted.data(), sorted.size(), queries.data(), queries.size(), out.data(),
+                                         threads);
+}
+} // namespace algo
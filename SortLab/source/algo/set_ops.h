@@ -0,0 +1,91 @@
+#pragma once
+
+#include "search.h"
+#include "sort.h"
+
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace algo
+{
+/** Contiguous range for storing results of set operations */
+template<typename RangeType, typename ValueType>
+concept ContiguousOutputRange = std::ranges::contiguous_range<RangeType> && std::ranges::sized_range<RangeType> &&
+                                std::same_as<std::ranges::range_value_t<RangeType>, ValueType>;
+
+/**
+ * Sorts the range and removes duplicates during the sort: unique elements are placed at the beginning of the range,
+ * the rest of the range is left in a valid but unspecified state. Returns the number of unique elements.
+ * Scratch buffers are allocated from the scratch resource like by merge sorts
+ */
+template<ContiguousSortableRange RangeType>
+size_t sort_unique(RangeType&& range, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+/**
+ * Sorts the range and counts occurrences of every key during the sort. Returns keys in ascending order, copies
+ * of them are left at the beginning of the range like by sort_unique. Keys and counts are merged in scratch buffers
+ * of the scratch resource, only the result is allocated by the default allocator
+ */
+template<ContiguousSortableRange RangeType>
+std::vector<std::pair<std::ranges::range_value_t<RangeType>, size_t>>
+sort_count_by_key(RangeType&& range, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+/**
+ * Set operations on sorted ranges without duplicates (e.g. results of sort_unique).
+ * Results are written to the beginning of out, which must be large enough for the worst case:
+ * min(first.size(), second.size()) for intersection, first.size() + second.size() for union
+ * and first.size() for difference. Every function returns the number of written elements
+ */
+template<ContiguousSortableRange FirstRange, ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+         ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+size_t set_intersection(const FirstRange& first, const SecondRange& second, OutputRange&& out);
+
+template<ContiguousSortableRange FirstRange, ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+         ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+size_t set_union(const FirstRange& first, const SecondRange& second, OutputRange&& out);
+
+template<ContiguousSortableRange FirstRange, ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+         ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+size_t set_difference(const FirstRange& first, const SecondRange& second, OutputRange&& out);
+
+namespace concurrent
+{
+    /**
+     * Concurrent fused sorts use at most threads threads at the same time, including the calling one. Halves are
+     * sorted in parallel and merged in parts split with merge path. Throws std::invalid_argument if threads is zero
+     */
+    template<ContiguousSortableRange RangeType>
+    size_t sort_unique(RangeType&& range, std::pmr::memory_resource* scratch = std::pmr::get_default_resource(),
+                       size_t threads = default_threads());
+
+    template<ContiguousSortableRange RangeType>
+    std::vector<std::pair<std::ranges::range_value_t<RangeType>, size_t>>
+    sort_count_by_key(RangeType&& range, std::pmr::memory_resource* scratch = std::pmr::get_default_resource(),
+                      size_t threads = default_threads());
+
+    /**
+     * Concurrent set operations split both sets with merge path into parts processed by at most threads threads
+     * at the same time, including the calling one. Throws std::invalid_argument if threads is zero
+     */
+    template<ContiguousSortableRange FirstRange,
+             ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+             ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+    size_t set_intersection(const FirstRange& first, const SecondRange& second, OutputRange&& out,
+                           size_t threads = default_threads());
+
+    template<ContiguousSortableRange FirstRange,
+             ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+             ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+    size_t set_union(const FirstRange& first, const SecondRange& second, OutputRange&& out,
+                    size_t threads = default_threads());
+
+    template<ContiguousSortableRange FirstRange,
+             ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+             ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+    size_t set_difference(const FirstRange& first, const SecondRange& second, OutputRange&& out,
+                         size_t threads = default_threads());
+} // namespace concurrent
+} // namespace algo
+
+#include "set_ops.inl"
@@ -0,0 +1,735 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+
+namespace algo
+{
+namespace local
+{
+    /** Ranges of this size are sorted with insertion sort inside of fused sorts */
+    static constexpr size_t fused_sort_leaf_size = 32;
+
+    /** Merge of two sorted ranges without duplicates, equal elements of both ranges are written once */
+    template<class T>
+    size_t merge_unique(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+    {
+        size_t i = 0, j = 0, k = 0;
+
+        while (i < size1 && j < size2)
+        {
+            const T& a = first[i];
+            const T& b = second[j];
+            const bool take_first = !(b < a), take_second = !(a < b);
+            result[k++] = take_first ? a : b;
+            i += take_first;
+            j += take_second;
+        }
+
+        result = std::copy(first + i, first + size1, result + k);
+        std::copy(second + j, second + size2, result);
+        return k + (size1 - i) + (size2 - j);
+    }
+
+    /** Merge sort which drops duplicates on every level, so that later levels merge less elements */
+    template<class T>
+    size_t sort_unique(T* range, const size_t size, T* buffer)
+    {
+        if (size <= fused_sort_leaf_size)
+        {
+            local::insertion_sort(range, size);
+            return static_cast<size_t>(std::unique(range, range + size) - range);
+        }
+
+        const size_t mid = size / 2;
+        const size_t size1 = sort_unique(range, mid, buffer);
+        const size_t size2 = sort_unique(range + mid, size - mid, buffer + mid);
+
+        const size_t merged_size = merge_unique(range, size1, range + mid, size2, buffer);
+        std::copy(buffer, buffer + merged_size, range);
+        return merged_size;
+    }
+
+    /** Merge of two sorted key ranges without duplicates, counts of equal keys are summed */
+    template<class T>
+    size_t merge_count(const T* keys1, const size_t* counts1, const size_t size1, const T* keys2,
+                       const size_t* counts2, const size_t size2, T* result_keys, size_t* result_counts)
+    {
+        size_t i = 0, j = 0, k = 0;
+
+        while (i < size1 && j < size2)
+        {
+            const T& a = keys1[i];
+            const T& b = keys2[j];
+            const bool take_first = !(b < a), take_second = !(a < b);
+            result_keys[k] = take_first ? a : b;
+            result_counts[k] = (take_first ? counts1[i] : 0) + (take_second ? counts2[j] : 0);
+            k++;
+            i += take_first;
+            j += take_second;
+        }
+
+        std::copy(keys1 + i, keys1 + size1, result_keys + k);
+        std::copy(counts1 + i, counts1 + size1, result_counts + k);
+        k += size1 - i;
+        std::copy(keys2 + j, keys2 + size2, result_keys + k);
+        std::copy(counts2 + j, counts2 + size2, result_counts + k);
+        return k + (size2 - j);
+    }
+
+    /** Merge sort which combines equal keys on every level and keeps their counts in the parallel array */
+    template<class T>
+    size_t sort_count_by_key(T* keys, size_t* counts, const size_t size, T* key_buffer, size_t* count_buffer)
+    {
+        if (size <= fused_sort_leaf_size)
+        {
+            local::insertion_sort(keys, size);
+
+            // Run-length encoding of the sorted leaf
+            size_t unique_size = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (unique_size > 0 && keys[unique_size - 1] == keys[i])
+                {
+                    counts[unique_size - 1]++;
+                }
+                else
+                {
+                    keys[unique_size] = keys[i];
+                    counts[unique_size] = 1;
+                    unique_size++;
+                }
+            }
+            return unique_size;
+        }
+
+        const size_t mid = size / 2;
+        const size_t size1 = sort_count_by_key(keys, counts, mid, key_buffer, count_buffer);
+        const size_t size2 =
+                sort_count_by_key(keys + mid, counts + mid, size - mid, key_buffer + mid, count_buffer + mid);
+
+        const size_t merged_size =
+                merge_count(keys, counts, size1, keys + mid, counts + mid, size2, key_buffer, count_buffer);
+        std::copy(key_buffer, key_buffer + merged_size, keys);
+        std::copy(count_buffer, count_buffer + merged_size, counts);
+        return merged_size;
+    }
+
+    /** Pairs the unique keys left at the beginning of the range with their counts, the keys are copied */
+    template<class T>
+    std::vector<std::pair<T, size_t>> make_key_counts(const T* keys, const size_t* counts, const size_t size)
+    {
+        std::vector<std::pair<T, size_t>> result;
+        result.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+            result.emplace_back(keys[i], counts[i]);
+
+        return result;
+    }
+
+    /** Searching the lower bound with exponentially growing steps starting from the given position */
+    template<class T>
+    size_t gallop_lower_bound(const T* range, const size_t size, const size_t from, const T& value)
+    {
+        size_t low = from, high = from, step = 1;
+
+        while (high < size && range[high] < value)
+        {
+            low = high + 1;
+            high += step;
+            step *= 2;
+        }
+
+        high = std::min(high, size);
+        return static_cast<size_t>(std::lower_bound(range + low, range + high, value) - range);
+    }
+
+    /** Ranges which are this many times larger than the other one are searched with galloping */
+    static constexpr size_t gallop_size_ratio = 32;
+
+    template<class T>
+    size_t intersection_scalar(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+    {
+        size_t i = 0, j = 0, k = 0;
+
+        // result[k] is always within the result range because k < min(i, j) + 1 <= min(size1, size2)
+        while (i < size1 && j < size2)
+        {
+            const T& a = first[i];
+            const T& b = second[j];
+            result[k] = a;
+            k += a == b;
+            i += !(b < a);
+            j += !(a < b);
+        }
+
+        return k;
+    }
+
+    template<class T>
+    size_t intersection_gallop(const T* small, const size_t small_size, const T* large, const size_t large_size,
+                               T* result)
+    {
+        size_t k = 0, position = 0;
+
+        for (size_t i = 0; i < small_size && position < large_size; ++i)
+        {
+            position = gallop_lower_bound(large, large_size, position, small[i]);
+            if (position < large_size && large[position] == small[i])
+                result[k++] = small[i];
+        }
+
+        return k;
+    }
+
+    template<class T>
+    size_t union_gallop(const T* small, const size_t small_size, const T* large, const size_t large_size, T* result)
+    {
+        size_t k = 0, position = 0;
+
+        for (size_t i = 0; i < small_size; ++i)
+        {
+            const size_t next_position = gallop_lower_bound(large, large_size, position, small[i]);
+            std::copy(large + position, large + next_position, result + k);
+            k += next_position - position;
+            result[k++] = small[i];
+
+            position = next_position;
+            if (position < large_size && large[position] == small[i])
+                position++;
+        }
+
+        std::copy(large + position, large + large_size, result + k);
+        return k + large_size - position;
+    }
+
+    template<class T>
+    size_t difference_scalar(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+    {
+        size_t i = 0, j = 0, k = 0;
+
+        while (i < size1 && j < size2)
+        {
+            const T& a = first[i];
+            const T& b = second[j];
+            result[k] = a;
+            k += a < b;
+            i += !(b < a);
+            j += !(a < b);
+        }
+
+        std::copy(first + i, first + size1, result + k);
+        return k + size1 - i;
+    }
+
+    /** Difference of a small range and a large range */
+    template<class T>
+    size_t difference_gallop_second(const T* first, const size_t size1, const T* second, const size_t size2,
+                                    T* result)
+    {
+        size_t k = 0, position = 0;
+
+        for (size_t i = 0; i < size1; ++i)
+        {
+            position = gallop_lower_bound(second, size2, position, first[i]);
+            if (position == size2 || !(second[position] == first[i]))
+                result[k++] = first[i];
+        }
+
+        return k;
+    }
+
+    /** Difference of a large range and a small range */
+    template<class T>
+    size_t difference_gallop_first(const T* first, const size_t size1, const T* second, const size_t size2,
+                                   T* result)
+    {
+        size_t k = 0, position = 0;
+
+        for (size_t j = 0; j < size2; ++j)
+        {
+            const size_t next_position = gallop_lower_bound(first, size1, position, second[j]);
+            std::copy(first + position, first + next_position, result + k);
+            k += next_position - position;
+
+            position = next_position;
+            if (position < size1 && first[position] == second[j])
+                position++;
+        }
+
+        std::copy(first + position, first + size1, result + k);
+        return k + size1 - position;
+    }
+
+    namespace simd
+    {
+        template<class T>
+        struct set_kernel
+        {
+            static constexpr bool available = false;
+        };
+
+#if defined(ALGO_SIMD_AVX2) || defined(ALGO_SIMD_SSE41)
+        /** Byte shuffles which pack the 32-bit lanes selected by a 4-bit mask to the beginning of a register */
+        inline constexpr auto pack_lanes_shuffles = []
+        {
+            std::array<std::array<std::uint8_t, 16>, 16> shuffles{};
+            for (size_t mask = 0; mask < 16; ++mask)
+            {
+                shuffles[mask].fill(0x80);
+                size_t packed = 0;
+                for (size_t lane = 0; lane < 4; ++lane)
+                {
+                    if ((mask & (size_t{ 1 } << lane)) == 0)
+                        continue;
+
+                    for (size_t byte = 0; byte < 4; ++byte)
+                        shuffles[mask][packed * 4 + byte] = static_cast<std::uint8_t>(lane * 4 + byte);
+                    packed++;
+                }
+            }
+            return shuffles;
+        }();
+
+        /** All-pairs comparison of two blocks of 4 sorted 32-bit integers */
+        template<>
+        struct set_kernel<std::int32_t>
+        {
+            static constexpr bool available = true;
+            static constexpr size_t lanes = 4;
+
+            /** Returns the mask of first's lanes which are equal to any of second's lanes */
+            static unsigned int match(const __m128i first, const __m128i second)
+            {
+                // Comparing with all rotations of second
+                const __m128i rotated1 = _mm_shuffle_epi32(second, _MM_SHUFFLE(0, 3, 2, 1));
+                const __m128i rotated2 = _mm_shuffle_epi32(second, _MM_SHUFFLE(1, 0, 3, 2));
+                const __m128i rotated3 = _mm_shuffle_epi32(second, _MM_SHUFFLE(2, 1, 0, 3));
+
+                const __m128i equal = _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi32(first, second), _mm_cmpeq_epi32(first, rotated1)),
+                        _mm_or_si128(_mm_cmpeq_epi32(first, rotated2), _mm_cmpeq_epi32(first, rotated3)));
+                return static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+            }
+
+            /** Writes the lanes selected by mask to result and returns their number */
+            static size_t pack(const __m128i block, const unsigned int mask, std::int32_t* result,
+                               const size_t capacity)
+            {
+                const auto* shuffle_data = reinterpret_cast<const __m128i*>(pack_lanes_shuffles[mask].data());
+                const __m128i packed = _mm_shuffle_epi8(block, _mm_loadu_si128(shuffle_data));
+                const auto packed_size = static_cast<size_t>(std::popcount(mask));
+
+                // Storing the whole register is cheaper, but it is possible only far enough from the result's end
+                if (capacity >= lanes)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(result), packed);
+                }
+                else
+                {
+                    std::int32_t stored[lanes];
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(stored), packed);
+                    std::copy(stored, stored + packed_size, result);
+                }
+
+                return packed_size;
+            }
+
+            static __m128i load(const std::int32_t* data)
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            }
+        };
+#endif
+
+        template<class T>
+        size_t intersection(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+        {
+            using kernel = set_kernel<T>;
+            static constexpr size_t lanes = kernel::lanes;
+
+            const size_t capacity = std::min(size1, size2);
+            size_t i = 0, j = 0, k = 0;
+
+            // Blocks are advanced like elements in the merge, so every pair of overlapping blocks is compared
+            while (i + lanes <= size1 && j + lanes <= size2)
+            {
+                const auto first_block = kernel::load(first + i);
+                const unsigned int mask = kernel::match(first_block, kernel::load(second + j));
+                k += kernel::pack(first_block, mask, result + k, capacity - k);
+
+                const T first_max = first[i + lanes - 1], second_max = second[j + lanes - 1];
+                i += first_max <= second_max ? lanes : 0;
+                j += second_max <= first_max ? lanes : 0;
+            }
+
+            return k + intersection_scalar(first + i, size1 - i, second + j, size2 - j, result + k);
+        }
+
+        template<class T>
+        size_t difference(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+        {
+            using kernel = set_kernel<T>;
+            static constexpr size_t lanes = kernel::lanes;
+            static constexpr unsigned int all_lanes = (1u << lanes) - 1;
+
+            size_t i = 0, j = 0, k = 0;
+            // Matches of the current first's block are collected until the block is passed
+            unsigned int matched = 0;
+
+            while (i + lanes <= size1 && j + lanes <= size2)
+            {
+                const auto first_block = kernel::load(first + i);
+                matched |= kernel::match(first_block, kernel::load(second + j));
+
+                const T first_max = first[i + lanes - 1], second_max = second[j + lanes - 1];
+                if (first_max <= second_max)
+                {
+                    k += kernel::pack(first_block, ~matched & all_lanes, result + k, size1 - k);
+                    i += lanes;
+                    matched = 0;
+                }
+                j += second_max <= first_max ? lanes : 0;
+            }
+
+            // Elements of the partially processed block are checked one by one against the rest of second
+            if (matched != 0)
+            {
+                for (size_t lane = 0; lane < lanes; ++lane, ++i)
+                {
+                    if ((matched & (1u << lane)) != 0)
+                        continue;
+
+                    j = gallop_lower_bound(second, size2, j, first[i]);
+                    if (j == size2 || !(second[j] == first[i]))
+                        result[k++] = first[i];
+                }
+            }
+
+            return k + difference_scalar(first + i, size1 - i, second + j, size2 - j, result + k);
+        }
+    } // namespace simd
+
+    template<class T>
+    size_t set_intersection(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+    {
+        if (size1 * gallop_size_ratio < size2)
+            return intersection_gallop(first, size1, second, size2, result);
+        if (size2 * gallop_size_ratio < size1)
+            return intersection_gallop(second, size2, first, size1, result);
+
+        if constexpr (simd::set_kernel<T>::available)
+            return simd::intersection(first, size1, second, size2, result);
+        else
+            return intersection_scalar(first, size1, second, size2, result);
+    }
+
+    template<class T>
+    size_t set_union(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+    {
+        if (size1 * gallop_size_ratio < size2)
+            return union_gallop(first, size1, second, size2, result);
+        if (size2 * gallop_size_ratio < size1)
+            return union_gallop(second, size2, first, size1, result);
+
+        return merge_unique(first, size1, second, size2, result);
+    }
+
+    template<class T>
+    size_t set_difference(const T* first, const size_t size1, const T* second, const size_t size2, T* result)
+    {
+        if (size1 * gallop_size_ratio < size2)
+            return difference_gallop_second(first, size1, second, size2, result);
+        if (size2 * gallop_size_ratio < size1)
+            return difference_gallop_first(first, size1, second, size2, result);
+
+        if constexpr (simd::set_kernel<T>::available)
+            return simd::difference(first, size1, second, size2, result);
+        else
+            return difference_scalar(first, size1, second, size2, result);
+    }
+
+    /** Worst case result sizes of set operations */
+    inline size_t intersection_size_bound(const size_t size1, const size_t size2)
+    {
+        return std::min(size1, size2);
+    }
+
+    inline size_t union_size_bound(const size_t size1, const size_t size2)
+    {
+        return size1 + size2;
+    }
+
+    inline size_t difference_size_bound(const size_t size1, const size_t)
+    {
+        return size1;
+    }
+
+    template<class RangeType>
+    void check_set_output(const RangeType& out, const size_t size_bound)
+    {
+        if (out.size() < size_bound)
+            throw std::invalid_argument("set operation output range is too small for the worst case result");
+    }
+
+    /**
+     * Merge path: finds how many elements of both ranges are among the first diagonal elements of their merge.
+     * Equal elements of both ranges are never split, so set operations can process both parts independently
+     */
+    template<class T>
+    std::pair<size_t, size_t> merge_path_split(const T* first, const size_t size1, const T* second,
+                                               const size_t size2, const size_t diagonal)
+    {
+        assert(diagonal <= size1 + size2);
+
+        size_t low = diagonal > size2 ? diagonal - size2 : 0;
+        size_t high = std::min(diagonal, size1);
+
+        while (low < high)
+        {
+            const size_t mid = low + (high - low) / 2;
+            if (!(second[diagonal - mid - 1] < first[mid]))
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        size_t i = low, j = diagonal - low;
+        if (i > 0 && j < size2 && first[i - 1] == second[j])
+            j++;
+
+        return { i, j };
+    }
+
+    namespace concurrent
+    {
+        static constexpr size_t min_size_for_set_threading = 1 << 16;
+
+        /**
+         * Operation's results of the right part are written after the worst case size of the left part results
+         * and then moved next to them. The threads budget is shared like by concurrent sorts
+         */
+        template<class T, class Operation, class ResultBound>
+        size_t set_operation(const T* first, const size_t size1, const T* second, const size_t size2, T* result,
+                             Operation operation, ResultBound result_bound, const size_t threads)
+        {
+            if (threads <= 1 || size1 + size2 <= min_size_for_set_threading)
+                return operation(first, size1, second, size2, result);
+
+            const auto split = merge_path_split(first, size1, second, size2, (size1 + size2) / 2);
+            const size_t left_bound = result_bound(split.first, split.second);
+
+            // This thread processes left parts, a new thread processes right parts
+            auto right_future = std::async(std::launch::async,
+                                           [=]
+                                           {
+                                               return concurrent::set_operation(
+                                                       first + split.first, size1 - split.first,
+                                                       second + split.second, size2 - split.second,
+                                                       result + left_bound, operation, result_bound, threads / 2);
+                                           });
+            const size_t left_size = concurrent::set_operation(first, split.first, second, split.second, result,
+                                                               operation, result_bound, threads - threads / 2);
+
+            // Waiting for the right parts to be processed
+            const size_t right_size = right_future.get();
+
+            std::copy(result + left_bound, result + left_bound + right_size, result + left_size);
+            return left_size + right_size;
+        }
+
+        template<class T>
+        size_t sort_unique(T* range, const size_t size, T* buffer, const size_t threads)
+        {
+            if (threads <= 1 || size <= min_size_for_threading)
+                return local::sort_unique(range, size, buffer);
+
+            const size_t mid = size / 2;
+            // This thread sorts the left part, a new thread sorts the right part
+            auto right_future = std::async(std::launch::async, concurrent::sort_unique<T>, range + mid, size - mid,
+                                           buffer + mid, threads / 2);
+            const size_t size1 = concurrent::sort_unique(range, mid, buffer, threads - threads / 2);
+            const size_t size2 = right_future.get();
+
+            // Merging unique parts is their union
+            const size_t merged_size = set_operation(range, size1, range + mid, size2, buffer, merge_unique<T>,
+                                                     union_size_bound, threads);
+            std::copy(buffer, buffer + merged_size, range);
+            return merged_size;
+        }
+
+        /** Like set_operation for merge_count, the counts are split and moved along with their keys */
+        template<class T>
+        size_t merge_count(const T* keys1, const size_t* counts1, const size_t size1, const T* keys2,
+                           const size_t* counts2, const size_t size2, T* result_keys, size_t* result_counts,
+                           const size_t threads)
+        {
+            if (threads <= 1 || size1 + size2 <= min_size_for_set_threading)
+                return local::merge_count(keys1, counts1, size1, keys2, counts2, size2, result_keys, result_counts);
+
+            const auto split = merge_path_split(keys1, size1, keys2, size2, (size1 + size2) / 2);
+            const size_t i = split.first, j = split.second, left_bound = i + j;
+
+            // This thread merges left parts, a new thread merges right parts
+            auto right_future = std::async(std::launch::async,
+                                           [=]
+                                           {
+                                               return concurrent::merge_count(
+                                                       keys1 + i, counts1 + i, size1 - i, keys2 + j, counts2 + j,
+                                                       size2 - j, result_keys + left_bound,
+                                                       result_counts + left_bound, threads / 2);
+                                           });
+            const size_t left_size = concurrent::merge_count(keys1, counts1, i, keys2, counts2, j, result_keys,
+                                                             result_counts, threads - threads / 2);
+
+            // Waiting for the right parts to be merged
+            const size_t right_size = right_future.get();
+
+            std::copy(result_keys + left_bound, result_keys + left_bound + right_size, result_keys + left_size);
+            std::copy(result_counts + left_bound, result_counts + left_bound + right_size, result_counts + left_size);
+            return left_size + right_size;
+        }
+
+        template<class T>
+        size_t sort_count_by_key(T* keys, size_t* counts, const size_t size, T* key_buffer, size_t* count_buffer,
+                                 const size_t threads)
+        {
+            if (threads <= 1 || size <= min_size_for_threading)
+                return local::sort_count_by_key(keys, counts, size, key_buffer, count_buffer);
+
+            const size_t mid = size / 2;
+            // This thread sorts the left part, a new thread sorts the right part
+            auto right_future = std::async(std::launch::async, concurrent::sort_count_by_key<T>, keys + mid,
+                                           counts + mid, size - mid, key_buffer + mid, count_buffer + mid,
+                                           threads / 2);
+            const size_t size1 =
+                    concurrent::sort_count_by_key(keys, counts, mid, key_buffer, count_buffer, threads - threads / 2);
+            const size_t size2 = right_future.get();
+
+            const size_t merged_size = concurrent::merge_count(keys, counts, size1, keys + mid, counts + mid, size2,
+                                                               key_buffer, count_buffer, threads);
+            std::copy(key_buffer, key_buffer + merged_size, keys);
+            std::copy(count_buffer, count_buffer + merged_size, counts);
+            return merged_size;
+        }
+    } // namespace concurrent
+} // namespace local
+
+
+template<ContiguousSortableRange RangeType>
+size_t sort_unique(RangeType&& range, std::pmr::memory_resource* scratch)
+{
+    const local::scratch_buffer<std::ranges::range_value_t<RangeType>> buffer(range.size(), scratch);
+    return local::sort_unique(range.data(), range.size(), buffer.data());
+}
+
+template<ContiguousSortableRange RangeType>
+std::vector<std::pair<std::ranges::range_value_t<RangeType>, size_t>> sort_count_by_key(RangeType&& range,
+                                                                                       std::pmr::memory_resource* scratch)
+{
+    using T = std::ranges::range_value_t<RangeType>;
+
+    const local::scratch_buffer<size_t> counts(range.size(), scratch), count_buffer(range.size(), scratch);
+    const local::scratch_buffer<T> key_buffer(range.size(), scratch);
+    const size_t unique_size =
+            local::sort_count_by_key(range.data(), counts.data(), range.size(), key_buffer.data(), count_buffer.data());
+
+    return local::make_key_counts(range.data(), counts.data(), unique_size);
+}
+
+template<ContiguousSortableRange FirstRange, ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+         ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+size_t set_intersection(const FirstRange& first, const SecondRange& second, OutputRange&& out)
+{
+    local::check_set_output(out, local::intersection_size_bound(first.size(), second.size()));
+    return local::set_intersection(first.data(), first.size(), second.data(), second.size(), out.data());
+}
+
+template<ContiguousSortableRange FirstRange, ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+         ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+size_t set_union(const FirstRange& first, const SecondRange& second, OutputRange&& out)
+{
+    local::check_set_output(out, local::union_size_bound(first.size(), second.size()));
+    return local::set_union(first.data(), first.size(), second.data(), second.size(), out.data());
+}
+
+template<ContiguousSortableRange FirstRange, ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+         ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+size_t set_difference(const FirstRange& first, const SecondRange& second, OutputRange&& out)
+{
+    local::check_set_output(out, local::difference_size_bound(first.size(), second.size()));
+    return local::set_difference(first.data(), first.size(), second.data(), second.size(), out.data());
+}
+
+namespace concurrent
+{
+    template<ContiguousSortableRange RangeType>
+    size_t sort_unique(RangeType&& range, std::pmr::memory_resource* scratch, const size_t threads)
+    {
+        local::concurrent::check_threads(threads);
+
+        const local::scratch_buffer<std::ranges::range_value_t<RangeType>> buffer(range.size(), scratch);
+        return local::concurrent::sort_unique(range.data(), range.size(), buffer.data(), threads);
+    }
+
+    template<ContiguousSortableRange RangeType>
+    std::vector<std::pair<std::ranges::range_value_t<RangeType>, size_t>>
+    sort_count_by_key(RangeType&& range, std::pmr::memory_resource* scratch, const size_t threads)
+    {
+        using T = std::ranges::range_value_t<RangeType>;
+
+        local::concurrent::check_threads(threads);
+
+        const local::scratch_buffer<size_t> counts(range.size(), scratch), count_buffer(range.size(), scratch);
+        const local::scratch_buffer<T> key_buffer(range.size(), scratch);
+        const size_t unique_size = local::concurrent::sort_count_by_key(
+                range.data(), counts.data(), range.size(), key_buffer.data(), count_buffer.data(), threads);
+
+        return local::make_key_counts(range.data(), counts.data(), unique_size);
+    }
+
+    template<ContiguousSortableRange FirstRange,
+             ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+             ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+    size_t set_intersection(const FirstRange& first, const SecondRange& second, OutputRange&& out, const size_t threads)
+    {
+        using T = std::ranges::range_value_t<FirstRange>;
+
+        local::concurrent::check_threads(threads);
+        local::check_set_output(out, local::intersection_size_bound(first.size(), second.size()));
+        return local::concurrent::set_operation(first.data(), first.size(), second.data(), second.size(), out.data(),
+                                                local::set_intersection<T>, local::intersection_size_bound, threads);
+    }
+
+    template<ContiguousSortableRange FirstRange,
+             ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+             ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+    size_t set_union(const FirstRange& first, const SecondRange& second, OutputRange&& out, const size_t threads)
+    {
+        using T = std::ranges::range_value_t<FirstRange>;
+
+        local::concurrent::check_threads(threads);
+        local::check_set_output(out, local::union_size_bound(first.size(), second.size()));
+        return local::concurrent::set_operation(first.data(), first.size(), second.data(), second.size(), out.data(),
+                                                local::set_union<T>, local::union_size_bound, threads);
+    }
+
+    template<ContiguousSortableRange FirstRange,
+             ContiguousQueryRange<std::ranges::range_value_t<FirstRange>> SecondRange,
+             ContiguousOutputRange<std::ranges::range_value_t<FirstRange>> OutputRange>
+    size_t set_difference(const FirstRange& first, const SecondRange& second, OutputRange&& out, const size_t threads)
+    {
+        using T = std::ranges::range_value_t<FirstRange>;
+
+        local::concurrent::check_threads(threads);
+        local::check_set_output(out, local::difference_size_bound(first.size(), second.size()));
+        return local::concurrent::set_operation(first.data(), first.size(), second.data(), second.size(), out.data(),
+                                                local::set_difference<T>, local::difference_size_bound, threads);
+    }
+} // namespace concurrent
+} // namespace algo
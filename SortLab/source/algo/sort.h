@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <memory_resource>
 #include <ranges>
 
 namespace algo
@@ -40,16 +41,31 @@ void boost_spin_sort(RangeType&& range);
 template<ContiguousSortableRange RangeType>
 void quick_sort(RangeType&& range);
 
+/**
+ * Merge sorts allocate one scratch buffer of the range size from the scratch resource per call.
+ * The buffer is allocated by the calling thread only, so concurrent sorts can use a thread-local resource
+ * (e.g. thread_local_scratch_arena() from scratch_arena.h)
+ */
 template<ContiguousSortableRange RangeType>
-void merge_sort(RangeType&& range);
+void merge_sort(RangeType&& range, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
 
 namespace concurrent
 {
+    /** All hardware threads, at least one */
+    inline size_t default_threads();
+
+    /**
+     * Concurrent merge sorts use at most threads threads at the same time, including the calling one.
+     * Throws std::invalid_argument if threads is zero
+     */
     template<ContiguousSortableRange RangeType>
-    void merge_sort(RangeType&& range);
+    void merge_sort(RangeType&& range, std::pmr::memory_resource* scratch = std::pmr::get_default_resource(),
+                    size_t threads = default_threads());
 
     template<ContiguousSortableRange RangeType>
-    void merge_sort_advanced(RangeType&& range);
+    void merge_sort_advanced(RangeType&& range,
+                             std::pmr::memory_resource* scratch = std::pmr::get_default_resource(),
+                             size_t threads = default_threads());
 } // namespace concurrent
 } // namespace algo
 
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "merge.inl"
+
 #include <algorithm>
 #include <boost/sort/spinsort/spinsort.hpp>
 #include <boost/sort/spreadsort/spreadsort.hpp>
 #include <cassert>
 #include <future>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 namespace algo
@@ -117,57 +123,72 @@ namespace local
         quick_sort(range + pivot + 1, size - pivot - 1);
     }
 
+    /**
+     * Scratch memory for merge sorts taken from a memory resource.
+     * Trivial types are left uninitialized, the buffer is always overwritten by merges before reading
+     */
     template<class T>
-    void merge(T* range, const size_t left1, const size_t right1, const size_t left2, const size_t right2,
-               std::vector<T>& merge_result, const size_t padding)
+    class scratch_buffer final
     {
-        assert(left1 <= right1);
-        assert(left2 <= right2);
-
-        const size_t size1 = right1 - left1, size2 = right2 - left2;
-        size_t i = 0, j = 0;
-
-        while (i < size1 && j < size2)
+    public:
+        scratch_buffer(const size_t size, std::pmr::memory_resource* resource) : _allocator(resource), _size(size)
         {
-            if (range[left1 + i] < range[left2 + j])
+            _data = _allocator.allocate(size);
+            try
             {
-                merge_result[padding + i + j] = range[left1 + i];
-                i++;
+                std::uninitialized_default_construct_n(_data, size);
             }
-            else
+            catch (...)
             {
-                merge_result[padding + i + j] = range[left2 + j];
-                j++;
+                _allocator.deallocate(_data, size);
+                throw;
             }
         }
 
-        while (i < size1)
+        scratch_buffer(const scratch_buffer& other) = delete;
+        scratch_buffer& operator=(const scratch_buffer& other) = delete;
+
+        ~scratch_buffer()
         {
-            merge_result[padding + i + j] = range[left1 + i];
-            i++;
+            std::destroy_n(_data, _size);
+            _allocator.deallocate(_data, _size);
         }
 
-        while (j < size2)
+        T* data() const
         {
-            merge_result[padding + i + j] = range[left2 + j];
-            j++;
+            return _data;
         }
+
+    private:
+        std::pmr::polymorphic_allocator<T> _allocator;
+        T* _data;
+        size_t _size;
+    };
+
+    template<class T>
+    void merge(T* range, const size_t left1, const size_t right1, const size_t left2, const size_t right2,
+               T* merge_result, const size_t padding)
+    {
+        assert(left1 <= right1);
+        assert(left2 <= right2);
+
+        merge_into(range + left1, right1 - left1, range + left2, right2 - left2, merge_result + padding);
     }
 
+    /** The buffer has the same size as the range, both halves are sorted using their own parts of the buffer */
     template<class T>
-    void merge_sort(T* range, const size_t size)
+    void merge_sort(T* range, const size_t size, T* buffer)
     {
         if (size <= 1)
             return;
 
         const size_t mid = size / 2;
-        merge_sort(range, mid);
-        merge_sort(range + mid, size - mid);
+        merge_sort(range, mid, buffer);
+        merge_sort(range + mid, size - mid, buffer + mid);
 
         // Merging left [0, mid) and right [mid, size) parts and then copying it to the initial range
-        std::vector<T> merge_result(size);
-        merge(range, 0, mid, mid, size, merge_result, 0);
-        std::copy(merge_result.begin(), merge_result.end(), range);
+        merge(range, 0, mid, mid, size, buffer, 0);
+        std::copy(buffer, buffer + size, range);
     }
 
     namespace concurrent
@@ -175,10 +196,15 @@ namespace local
         static constexpr size_t min_size_for_threading = 1000;
 
 
+        /**
+         * Concurrent algorithms split the range in halves recursively: a new thread processes the right half
+         * with the half of the threads budget and this thread processes the left half with the rest of it,
+         * so at most threads threads work at the same time
+         */
         template<class T>
-        void copy(T* range, const size_t size, T* result)
+        void copy(T* range, const size_t size, T* result, const size_t threads)
         {
-            if (size <= min_size_for_threading)
+            if (threads <= 1 || size <= min_size_for_threading)
             {
                 std::copy(range, range + size, result);
                 return;
@@ -187,43 +213,44 @@ namespace local
             const size_t mid = size / 2;
 
             // This thread copies the left part, a new thread copies the right part
-            auto right_future = std::async(std::launch::async, copy<T>, range + mid, size - mid, result + mid);
-            copy(range, mid, result);
+            auto right_future =
+                    std::async(std::launch::async, copy<T>, range + mid, size - mid, result + mid, threads / 2);
+            copy(range, mid, result, threads - threads / 2);
 
             // Waiting for the right part to be copied
             right_future.get();
         }
 
         template<class T>
-        void merge_sort(T* range, const size_t size)
+        void merge_sort(T* range, const size_t size, T* buffer, const size_t threads)
         {
             if (size <= 1)
                 return;
 
-            if (size <= min_size_for_threading)
+            if (threads <= 1 || size <= min_size_for_threading)
             {
-                local::merge_sort(range, size);
+                local::merge_sort(range, size, buffer);
                 return;
             }
 
             const size_t mid = size / 2;
             // This thread sorts the left part, a new thread sorts the right part
-            auto right_future = std::async(std::launch::async, concurrent::merge_sort<T>, range + mid, size - mid);
-            concurrent::merge_sort(range, mid);
+            auto right_future = std::async(std::launch::async, concurrent::merge_sort<T>, range + mid, size - mid,
+                                           buffer + mid, threads / 2);
+            concurrent::merge_sort(range, mid, buffer, threads - threads / 2);
 
             // Waiting for the right part to be sorted
             right_future.get();
 
             // One threaded merging of left [0, mid) and right [mid, size) parts
             // and then copying it to the initial range
-            std::vector<T> merge_result(size);
-            local::merge(range, 0, mid, mid, size, merge_result, 0);
-            std::copy(merge_result.begin(), merge_result.end(), range);
+            local::merge(range, 0, mid, mid, size, buffer, 0);
+            std::copy(buffer, buffer + size, range);
         }
 
         template<class T>
-        void merge_advanced(T* range, size_t left1, size_t right1, size_t left2, size_t right2,
-                            std::vector<T>& merge_result, const size_t padding)
+        void merge_advanced(T* range, size_t left1, size_t right1, size_t left2, size_t right2, T* merge_result,
+                            const size_t padding, const size_t threads)
         {
             if (left1 >= right1 && left2 >= right2)
                 return;
@@ -233,7 +260,7 @@ namespace local
 
             const size_t size1 = right1 - left1, size2 = right2 - left2;
 
-            if (size1 + size2 <= min_size_for_threading)
+            if (threads <= 1 || size1 + size2 <= min_size_for_threading)
             {
                 local::merge(range, left1, right1, left2, right2, merge_result, padding);
                 return;
@@ -255,39 +282,44 @@ namespace local
             // This thread merges left parts from the first and the second ranges,
             // a new thread merges right parts from the first and the second ranges
             auto right_future = std::async(std::launch::async, concurrent::merge_advanced<T>, range, mid1 + 1, right1,
-                                           mid2, right2, std::ref(merge_result), median1_index + 1);
-            concurrent::merge_advanced(range, left1, mid1, left2, mid2, merge_result, padding);
+                                           mid2, right2, merge_result, median1_index + 1, threads / 2);
+            concurrent::merge_advanced(range, left1, mid1, left2, mid2, merge_result, padding, threads - threads / 2);
 
             // Waiting for the right parts to be merged
             right_future.get();
         }
 
         template<class T>
-        void merge_sort_advanced(T* range, const size_t size)
+        void merge_sort_advanced(T* range, const size_t size, T* buffer, const size_t threads)
         {
             if (size <= 1)
                 return;
 
-            if (size <= min_size_for_threading)
+            if (threads <= 1 || size <= min_size_for_threading)
             {
-                local::merge_sort(range, size);
+                local::merge_sort(range, size, buffer);
                 return;
             }
 
             const size_t mid = size / 2;
             // This thread sorts the left part, a new thread sorts the right part
-            auto right_future =
-                    std::async(std::launch::async, concurrent::merge_sort_advanced<T>, range + mid, size - mid);
-            concurrent::merge_sort_advanced(range, mid);
+            auto right_future = std::async(std::launch::async, concurrent::merge_sort_advanced<T>, range + mid,
+                                           size - mid, buffer + mid, threads / 2);
+            concurrent::merge_sort_advanced(range, mid, buffer, threads - threads / 2);
 
             // Waiting for the right part to be sorted
             right_future.get();
 
             // Multithreaded merging of left [0, mid) and right [mid, size) parts
             // and then copying it to the initial range
-            std::vector<T> merge_result(size);
-            concurrent::merge_advanced(range, 0, mid, mid, size, merge_result, 0);
-            concurrent::copy(merge_result.data(), merge_result.size(), range);
+            concurrent::merge_advanced(range, 0, mid, mid, size, buffer, 0, threads);
+            concurrent::copy(buffer, size, range, threads);
+        }
+
+        inline void check_threads(const size_t threads)
+        {
+            if (threads == 0)
+                throw std::invalid_argument("Concurrent algorithms need at least one thread");
         }
     } // namespace concurrent
 } // namespace local
@@ -335,23 +367,35 @@ void quick_sort(RangeType&& range)
 }
 
 template<ContiguousSortableRange RangeType>
-void merge_sort(RangeType&& range)
+void merge_sort(RangeType&& range, std::pmr::memory_resource* scratch)
 {
-    local::merge_sort(range.data(), range.size());
+    const local::scratch_buffer<std::ranges::range_value_t<RangeType>> buffer(range.size(), scratch);
+    local::merge_sort(range.data(), range.size(), buffer.data());
 }
 
 namespace concurrent
 {
+    inline size_t default_threads()
+    {
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
     template<ContiguousSortableRange RangeType>
-    void merge_sort(RangeType&& range)
+    void merge_sort(RangeType&& range, std::pmr::memory_resource* scratch, const size_t threads)
     {
-        local::concurrent::merge_sort(range.data(), range.size());
+        local::concurrent::check_threads(threads);
+
+        const local::scratch_buffer<std::ranges::range_value_t<RangeType>> buffer(range.size(), scratch);
+        local::concurrent::merge_sort(range.data(), range.size(), buffer.data(), threads);
     }
 
     template<ContiguousSortableRange RangeType>
-    void merge_sort_advanced(RangeType&& range)
+    void merge_sort_advanced(RangeType&& range, std::pmr::memory_resource* scratch, const size_t threads)
     {
-        local::concurrent::merge_sort_advanced(range.data(), range.size());
+        local::concurrent::check_threads(threads);
+
+        const local::scratch_buffer<std::ranges::range_value_t<RangeType>> buffer(range.size(), scratch);
+        local::concurrent::merge_sort_advanced(range.data(), range.size(), buffer.data(), threads);
     }
 } // namespace concurrent
 } // namespace algo
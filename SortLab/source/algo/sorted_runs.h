@@ -0,0 +1,126 @@
+#pragma once
+
+#include "sort.h"
+
+#include <iterator>
+#include <memory_resource>
+#include <ranges>
+#include <vector>
+
+namespace algo
+{
+/**
+ * Sorted multiset for steady streams of inserts (LSM-style).
+ * New elements are collected in a buffer, every full buffer is sorted and becomes a sorted run.
+ * Runs are merged lazily: new runs are only appended, and they are merged like digits of a binary counter
+ * before queries or when more than max_unmerged_runs runs are waiting. So inserts without queries do not
+ * merge on every flush, queries see O(log n) runs, and every element is merged O(log n) times.
+ * Queries flush pending inserts and merge waiting runs even of a const multiset, so they must not run
+ * concurrently with each other either. The buffer, the runs and scratch buffers of the sorts are allocated from
+ * the memory resource
+ */
+template<Sortable T>
+class sorted_runs final
+{
+public:
+    class const_iterator;
+
+    static constexpr size_t default_buffer_capacity = 4096;
+
+    /** Runs appended since the last merge, one more triggers the merge */
+    static constexpr size_t max_unmerged_runs = 8;
+
+    explicit sorted_runs(const size_t buffer_capacity = default_buffer_capacity,
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    void insert(const T& value);
+    void insert(T&& value);
+
+    /** Inserts a whole batch at once, large batches become sorted runs without passing through the buffer */
+    template<std::ranges::input_range RangeType>
+        requires std::convertible_to<std::ranges::range_reference_t<RangeType>, T>
+    void insert_batch(RangeType&& values);
+
+    /** Sorts pending inserts into a new run */
+    void flush();
+
+    /** Merges all runs into one, queries on a single run are the fastest */
+    void compact();
+
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] size_t runs_count() const;
+
+    /** Iterator to the first element which is not less than value, iteration goes across all runs */
+    const_iterator lower_bound(const T& value) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    size_t _buffer_capacity;
+    std::pmr::memory_resource* _resource;
+
+    // Queries reorganize the storage without changing the contents
+    mutable std::pmr::vector<T> _buffer;
+
+    /**
+     * Sorted runs, the first _merged_runs ones from the oldest (largest) to the newest (smallest),
+     * then the appended ones which are not merged yet
+     */
+    mutable std::vector<std::pmr::vector<T>> _runs;
+    mutable size_t _merged_runs = 0;
+
+    size_t _size = 0;
+
+    /** Flushes pending inserts and merges waiting runs */
+    void prepare_queries() const;
+
+    void flush_buffer() const;
+    void push_run(std::pmr::vector<T>&& run) const;
+    void merge_runs() const;
+    void merge_last_runs() const;
+};
+
+/** Forward iterator which merges runs on the fly by picking the smallest current element among runs */
+template<Sortable T>
+class sorted_runs<T>::const_iterator
+{
+public:
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    const_iterator() = default;
+
+    const T& operator*() const;
+    const T* operator->() const;
+
+    const_iterator& operator++();
+    const_iterator operator++(int);
+
+    bool operator==(const const_iterator& other) const;
+
+private:
+    friend class sorted_runs;
+
+    /** Current and end positions of every run which is not exhausted yet */
+    struct cursor
+    {
+        const T* current;
+        const T* end;
+    };
+    std::vector<cursor> _cursors;
+
+    /** Index of the cursor with the smallest current element */
+    size_t _smallest = 0;
+
+    explicit const_iterator(std::vector<cursor>&& cursors);
+
+    void find_smallest();
+};
+} // namespace algo
+
+#include "sorted_runs.inl"
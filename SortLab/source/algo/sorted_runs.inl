@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace algo
+{
+template<Sortable T>
+sorted_runs<T>::sorted_runs(const size_t buffer_capacity, std::pmr::memory_resource* resource)
+    : _buffer_capacity(buffer_capacity), _resource(resource), _buffer(resource)
+{
+    if (buffer_capacity == 0)
+        throw std::invalid_argument("Buffer capacity must be positive");
+
+    _buffer.reserve(buffer_capacity);
+}
+
+template<Sortable T>
+void sorted_runs<T>::insert(const T& value)
+{
+    _buffer.push_back(value);
+    _size++;
+
+    if (_buffer.size() == _buffer_capacity)
+        flush();
+}
+
+template<Sortable T>
+void sorted_runs<T>::insert(T&& value)
+{
+    _buffer.push_back(std::move(value));
+    _size++;
+
+    if (_buffer.size() == _buffer_capacity)
+        flush();
+}
+
+template<Sortable T>
+template<std::ranges::input_range RangeType>
+    requires std::convertible_to<std::ranges::range_reference_t<RangeType>, T>
+void sorted_runs<T>::insert_batch(RangeType&& values)
+{
+    if constexpr (std::ranges::sized_range<RangeType>)
+    {
+        if (std::ranges::size(values) >= _buffer_capacity)
+        {
+            std::pmr::vector<T> run(std::ranges::begin(values), std::ranges::end(values), _resource);
+            _size += run.size();
+            merge_sort(run, _resource);
+            push_run(std::move(run));
+            return;
+        }
+    }
+
+    for (auto&& value: values)
+        insert(static_cast<T>(std::forward<decltype(value)>(value)));
+}
+
+template<Sortable T>
+void sorted_runs<T>::flush()
+{
+    flush_buffer();
+}
+
+template<Sortable T>
+void sorted_runs<T>::flush_buffer() const
+{
+    if (_buffer.empty())
+        return;
+
+    std::pmr::vector<T> run(_resource);
+    run.reserve(_buffer_capacity);
+    std::swap(run, _buffer);
+
+    merge_sort(run, _resource);
+    push_run(std::move(run));
+}
+
+template<Sortable T>
+void sorted_runs<T>::compact()
+{
+    prepare_queries();
+    while (_runs.size() > 1)
+        merge_last_runs();
+    _merged_runs = _runs.size();
+}
+
+template<Sortable T>
+void sorted_runs<T>::clear()
+{
+    _buffer.clear();
+    _runs.clear();
+    _merged_runs = 0;
+    _size = 0;
+}
+
+template<Sortable T>
+size_t sorted_runs<T>::size() const
+{
+    return _size;
+}
+
+template<Sortable T>
+bool sorted_runs<T>::empty() const
+{
+    return _size == 0;
+}
+
+template<Sortable T>
+size_t sorted_runs<T>::runs_count() const
+{
+    return _runs.size();
+}
+
+template<Sortable T>
+typename sorted_runs<T>::const_iterator sorted_runs<T>::lower_bound(const T& value) const
+{
+    prepare_queries();
+
+    std::vector<typename const_iterator::cursor> cursors;
+    cursors.reserve(_runs.size());
+    for (const auto& run: _runs)
+    {
+        const auto position = std::lower_bound(run.begin(), run.end(), value);
+        if (position != run.end())
+            cursors.push_back({ std::to_address(position), run.data() + run.size() });
+    }
+
+    return const_iterator(std::move(cursors));
+}
+
+template<Sortable T>
+typename sorted_runs<T>::const_iterator sorted_runs<T>::begin() const
+{
+    prepare_queries();
+
+    std::vector<typename const_iterator::cursor> cursors;
+    cursors.reserve(_runs.size());
+    for (const auto& run: _runs)
+        cursors.push_back({ run.data(), run.data() + run.size() });
+
+    return const_iterator(std::move(cursors));
+}
+
+template<Sortable T>
+typename sorted_runs<T>::const_iterator sorted_runs<T>::end() const
+{
+    return const_iterator();
+}
+
+template<Sortable T>
+void sorted_runs<T>::prepare_queries() const
+{
+    flush_buffer();
+    merge_runs();
+}
+
+template<Sortable T>
+void sorted_runs<T>::push_run(std::pmr::vector<T>&& run) const
+{
+    if (run.empty())
+        return;
+
+    _runs.push_back(std::move(run));
+    if (_runs.size() - _merged_runs > max_unmerged_runs)
+        merge_runs();
+}
+
+template<Sortable T>
+void sorted_runs<T>::merge_runs() const
+{
+    if (_merged_runs == _runs.size())
+        return;
+
+    std::vector<std::pmr::vector<T>> waiting_runs(std::make_move_iterator(_runs.begin() + static_cast<std::ptrdiff_t>(_merged_runs)),
+                                                  std::make_move_iterator(_runs.end()));
+    _runs.erase(_runs.begin() + static_cast<std::ptrdiff_t>(_merged_runs), _runs.end());
+
+    // Binary counter: every waiting run is merged while it is not smaller than the previous one,
+    // so run sizes decrease at least geometrically from the oldest run to the newest one
+    for (auto& run: waiting_runs)
+    {
+        _runs.push_back(std::move(run));
+        while (_runs.size() > 1 && _runs[_runs.size() - 2].size() <= _runs.back().size())
+            merge_last_runs();
+    }
+
+    _merged_runs = _runs.size();
+}
+
+template<Sortable T>
+void sorted_runs<T>::merge_last_runs() const
+{
+    assert(_runs.size() > 1);
+
+    auto second = std::move(_runs.back());
+    _runs.pop_back();
+    auto first = std::move(_runs.back());
+
+    std::pmr::vector<T> merged(first.size() + second.size(), _resource);
+    local::merge_into(first.data(), first.size(), second.data(), second.size(), merged.data());
+    _runs.back() = std::move(merged);
+}
+
+
+template<Sortable T>
+sorted_runs<T>::const_iterator::const_iterator(std::vector<cursor>&& cursors) : _cursors(std::move(cursors))
+{
+    // Empty runs are not stored, so every cursor points to an element
+    find_smallest();
+}
+
+template<Sortable T>
+const T& sorted_runs<T>::const_iterator::operator*() const
+{
+    assert(!_cursors.empty());
+    return *_cursors[_smallest].current;
+}
+
+template<Sortable T>
+const T* sorted_runs<T>::const_iterator::operator->() const
+{
+    assert(!_cursors.empty());
+    return _cursors[_smallest].current;
+}
+
+template<Sortable T>
+typename sorted_runs<T>::const_iterator& sorted_runs<T>::const_iterator::operator++()
+{
+    assert(!_cursors.empty());
+
+    if (++_cursors[_smallest].current == _cursors[_smallest].end)
+    {
+        _cursors[_smallest] = _cursors.back();
+        _cursors.pop_back();
+    }
+
+    find_smallest();
+    return *this;
+}
+
+template<Sortable T>
+typename sorted_runs<T>::const_iterator sorted_runs<T>::const_iterator::operator++(int)
+{
+    auto previous = *this;
+    ++*this;
+    return previous;
+}
+
+template<Sortable T>
+bool sorted_runs<T>::const_iterator::operator==(const const_iterator& other) const
+{
+    // Every element has its own address, so iterators are equal if they point to the same element
+    if (_cursors.empty() || other._cursors.empty())
+        return _cursors.empty() == other._cursors.empty();
+
+    return operator->() == other.operator->();
+}
+
+template<Sortable T>
+void sorted_runs<T>::const_iterator::find_smallest()
+{
+    // There are O(log n) runs, so the linear scan is cheaper than maintaining a heap
+    _smallest = 0;
+    for (size_t i = 1; i < _cursors.size(); ++i)
+    {
+        if (*_cursors[i].current < *_cursors[_smallest].current)
+            _smallest = i;
+    }
+}
+} // namespace algo
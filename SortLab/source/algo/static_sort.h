@@ -0,0 +1,38 @@
+#pragma once
+
+#include "sort.h"
+
+#include <array>
+#include <utility>
+
+namespace algo
+{
+/** Compare-exchange element of a sorting network: after it data[first] <= data[second] */
+struct comparator
+{
+    size_t first;
+    size_t second;
+};
+
+/**
+ * Batcher's odd-even merge sorting network for N elements, generated at compile time.
+ * It is optimal for N <= 8 and takes a few more comparators than the best known networks for larger N
+ */
+template<size_t N>
+constexpr auto make_sorting_network();
+
+template<size_t N>
+inline constexpr auto sorting_network = make_sorting_network<N>();
+
+/**
+ * Sorts exactly N elements with the sorting network unrolled at compile time, so there are no loops,
+ * and for arithmetic types no branches (compare-exchanges are selects). Usable in constant expressions
+ */
+template<size_t N, Sortable T>
+constexpr void static_sort(T* data);
+
+template<size_t N, Sortable T>
+constexpr void static_sort(std::array<T, N>& array);
+} // namespace algo
+
+#include "static_sort.inl"
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+
+namespace algo
+{
+namespace local
+{
+    /**
+     * Iterative Batcher's odd-even merge sort for the padded power of two size. Comparators which touch
+     * padding elements are dropped: padding elements are treated as +infinity, so such comparators do nothing.
+     * The callback is called for every comparator in the order of the network
+     */
+    template<class Callback>
+    constexpr void for_each_comparator(const size_t size, Callback callback)
+    {
+        const size_t padded_size = std::bit_ceil(size);
+
+        for (size_t p = 1; p < padded_size; p *= 2)
+        {
+            for (size_t k = p; k >= 1; k /= 2)
+            {
+                for (size_t j = k % p; j + k < padded_size; j += 2 * k)
+                {
+                    for (size_t i = 0; i < std::min(k, padded_size - j - k); ++i)
+                    {
+                        // Both elements must belong to the same merged block of size 2p
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < size)
+                            callback(comparator{ i + j, i + j + k });
+                    }
+                }
+            }
+        }
+    }
+
+    constexpr size_t sorting_network_size(const size_t size)
+    {
+        size_t count = 0;
+        for_each_comparator(size, [&count](comparator) { count++; });
+        return count;
+    }
+
+    template<size_t First, size_t Second, class T>
+    constexpr void compare_exchange([[maybe_unused]] T* data)
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            const T a = data[First], b = data[Second];
+            const bool swap = b < a;
+            data[First] = swap ? b : a;
+            data[Second] = swap ? a : b;
+        }
+        else if (data[Second] < data[First])
+            std::swap(data[First], data[Second]);
+    }
+
+    template<size_t N, class T, size_t... Is>
+    constexpr void apply_sorting_network([[maybe_unused]] T* data, std::index_sequence<Is...>)
+    {
+        (compare_exchange<sorting_network<N>[Is].first, sorting_network<N>[Is].second>(data), ...);
+    }
+} // namespace local
+
+template<size_t N>
+constexpr auto make_sorting_network()
+{
+    std::array<comparator, local::sorting_network_size(N)> network{};
+
+    size_t index = 0;
+    local::for_each_comparator(N, [&network, &index](const comparator next) { network[index++] = next; });
+
+    return network;
+}
+
+template<size_t N, Sortable T>
+constexpr void static_sort(T* data)
+{
+    local::apply_sorting_network<N>(data, std::make_index_sequence<sorting_network<N>.size()>{});
+}
+
+template<size_t N, Sortable T>
+constexpr void static_sort(std::array<T, N>& array)
+{
+    static_sort<N>(array.data());
+}
+} // namespace algo
@@ -1,25 +1,275 @@
+#include "algo/large_buffer.h"
 #include "algo/sort.h"
+#include "mapped_file.h"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <optional>
 #include <print>
-#include <random>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
 
-int main()
+namespace
 {
-    std::vector<int> nums{ 5, 4, 3, 2, 1 };
+constexpr std::array algorithms{ "quick", "merge", "stl", "spin", "spread" };
+constexpr std::array types{ "int32", "int64", "float", "double" };
 
-    // static constexpr size_t size = 100;
-    // nums.resize(size);
-    //
-    // static constexpr unsigned int seed = 31;
-    // std::mt19937 generator(seed);
-    // std::uniform_int_distribution distrib(0, 100);
-    //
-    // for (size_t i = 0; i < size; ++i)
-    //     nums[i] = distrib(generator);
+struct options
+{
+    std::string_view path;
+    std::string_view algorithm = "merge";
+    std::string_view type = "int32";
+    size_t threads = algo::concurrent::default_threads();
+};
+
+void print_usage()
+{
+    std::println(stderr, "Usage: SortLab_Main <file> [--algo quick|merge|stl|spin|spread] [--threads N]"
+                         " [--type int32|int64|float|double]");
+    std::println(stderr, "Sorts a binary file of native-endian numbers in place");
+}
+
+bool is_one_of(const std::string_view value, const auto& allowed)
+{
+    return std::ranges::find(allowed, value) != allowed.end();
+}
+
+std::optional<options> parse_options(const int argc, char** argv)
+{
+    options result;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (!argument.starts_with("--"))
+        {
+            if (!result.path.empty())
+                return std::nullopt;
+
+            result.path = argument;
+            continue;
+        }
+
+        if (i + 1 == argc)
+            return std::nullopt;
+        const std::string_view value = argv[++i];
+
+        if (argument == "--algo" && is_one_of(value, algorithms))
+            result.algorithm = value;
+        else if (argument == "--type" && is_one_of(value, types))
+            result.type = value;
+        else if (argument == "--threads")
+        {
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result.threads);
+            if (error != std::errc() || end != value.data() + value.size() || result.threads == 0)
+                return std::nullopt;
+        }
+        else
+            return std::nullopt;
+    }
+
+    if (result.path.empty())
+        return std::nullopt;
+
+    return result;
+}
+
+/** Runs one phase of the tool and prints its wall time */
+template<typename Function>
+void run_phase(const std::string_view name, Function&& function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+
+    std::println("{:<6}{:>12.3f} ms", name, duration.count());
+}
+
+/** Chunk boundary for equal splitting of size elements into parts */
+size_t part_begin(const size_t size, const size_t parts, const size_t part)
+{
+    return size * part / parts;
+}
+
+/** Merge sort takes its scratch memory from the part of the scratch buffer which corresponds to the chunk */
+template<class T>
+void sort_chunk(const std::span<T> chunk, const std::span<T> scratch, const std::string_view algorithm)
+{
+    if (algorithm == "quick")
+        algo::quick_sort(chunk);
+    else if (algorithm == "merge")
+    {
+        std::pmr::monotonic_buffer_resource chunk_scratch(scratch.data(), scratch.size_bytes(),
+                                                          std::pmr::null_memory_resource());
+        algo::merge_sort(chunk, &chunk_scratch);
+    }
+    else if (algorithm == "stl")
+        algo::stl_sort(chunk);
+    else if (algorithm == "spin")
+        algo::boost_spin_sort(chunk);
+    else
+        algo::boost_spread_sort(chunk);
+}
+
+/** Number of elements of second which go before the part-th of parts of first in their merge */
+template<class T>
+size_t second_part_begin(const T* first, const size_t size1, const T* second, const size_t size2, const size_t parts,
+                         const size_t part)
+{
+    const size_t first_begin = part_begin(size1, parts, part);
+    if (part == 0)
+        return 0;
+    if (first_begin == size1)
+        return size2;
+
+    return static_cast<size_t>(std::lower_bound(second, second + size2, first[first_begin]) - second);
+}
+
+/**
+ * Merges neighbouring sorted runs of run_size elements from source to destination.
+ * Every pair of runs is split into several parts by binary search, so that all the threads are busy
+ * even in the last rounds with a few long runs
+ */
+template<class T>
+void merge_runs(const T* source, T* destination, const size_t size, const size_t run_size, const size_t threads)
+{
+    const size_t pairs = (size + 2 * run_size - 1) / (2 * run_size);
+    const size_t parts = std::max<size_t>(threads / pairs, 1);
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(pairs * parts);
+
+    for (size_t left = 0; left < size; left += 2 * run_size)
+    {
+        const size_t mid = std::min(left + run_size, size), right = std::min(left + 2 * run_size, size);
+        const T* first = source + left;
+        const T* second = source + mid;
+        const size_t size1 = mid - left, size2 = right - mid;
+
+        for (size_t part = 0; part < parts; ++part)
+        {
+            const size_t first_begin = part_begin(size1, parts, part);
+            const size_t first_end = part_begin(size1, parts, part + 1);
+            const size_t second_begin = second_part_begin(first, size1, second, size2, parts, part);
+            const size_t second_end = second_part_begin(first, size1, second, size2, parts, part + 1);
+
+            futures.push_back(std::async(std::launch::async, algo::local::merge_into<T>, first + first_begin,
+                                         first_end - first_begin, second + second_begin, second_end - second_begin,
+                                         destination + left + first_begin + second_begin));
+        }
+    }
+
+    for (auto& future: futures)
+        future.get();
+}
+
+/**
+ * The file is split into one chunk per thread, chunks are sorted in parallel and then merged in rounds
+ * between the file mapping and an anonymous scratch mapping. Data is never copied into std::vector
+ */
+template<class T>
+void sort_file(const sortlab::mapped_file& file, const options& options)
+{
+    if (file.size() % sizeof(T) != 0)
+        throw std::invalid_argument("File size is not a multiple of the key size");
+
+    const size_t size = file.size() / sizeof(T);
+    const std::span data(reinterpret_cast<T*>(file.data()), size);
+
+    // Chunks are sorted runs of the same size for the merge rounds, only the last one may be shorter
+    const size_t chunk_size = std::max<size_t>((size + options.threads - 1) / options.threads, 1);
+
+    // Mapping and touching all pages of the scratch mapping takes a noticeable part of the time for large files,
+    // they are touched by as many threads as sort the chunks
+    algo::huge_page_resource scratch_resource(options.threads);
+    std::optional<algo::large_buffer<T>> scratch_buffer;
+    run_phase("alloc", [&] { scratch_buffer.emplace(size, &scratch_resource); });
+    const std::span scratch(scratch_buffer->data(), size);
+
+    run_phase("sort",
+              [&]
+              {
+                  std::vector<std::future<void>> futures;
+                  futures.reserve(options.threads);
+
+                  for (size_t begin = 0; begin < size; begin += chunk_size)
+                  {
+                      const size_t length = std::min(chunk_size, size - begin);
+                      futures.push_back(std::async(std::launch::async, sort_chunk<T>, data.subspan(begin, length),
+                                                   scratch.subspan(begin, length), options.algorithm));
+                  }
+
+                  for (auto& future: futures)
+                      future.get();
+              });
+
+    run_phase("merge",
+              [&]
+              {
+                  T* source = data.data();
+                  T* destination = scratch.data();
+
+                  for (size_t run_size = chunk_size; run_size < size; run_size *= 2)
+                  {
+                      merge_runs(source, destination, size, run_size, options.threads);
+                      std::swap(source, destination);
+                  }
+
+                  // After an odd number of rounds the result is in the scratch mapping
+                  if (source != data.data())
+                  {
+                      std::vector<std::future<void>> futures;
+                      for (size_t part = 0; part < options.threads; ++part)
+                      {
+                          const size_t begin = part_begin(size, options.threads, part);
+                          const size_t end = part_begin(size, options.threads, part + 1);
+                          futures.push_back(std::async(
+                                  std::launch::async,
+                                  [=] { std::copy(source + begin, source + end, data.data() + begin); }));
+                      }
+
+                      for (auto& future: futures)
+                          future.get();
+                  }
+              });
+}
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    const auto options = parse_options(argc, argv);
+    if (!options)
+    {
+        print_usage();
+        return 1;
+    }
+
+    try
+    {
+        std::optional<sortlab::mapped_file> file;
+        run_phase("map", [&] { file.emplace(options->path); });
 
-    algo::concurrent::merge_sort_advanced(nums);
+        if (options->type == "int32")
+            sort_file<std::int32_t>(*file, *options);
+        else if (options->type == "int64")
+            sort_file<std::int64_t>(*file, *options);
+        else if (options->type == "float")
+            sort_file<float>(*file, *options);
+        else
+            sort_file<double>(*file, *options);
 
-    for (const int num : nums)
-        std::print("{} ", num);
-    std::println("");
+        run_phase("flush", [&] { file->flush(); });
+    }
+    catch (const std::exception& exception)
+    {
+        std::println(stderr, "Error: {}", exception.what());
+        return 1;
+    }
 }
@@ -0,0 +1,70 @@
+#include "mapped_file.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace sortlab
+{
+static std::system_error make_system_error(const std::string& what)
+{
+    return { errno, std::generic_category(), what };
+}
+
+mapped_file::mapped_file(const std::filesystem::path& path)
+{
+    _descriptor = open(path.c_str(), O_RDWR);
+    if (_descriptor < 0)
+        throw make_system_error("Cannot open " + path.string());
+
+    struct stat file_stat{};
+    if (fstat(_descriptor, &file_stat) != 0)
+    {
+        const auto error = make_system_error("Cannot get size of " + path.string());
+        close(_descriptor);
+        throw error;
+    }
+    _size = static_cast<size_t>(file_stat.st_size);
+
+    // Empty files cannot be mapped, there is nothing to sort in them anyway
+    if (_size == 0)
+        return;
+
+    void* mapped = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _descriptor, 0);
+    if (mapped == MAP_FAILED)
+    {
+        const auto error = make_system_error("Cannot map " + path.string());
+        close(_descriptor);
+        throw error;
+    }
+    _data = static_cast<std::byte*>(mapped);
+}
+
+mapped_file::~mapped_file()
+{
+    if (_data != nullptr)
+        munmap(_data, _size);
+
+    close(_descriptor);
+}
+
+std::byte* mapped_file::data() const
+{
+    return _data;
+}
+
+size_t mapped_file::size() const
+{
+    return _size;
+}
+
+void mapped_file::flush() const
+{
+    if (_data != nullptr && msync(_data, _size, MS_SYNC) != 0)
+        throw make_system_error("Cannot write the mapped file back");
+}
+} // namespace sortlab
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace sortlab
+{
+/** Whole file mapped into memory for reading and writing, changes are written back to the file by flush() */
+class mapped_file final
+{
+public:
+    explicit mapped_file(const std::filesystem::path& path);
+
+    mapped_file(const mapped_file& other) = delete;
+    mapped_file& operator=(const mapped_file& other) = delete;
+
+    mapped_file(mapped_file&& other) = delete;
+    mapped_file& operator=(mapped_file&& other) = delete;
+
+    ~mapped_file();
+
+    [[nodiscard]] std::byte* data() const;
+    [[nodiscard]] size_t size() const;
+
+    /** Synchronously writes changed pages to the file */
+    void flush() const;
+
+private:
+    int _descriptor = -1;
+    std::byte* _data = nullptr;
+    size_t _size = 0;
+};
+} // namespace sortlab
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "algo/counting_resource.h"
+#include "algo/sort.h"
+#include "utility.h"
+
+TEST(CountingResourceTest, CountsAllocations)
+{
+    algo::counting_resource resource;
+
+    void* first = resource.allocate(100, 8);
+    void* second = resource.allocate(50, 16);
+    resource.deallocate(first, 100, 8);
+
+    auto stats = resource.stats();
+    EXPECT_EQ(stats.allocations, 2);
+    EXPECT_EQ(stats.deallocations, 1);
+    EXPECT_EQ(stats.allocated_bytes, 150);
+    EXPECT_EQ(stats.bytes_in_use, 50);
+    EXPECT_EQ(stats.peak_bytes, 150);
+
+    // The high-water mark starts from bytes in use after reset
+    resource.reset();
+    stats = resource.stats();
+    EXPECT_EQ(stats.allocations, 0);
+    EXPECT_EQ(stats.allocated_bytes, 0);
+    EXPECT_EQ(stats.bytes_in_use, 50);
+    EXPECT_EQ(stats.peak_bytes, 50);
+
+    resource.deallocate(second, 50, 16);
+    EXPECT_EQ(resource.stats().bytes_in_use, 0);
+}
+
+TEST(CountingResourceTest, MeasuresMergeSorts)
+{
+    static constexpr size_t size = 10000;
+    algo::counting_resource resource;
+
+    // One scratch buffer of the range size per call
+    for (const auto sort: { +[](std::vector<int>& data, std::pmr::memory_resource* scratch)
+                            { algo::merge_sort(data, scratch); },
+                            +[](std::vector<int>& data, std::pmr::memory_resource* scratch)
+                            { algo::concurrent::merge_sort(data, scratch, 4); },
+                            +[](std::vector<int>& data, std::pmr::memory_resource* scratch)
+                            { algo::concurrent::merge_sort_advanced(data, scratch, 4); } })
+    {
+        resource.reset();
+        auto data = utility::tests::generate_random_data(size);
+        sort(data, &resource);
+
+        const auto stats = resource.stats();
+        EXPECT_EQ(stats.allocations, 1);
+        EXPECT_EQ(stats.deallocations, 1);
+        EXPECT_EQ(stats.peak_bytes, size * sizeof(int));
+        EXPECT_EQ(stats.bytes_in_use, 0);
+    }
+}
+
+TEST(CountingResourceTest, ConcurrentAllocations)
+{
+    static constexpr size_t threads_num = 4, allocations_num = 1000;
+    algo::counting_resource resource(std::pmr::new_delete_resource());
+
+    {
+        std::vector<std::jthread> threads;
+        for (size_t i = 0; i < threads_num; ++i)
+            threads.emplace_back(
+                    [&resource]
+                    {
+                        for (size_t j = 0; j < allocations_num; ++j)
+                            resource.deallocate(resource.allocate(64, 8), 64, 8);
+                    });
+    }
+
+    const auto stats = resource.stats();
+    EXPECT_EQ(stats.allocations, threads_num * allocations_num);
+    EXPECT_EQ(stats.deallocations, threads_num * allocations_num);
+    EXPECT_EQ(stats.bytes_in_use, 0);
+    EXPECT_GE(stats.peak_bytes, 64);
+    EXPECT_LE(stats.peak_bytes, threads_num * 64);
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+#include "algo/large_buffer.h"
+#include "algo/sort.h"
+#include "dataset_cache.h"
+#include "perf_counters.h"
+
+/** Large inputs are generated once and mapped from the on-disk dataset cache by later runs */
+static utility::tests::mapped_dataset<int> get_cached_input(const size_t size)
+{
+    static const utility::tests::dataset_cache cache;
+    return cache.get<int>("uniform", size, utility::tests::default_seed, utility::tests::generate_uniform<int>);
+}
+
+/**
+ * Benchmark template for comparing sorts of data and scratch memory in regular pages (std::vector and the default
+ * resource) with huge pages (large_buffer and huge_page_resource). Hardware counters (where permitted), dTLB misses
+ * among them, are collected only around the sorts and reported per element
+ */
+template<typename Container>
+static void BM_LargeSort(benchmark::State& state, void (*sort_function)(Container&, std::pmr::memory_resource*),
+                         std::pmr::memory_resource* scratch)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto input = get_cached_input(size);
+    const auto source = input.data();
+    Container data(size);
+    utility::tests::perf_counters counters;
+
+    for (auto _: state)
+    {
+        // Do not measure data restoring
+        state.PauseTiming();
+        std::ranges::copy(source, data.begin());
+        state.ResumeTiming();
+
+        counters.start();
+        sort_function(data, scratch);
+        counters.stop();
+
+        benchmark::DoNotOptimize(data.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+    counters.publish(state, static_cast<double>(size));
+}
+
+template<typename Container>
+static void quick_sort(Container& data, std::pmr::memory_resource*)
+{
+    algo::quick_sort(data);
+}
+
+template<typename Container>
+static void concurrent_merge_sort(Container& data, std::pmr::memory_resource* scratch)
+{
+    algo::concurrent::merge_sort(data, scratch);
+}
+
+
+/** A macros for measuring a sort with regular pages and huge pages */
+#define BENCHMARK_LARGE_SORT(sort_name, sort_function)                                                                 \
+    BENCHMARK_CAPTURE(BM_LargeSort, sort_name##_RegularPages, sort_function<std::vector<int>>,                        \
+                      std::pmr::get_default_resource())                                                                \
+            ->RangeMultiplier(10)                                                                                      \
+            ->Range(1e6, 1e8)                                                                                          \
+            ->UseRealTime()                                                                                            \
+            ->Unit(benchmark::kMillisecond);                                                                           \
+    BENCHMARK_CAPTURE(BM_LargeSort, sort_name##_HugePages, sort_function<algo::large_buffer<int>>,                    \
+                      &algo::default_huge_page_resource())                                                             \
+            ->RangeMultiplier(10)                                                                                      \
+            ->Range(1e6, 1e8)                                                                                          \
+            ->UseRealTime()                                                                                            \
+            ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_LARGE_SORT(QuickSort, quick_sort);
+BENCHMARK_LARGE_SORT(MultithreadedMergeSort, concurrent_merge_sort);
@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "algo/large_buffer.h"
+#include "algo/sort.h"
+#include "utility.h"
+
+TEST(HugePageResourceTest, AllocationsAreHugePageAligned)
+{
+    algo::huge_page_resource resource;
+
+    for (const size_t bytes: { size_t{ 0 }, size_t{ 1 }, algo::huge_page_size, 3 * algo::huge_page_size + 5 })
+    {
+        auto* data = static_cast<std::byte*>(resource.allocate(bytes, alignof(std::max_align_t)));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % algo::huge_page_size, 0);
+
+        // The whole allocation must be writable
+        std::fill_n(data, bytes, std::byte{ 42 });
+        resource.deallocate(data, bytes, alignof(std::max_align_t));
+    }
+}
+
+TEST(HugePageResourceTest, ParallelFirstTouchOfLargeAllocation)
+{
+    // Large enough to be touched by several threads, without touching in advance and with an odd budget
+    for (const size_t threads: { size_t{ 0 }, size_t{ 1 }, size_t{ 3 }, size_t{ 8 } })
+    {
+        algo::huge_page_resource resource(threads);
+
+        static constexpr size_t bytes = 100 * algo::huge_page_size + 123;
+        auto* data = static_cast<std::byte*>(resource.allocate(bytes, 1));
+        EXPECT_EQ(std::count(data, data + bytes, std::byte{ 0 }), bytes);
+        resource.deallocate(data, bytes, 1);
+    }
+}
+
+TEST(LargeBufferTest, Empty)
+{
+    const algo::large_buffer<int> buffer(0);
+    EXPECT_EQ(buffer.size(), 0);
+    EXPECT_EQ(buffer.begin(), buffer.end());
+}
+
+TEST(LargeBufferTest, SortsInPlaceWithHugePageScratch)
+{
+    const auto data = utility::tests::generate_random_data(1e5);
+
+    algo::large_buffer<int> buffer(data.size());
+    std::ranges::copy(data, buffer.begin());
+
+    algo::concurrent::merge_sort(buffer, &algo::default_huge_page_resource());
+    EXPECT_TRUE(std::ranges::is_sorted(buffer));
+
+    std::ranges::copy(data, buffer.begin());
+    algo::quick_sort(buffer);
+    EXPECT_TRUE(std::ranges::is_sorted(buffer));
+}
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+
+#include "algo/sort.h"
+
+/** Two sorted halves of random values of the requested type */
+template<typename T>
+static std::vector<T> generate_sorted_halves(const size_t size)
+{
+    static constexpr unsigned int seed = 31;
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution distrib(0, 1 << 30);
+
+    std::vector<T> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<T>(distrib(generator));
+
+    std::sort(data.begin(), data.begin() + static_cast<ptrdiff_t>(size / 2));
+    std::sort(data.begin() + static_cast<ptrdiff_t>(size / 2), data.end());
+    return data;
+}
+
+/** Benchmark template for measuring merge kernels, the throughput is reported in bytes of merged elements */
+template<typename T>
+static void BM_Merge(benchmark::State& state, void (*merge_function)(const T*, size_t, const T*, size_t, T*))
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto data = generate_sorted_halves<T>(size);
+    std::vector<T> result(size);
+
+    for (auto _: state)
+    {
+        merge_function(data.data(), size / 2, data.data() + size / 2, size - size / 2, result.data());
+
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * sizeof(T)));
+}
+
+
+/** A macros for measuring all the merge kernels for one type */
+#define BENCHMARK_MERGE(type_name, type)                                                                               \
+    BENCHMARK_CAPTURE(BM_Merge, Branchy_##type_name, algo::local::merge_branchy<type>)                           \
+            ->RangeMultiplier(10)                                                                                      \
+            ->Range(1e3, 1e7);                                                                                         \
+    BENCHMARK_CAPTURE(BM_Merge, Branchless_##type_name, algo::local::merge_branchless<type>)                     \
+            ->RangeMultiplier(10)                                                                                      \
+            ->Range(1e3, 1e7);                                                                                         \
+    BENCHMARK_CAPTURE(BM_Merge, Default_##type_name, algo::local::merge_into<type>)                              \
+            ->RangeMultiplier(10)                                                                                      \
+            ->Range(1e3, 1e7);
+
+
+/**
+ * Branchy is the original merge loop, Branchless is the scalar fallback
+ * and Default is the kernel used by the merge sorts (SIMD where available)
+ */
+BENCHMARK_MERGE(Int32, std::int32_t);
+BENCHMARK_MERGE(Int64, std::int64_t);
+BENCHMARK_MERGE(Float, float);
+BENCHMARK_MERGE(Double, double);
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "algo/sort.h"
+
+/** Typed fixture for the default merge kernel of every type with a dedicated implementation */
+template<typename T>
+class MergeKernelTest : public ::testing::Test
+{
+protected:
+    /** Sorted random values with many duplicates and negative numbers */
+    static std::vector<T> generate_sorted(const size_t size, const unsigned int seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution distrib(-50, 50);
+
+        std::vector<T> data(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+                data[i] = std::to_string(distrib(generator));
+            else
+                data[i] = static_cast<T>(distrib(generator));
+        }
+
+        std::ranges::sort(data);
+        return data;
+    }
+
+    static void expect_merged(const std::vector<T>& first, const std::vector<T>& second)
+    {
+        std::vector<T> expected(first.size() + second.size());
+        std::ranges::merge(first, second, expected.begin());
+
+        std::vector<T> result(first.size() + second.size());
+        algo::local::merge_into(first.data(), first.size(), second.data(), second.size(), result.data());
+
+        EXPECT_EQ(result, expected) << "Failed for sizes " << first.size() << " and " << second.size();
+    }
+};
+
+using MergeKernelTypes = ::testing::Types<std::int32_t, std::int64_t, float, double, std::uint16_t, std::string>;
+TYPED_TEST_SUITE(MergeKernelTest, MergeKernelTypes);
+
+TYPED_TEST(MergeKernelTest, AllSmallSizes)
+{
+    // Covers empty ranges, ranges shorter than a register and every possible tail length
+    for (size_t size1 = 0; size1 <= 20; ++size1)
+    {
+        for (size_t size2 = 0; size2 <= 20; ++size2)
+        {
+            const auto seed = static_cast<unsigned int>(size1 * 21 + size2);
+            this->expect_merged(this->generate_sorted(size1, seed), this->generate_sorted(size2, seed + 1000));
+        }
+    }
+}
+
+TYPED_TEST(MergeKernelTest, SkewedSizes)
+{
+    this->expect_merged(this->generate_sorted(3, 1), this->generate_sorted(1000, 2));
+    this->expect_merged(this->generate_sorted(1000, 3), this->generate_sorted(5, 4));
+}
+
+TYPED_TEST(MergeKernelTest, DisjointRanges)
+{
+    auto data = this->generate_sorted(2000, 5);
+    const std::vector<TypeParam> lower(data.begin(), data.begin() + 1000);
+    const std::vector<TypeParam> upper(data.begin() + 1000, data.end());
+
+    this->expect_merged(lower, upper);
+    this->expect_merged(upper, lower);
+}
+
+TYPED_TEST(MergeKernelTest, LargeRandomRanges)
+{
+    this->expect_merged(this->generate_sorted(10007, 6), this->generate_sorted(9973, 7));
+}
+
+/** Floating point values the default merge must keep although they compare equal to others or unordered */
+template<typename T>
+class FloatingMergeTest : public ::testing::Test
+{
+protected:
+    /** Bit patterns of values in ascending order, so -0.0 and +0.0 or different NaNs are told apart */
+    static std::vector<std::string> bit_patterns(const std::vector<T>& values)
+    {
+        std::vector<std::string> patterns;
+        for (const T value: values)
+            patterns.emplace_back(reinterpret_cast<const char*>(&value), sizeof(value));
+
+        std::ranges::sort(patterns);
+        return patterns;
+    }
+
+    static std::vector<T> merged(const std::vector<T>& first, const std::vector<T>& second)
+    {
+        std::vector<T> result(first.size() + second.size());
+        algo::local::merge_into(first.data(), first.size(), second.data(), second.size(), result.data());
+        return result;
+    }
+
+    static std::vector<T> concatenated(std::vector<T> first, const std::vector<T>& second)
+    {
+        first.insert(first.end(), second.begin(), second.end());
+        return first;
+    }
+};
+
+using FloatingMergeTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(FloatingMergeTest, FloatingMergeTypes);
+
+TYPED_TEST(FloatingMergeTest, SignedZeros)
+{
+    // Runs of zeros of both signs between negative and positive values, longer than a register
+    std::vector<TypeParam> first;
+    std::vector<TypeParam> second;
+    for (int i = 0; i < 100; ++i)
+    {
+        first.push_back(static_cast<TypeParam>(i % 3 == 0 ? -0.0 : 0.0));
+        second.push_back(static_cast<TypeParam>(i % 2 == 0 ? 0.0 : -0.0));
+    }
+    first.insert(first.begin(), 20, TypeParam{ -1 });
+    second.insert(second.end(), 20, TypeParam{ 1 });
+
+    const auto result = this->merged(first, second);
+    EXPECT_TRUE(std::ranges::is_sorted(result));
+    EXPECT_EQ(this->bit_patterns(result), this->bit_patterns(this->concatenated(first, second)));
+}
+
+TYPED_TEST(FloatingMergeTest, NaN)
+{
+    // The order of NaNs is unspecified, but the result is a permutation of the input
+    std::vector<TypeParam> first;
+    std::vector<TypeParam> second;
+    for (int i = 0; i < 50; ++i)
+    {
+        first.push_back(i % 5 == 0 ? std::numeric_limits<TypeParam>::quiet_NaN() : static_cast<TypeParam>(i));
+        second.push_back(i % 7 == 0 ? -std::numeric_limits<TypeParam>::quiet_NaN() : static_cast<TypeParam>(i) + 0.5f);
+    }
+
+    EXPECT_EQ(this->bit_patterns(this->merged(first, second)), this->bit_patterns(this->concatenated(first, second)));
+}
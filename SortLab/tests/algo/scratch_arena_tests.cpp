@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <new>
+#include <set>
+#include <string>
+#include <tuple>
+
+#include "algo/counting_resource.h"
+#include "algo/scratch_arena.h"
+#include "algo/sort.h"
+#include "utility.h"
+
+TEST(ScratchArenaTest, ReusesBlockAfterWarmUp)
+{
+    algo::counting_resource upstream(std::pmr::new_delete_resource());
+    algo::scratch_arena arena(&upstream);
+
+    // The first call is served by the upstream resource, the second one allocates the block
+    algo::merge_sort(utility::tests::generate_random_data(1e4), &arena);
+    algo::merge_sort(utility::tests::generate_random_data(1e4), &arena);
+    const size_t warm_up_allocations = upstream.stats().allocations;
+    EXPECT_GT(arena.capacity(), 1e4 * sizeof(int));
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        auto data = utility::tests::generate_random_data(10000 - i);
+        algo::merge_sort(data, &arena);
+        algo::concurrent::merge_sort(data, &arena);
+        algo::concurrent::merge_sort_advanced(data, &arena);
+        EXPECT_TRUE(std::ranges::is_sorted(data));
+    }
+
+    EXPECT_EQ(upstream.stats().allocations, warm_up_allocations);
+}
+
+TEST(ScratchArenaTest, GrowsForLargerSorts)
+{
+    algo::counting_resource upstream(std::pmr::new_delete_resource());
+    algo::scratch_arena arena(&upstream);
+
+    algo::merge_sort(utility::tests::generate_random_data(100), &arena);
+    algo::merge_sort(utility::tests::generate_random_data(100), &arena);
+    const size_t small_capacity = arena.capacity();
+    EXPECT_GT(small_capacity, 0);
+
+    // The larger sort overflows the block, which grows when the next sort starts
+    algo::merge_sort(utility::tests::generate_random_data(1e4), &arena);
+    EXPECT_EQ(arena.capacity(), small_capacity);
+    algo::merge_sort(utility::tests::generate_random_data(1e4), &arena);
+    EXPECT_GT(arena.capacity(), small_capacity);
+
+    const size_t allocations = upstream.stats().allocations;
+    algo::merge_sort(utility::tests::generate_random_data(1e4), &arena);
+    EXPECT_EQ(upstream.stats().allocations, allocations);
+}
+
+TEST(ScratchArenaTest, AllocationsAreAligned)
+{
+    algo::scratch_arena arena;
+
+    // Allocating twice so that the second series is served by the block
+    for (size_t round = 0; round < 2; ++round)
+    {
+        void* first = arena.allocate(3, 1);
+        void* second = arena.allocate(16, 16);
+        void* third = arena.allocate(256, 256);
+
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % 16, 0);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(third) % 256, 0);
+
+        arena.deallocate(third, 256, 256);
+        arena.deallocate(second, 16, 16);
+        arena.deallocate(first, 3, 1);
+    }
+}
+
+namespace
+{
+/** Remembers its live allocations, so deallocating anything else fails the test, and can be made to fail */
+class strict_resource final : public std::pmr::memory_resource
+{
+public:
+    bool fail = false;
+
+    [[nodiscard]] size_t live_allocations() const
+    {
+        return _live.size();
+    }
+
+private:
+    std::set<void*> _live;
+
+    void* do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        if (fail)
+            throw std::bad_alloc();
+
+        void* pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        _live.insert(pointer);
+        return pointer;
+    }
+
+    void do_deallocate(void* pointer, const size_t bytes, const size_t alignment) override
+    {
+        ASSERT_EQ(_live.erase(pointer), 1) << "deallocating a pointer which was not allocated";
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+} // namespace
+
+TEST(ScratchArenaTest, EmptyAllocationOfFullBlock)
+{
+    strict_resource upstream;
+    algo::scratch_arena arena(&upstream);
+
+    // The block gets the peak usage of 100 bytes and the worst case padding, rounded up to the block alignment
+    arena.deallocate(arena.allocate(100, 1), 100, 1);
+    void* full = arena.allocate(128, 1);
+    ASSERT_EQ(arena.capacity(), 128);
+
+    void* empty = arena.allocate(0, 1);
+    arena.deallocate(empty, 0, 1);
+    arena.deallocate(full, 128, 1);
+
+    arena.release();
+    EXPECT_EQ(upstream.live_allocations(), 0);
+}
+
+TEST(ScratchArenaTest, DeallocationDoesNotAllocate)
+{
+    strict_resource upstream;
+    algo::scratch_arena arena(&upstream);
+
+    // The overflow would make the block grow, the failing upstream resource shows it is not done by deallocate
+    void* overflow = arena.allocate(1000, 8);
+    upstream.fail = true;
+    EXPECT_NO_THROW(arena.deallocate(overflow, 1000, 8));
+    EXPECT_EQ(arena.capacity(), 0);
+
+    EXPECT_THROW(std::ignore = arena.allocate(10, 8), std::bad_alloc);
+    EXPECT_EQ(arena.capacity(), 0);
+    upstream.fail = false;
+    void* pointer = arena.allocate(10, 8);
+    EXPECT_GE(arena.capacity(), 1000);
+    arena.deallocate(pointer, 10, 8);
+
+    arena.release();
+    EXPECT_EQ(upstream.live_allocations(), 0);
+}
+
+TEST(ScratchArenaTest, FailedAllocationIsNotCounted)
+{
+    strict_resource upstream;
+    algo::scratch_arena arena(&upstream);
+
+    // The failed overflow is not an active allocation, so the block still grows once the others are returned
+    void* pointer = arena.allocate(100, 8);
+    upstream.fail = true;
+    EXPECT_THROW(std::ignore = arena.allocate(1000, 8), std::bad_alloc);
+    upstream.fail = false;
+    arena.deallocate(pointer, 100, 8);
+
+    pointer = arena.allocate(100, 8);
+    EXPECT_GE(arena.capacity(), 100);
+    EXPECT_LT(arena.capacity(), 1000);
+    arena.deallocate(pointer, 100, 8);
+
+    arena.release();
+    EXPECT_EQ(upstream.live_allocations(), 0);
+}
+
+TEST(ScratchArenaTest, ReleaseReturnsBlock)
+{
+    algo::counting_resource upstream(std::pmr::new_delete_resource());
+    {
+        algo::scratch_arena arena(&upstream);
+        algo::merge_sort(utility::tests::generate_random_data(1000), &arena);
+        algo::merge_sort(utility::tests::generate_random_data(1000), &arena);
+
+        arena.release();
+        EXPECT_EQ(arena.capacity(), 0);
+    }
+
+    EXPECT_EQ(upstream.stats().allocations, upstream.stats().deallocations);
+}
+
+TEST(ScratchArenaTest, NonTrivialElements)
+{
+    std::vector<std::string> data{ "pear", "apple", "fig", "kiwi", "apple" };
+    algo::merge_sort(data, &algo::thread_local_scratch_arena());
+    algo::merge_sort(data, &algo::thread_local_scratch_arena());
+
+    EXPECT_EQ(data, (std::vector<std::string>{ "apple", "apple", "fig", "kiwi", "pear" }));
+}
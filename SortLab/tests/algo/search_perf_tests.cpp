@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+#include "algo/search.h"
+#include "utility.h"
+
+/** The number of lookups issued against the sorted range in every iteration */
+static constexpr size_t query_num = 1 << 20;
+
+/** Benchmark for looking up every query separately with algo::binary_search */
+static void BM_LoopBinarySearch(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto sorted = utility::tests::generate_random_data(size);
+    std::ranges::sort(sorted);
+    const auto queries = utility::tests::generate_random_data(query_num);
+    std::vector<size_t> out(query_num);
+
+    for (auto _: state)
+    {
+        for (size_t i = 0; i < query_num; ++i)
+            out[i] = algo::binary_search(sorted.data(), sorted.size(), queries[i]);
+
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    // Reported as queries per second
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * query_num));
+}
+
+/** Benchmark for interleaved searches in the calling thread only */
+static void BM_InterleavedLowerBound(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto sorted = utility::tests::generate_random_data(size);
+    std::ranges::sort(sorted);
+    const auto queries = utility::tests::generate_random_data(query_num);
+    std::vector<size_t> out(query_num);
+
+    for (auto _: state)
+    {
+        algo::local::batch_lower_bound(sorted.data(), sorted.size(), queries.data(), query_num, out.data());
+
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    // Reported as queries per second
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * query_num));
+}
+
+/** Benchmark for looking up all the queries at once with interleaved searches in several threads */
+static void BM_BatchLowerBound(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto sorted = utility::tests::generate_random_data(size);
+    std::ranges::sort(sorted);
+    const auto queries = utility::tests::generate_random_data(query_num);
+    std::vector<size_t> out(query_num);
+
+    for (auto _: state)
+    {
+        algo::batch_lower_bound(sorted, queries, out);
+
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    // Reported as queries per second
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * query_num));
+}
+
+/** Sorted range sizes from the L1-resident ones to the ones which are much larger than LLC */
+BENCHMARK(BM_LoopBinarySearch)->RangeMultiplier(10)->Range(1e3, 1e8)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InterleavedLowerBound)->RangeMultiplier(10)->Range(1e3, 1e8)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BatchLowerBound)->RangeMultiplier(10)->Range(1e3, 1e8)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "algo/search.h"
+#include "utility.h"
+
+/** Expected results are calculated with std::lower_bound */
+static std::vector<size_t> expected_lower_bounds(const std::vector<int>& sorted, const std::vector<int>& queries)
+{
+    std::vector<size_t> expected(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i)
+        expected[i] = static_cast<size_t>(std::ranges::lower_bound(sorted, queries[i]) - sorted.begin());
+
+    return expected;
+}
+
+TEST(BatchLowerBoundTest, EmptyQueries)
+{
+    const std::vector<int> sorted{ 1, 2, 3 };
+    const std::vector<int> queries;
+    std::vector<size_t> out;
+
+    algo::batch_lower_bound(sorted, queries, out);
+    EXPECT_TRUE(out.empty());
+}
+
+TEST(BatchLowerBoundTest, EmptySortedRange)
+{
+    const std::vector<int> sorted;
+    const std::vector<int> queries{ -1, 0, 1 };
+    std::vector<size_t> out(queries.size(), 42);
+
+    algo::batch_lower_bound(sorted, queries, out);
+    EXPECT_EQ(out, std::vector<size_t>(queries.size(), 0));
+}
+
+TEST(BatchLowerBoundTest, SingleElement)
+{
+    const std::vector<int> sorted{ 5 };
+    const std::vector<int> queries{ 4, 5, 6 };
+    std::vector<size_t> out(queries.size());
+
+    algo::batch_lower_bound(sorted, queries, out);
+    EXPECT_EQ(out, (std::vector<size_t>{ 0, 0, 1 }));
+}
+
+TEST(BatchLowerBoundTest, OutputRangeTooSmall)
+{
+    const std::vector<int> sorted{ 1, 2, 3 };
+    const std::vector<int> queries{ 1, 2 };
+    std::vector<size_t> out(1);
+
+    EXPECT_THROW(algo::batch_lower_bound(sorted, queries, out), std::invalid_argument);
+}
+
+TEST(BatchLowerBoundTest, Duplicates)
+{
+    const std::vector<int> sorted{ 1, 1, 2, 2, 2, 3, 5, 5 };
+    const std::vector<int> queries{ 0, 1, 2, 3, 4, 5, 6 };
+    std::vector<size_t> out(queries.size());
+
+    algo::batch_lower_bound(sorted, queries, out);
+    EXPECT_EQ(out, expected_lower_bounds(sorted, queries));
+}
+
+TEST(BatchLowerBoundTest, QueriesNotMultipleOfGroup)
+{
+    auto sorted = utility::tests::generate_random_data(1000);
+    std::ranges::sort(sorted);
+    const auto queries = utility::tests::generate_random_data(1000 + 7);
+    std::vector<size_t> out(queries.size());
+
+    algo::batch_lower_bound(sorted, queries, out);
+    EXPECT_EQ(out, expected_lower_bounds(sorted, queries));
+}
+
+TEST(BatchLowerBoundTest, QueriesFromRange)
+{
+    const auto sorted = utility::tests::generate_sorted_data(1 << 12);
+    auto queries = utility::tests::generate_reversed_data(1 << 12);
+    std::vector<size_t> out(queries.size());
+
+    algo::batch_lower_bound(sorted, queries, out);
+    EXPECT_EQ(out, expected_lower_bounds(sorted, queries));
+}
+
+TEST(BatchLowerBoundTest, LargeMultithreadedBatch)
+{
+    auto sorted = utility::tests::generate_duplicated_data(1e5);
+    std::ranges::sort(sorted);
+    const auto queries = utility::tests::generate_duplicated_data(1e6);
+    const auto expected = expected_lower_bounds(sorted, queries);
+
+    for (const size_t threads: { 1, 2, 5 })
+    {
+        std::vector<size_t> out(queries.size());
+        algo::batch_lower_bound(sorted, queries, out, threads);
+        EXPECT_EQ(out, expected) << "threads: " << threads;
+    }
+}
+
+TEST(BatchLowerBoundTest, ZeroThreads)
+{
+    const std::vector<int> sorted{ 1, 2, 3 };
+    const std::vector<int> queries{ 1, 2 };
+    std::vector<size_t> out(queries.size());
+
+    EXPECT_THROW(algo::batch_lower_bound(sorted, queries, out, 0), std::invalid_argument);
+}
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "algo/set_ops.h"
+#include "utility.h"
+
+/** Benchmark template for comparing fused sorts with separate passes */
+template<typename FusedFunction, typename DataGenerator>
+static void BM_Fused(benchmark::State& state, FusedFunction fused_function, DataGenerator data_generator)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+
+    for (auto _: state)
+    {
+        // Do not measure data generation
+        state.PauseTiming();
+        auto data = data_generator(size);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(fused_function(data));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+static size_t separate_sort_unique(std::vector<int>& data)
+{
+    std::ranges::sort(data);
+    return static_cast<size_t>(std::unique(data.begin(), data.end()) - data.begin());
+}
+
+static std::vector<std::pair<int, size_t>> separate_sort_count_by_key(std::vector<int>& data)
+{
+    std::ranges::sort(data);
+
+    std::vector<std::pair<int, size_t>> counts;
+    for (const int value: data)
+    {
+        if (!counts.empty() && counts.back().first == value)
+            counts.back().second++;
+        else
+            counts.emplace_back(value, 1);
+    }
+    return counts;
+}
+
+/** Fused sorts have an optional scratch resource argument, so they are wrapped to be passed as fused functions */
+static size_t sort_unique(std::vector<int>& data)
+{
+    return algo::sort_unique(data);
+}
+
+static std::vector<std::pair<int, size_t>> sort_count_by_key(std::vector<int>& data)
+{
+    return algo::sort_count_by_key(data);
+}
+
+static size_t concurrent_sort_unique(std::vector<int>& data)
+{
+    return algo::concurrent::sort_unique(data);
+}
+
+static std::vector<std::pair<int, size_t>> concurrent_sort_count_by_key(std::vector<int>& data)
+{
+    return algo::concurrent::sort_count_by_key(data);
+}
+
+/** A macros for measuring fused sorts and separate passes */
+#define BENCHMARK_FUSED(function_name, data_generator_name, function, data_generator)                                  \
+    BENCHMARK_CAPTURE(BM_Fused, function_name##_##data_generator_name##Data, function, data_generator)                 \
+            ->RangeMultiplier(10)                                                                                      \
+            ->Range(1e3, 1e6)                                                                                          \
+            ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_FUSED(SortUnique, Random, sort_unique, utility::tests::generate_random_data);
+BENCHMARK_FUSED(SortUnique, Duplicated, sort_unique, utility::tests::generate_duplicated_data);
+BENCHMARK_FUSED(ConcurrentSortUnique, Random, concurrent_sort_unique, utility::tests::generate_random_data);
+BENCHMARK_FUSED(ConcurrentSortUnique, Duplicated, concurrent_sort_unique, utility::tests::generate_duplicated_data);
+BENCHMARK_FUSED(SeparateSortUnique, Random, separate_sort_unique, utility::tests::generate_random_data);
+BENCHMARK_FUSED(SeparateSortUnique, Duplicated, separate_sort_unique, utility::tests::generate_duplicated_data);
+
+BENCHMARK_FUSED(SortCountByKey, Random, sort_count_by_key, utility::tests::generate_random_data);
+BENCHMARK_FUSED(SortCountByKey, Duplicated, sort_count_by_key, utility::tests::generate_duplicated_data);
+BENCHMARK_FUSED(ConcurrentSortCountByKey, Random, concurrent_sort_count_by_key,
+                utility::tests::generate_random_data);
+BENCHMARK_FUSED(ConcurrentSortCountByKey, Duplicated, concurrent_sort_count_by_key,
+                utility::tests::generate_duplicated_data);
+BENCHMARK_FUSED(SeparateSortCountByKey, Random, separate_sort_count_by_key, utility::tests::generate_random_data);
+BENCHMARK_FUSED(SeparateSortCountByKey, Duplicated, separate_sort_count_by_key,
+                utility::tests::generate_duplicated_data);
+
+
+/** Random sorted values without duplicates from [0, max_value] */
+static std::vector<int> generate_set(const size_t size, const int max_value, const unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution distrib(0, max_value);
+
+    std::vector<int> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = distrib(generator);
+
+    std::ranges::sort(data);
+    data.erase(std::unique(data.begin(), data.end()), data.end());
+    return data;
+}
+
+/** The second set is range(1) times smaller than the first one, both sets are taken from the same values range */
+static std::pair<std::vector<int>, std::vector<int>> generate_sets(const size_t size, const size_t ratio)
+{
+    const int max_value = static_cast<int>(4 * size);
+    return { generate_set(size, max_value, 1), generate_set(size / ratio, max_value, 2) };
+}
+
+/** Benchmark template for comparing set operations with their STL versions */
+template<typename SetFunction>
+static void BM_SetOperation(benchmark::State& state, SetFunction set_function)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto [first, second] = generate_sets(size, static_cast<size_t>(state.range(1)));
+    std::vector<int> result(first.size() + second.size());
+
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(set_function(first, second, result));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (first.size() + second.size())));
+}
+
+static size_t stl_set_intersection(const std::vector<int>& first, const std::vector<int>& second,
+                                   std::vector<int>& result)
+{
+    return static_cast<size_t>(std::ranges::set_intersection(first, second, result.begin()).out - result.begin());
+}
+
+static size_t stl_set_union(const std::vector<int>& first, const std::vector<int>& second, std::vector<int>& result)
+{
+    return static_cast<size_t>(std::ranges::set_union(first, second, result.begin()).out - result.begin());
+}
+
+static size_t stl_set_difference(const std::vector<int>& first, const std::vector<int>& second,
+                                 std::vector<int>& result)
+{
+    return static_cast<size_t>(std::ranges::set_difference(first, second, result.begin()).out - result.begin());
+}
+
+/** Concurrent set operations have an optional threads argument, so they are wrapped to be passed as set functions */
+static size_t concurrent_set_intersection(const std::vector<int>& first, const std::vector<int>& second,
+                                          std::vector<int>& result)
+{
+    return algo::concurrent::set_intersection(first, second, result);
+}
+
+static size_t concurrent_set_union(const std::vector<int>& first, const std::vector<int>& second,
+                                   std::vector<int>& result)
+{
+    return algo::concurrent::set_union(first, second, result);
+}
+
+static size_t concurrent_set_difference(const std::vector<int>& first, const std::vector<int>& second,
+                                        std::vector<int>& result)
+{
+    return algo::concurrent::set_difference(first, second, result);
+}
+
+/** A macros for measuring set operations with equal and skewed set sizes */
+#define BENCHMARK_SET_OPERATION(operation_name, set_function)                                                          \
+    BENCHMARK_CAPTURE(BM_SetOperation, operation_name, set_function)                                                   \
+            ->ArgsProduct({ { 100000, 10000000 }, { 1, 1000 } })                                                       \
+            ->UseRealTime()                                                                                            \
+            ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_SET_OPERATION(Intersection, (algo::set_intersection<std::vector<int>, std::vector<int>, std::vector<int>&>));
+BENCHMARK_SET_OPERATION(ConcurrentIntersection, concurrent_set_intersection);
+BENCHMARK_SET_OPERATION(STLIntersection, stl_set_intersection);
+
+BENCHMARK_SET_OPERATION(Union, (algo::set_union<std::vector<int>, std::vector<int>, std::vector<int>&>));
+BENCHMARK_SET_OPERATION(ConcurrentUnion, concurrent_set_union);
+BENCHMARK_SET_OPERATION(STLUnion, stl_set_union);
+
+BENCHMARK_SET_OPERATION(Difference, (algo::set_difference<std::vector<int>, std::vector<int>, std::vector<int>&>));
+BENCHMARK_SET_OPERATION(ConcurrentDifference, concurrent_set_difference);
+BENCHMARK_SET_OPERATION(STLDifference, stl_set_difference);
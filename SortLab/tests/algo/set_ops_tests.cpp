@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+
+#include "algo/counting_resource.h"
+#include "algo/set_ops.h"
+#include "utility.h"
+
+/** Sorted values without duplicates, which are taken from [0, max_value] */
+static std::vector<int> generate_set(const size_t size, const int max_value, const unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution distrib(0, max_value);
+
+    std::vector<int> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = distrib(generator);
+
+    std::ranges::sort(data);
+    data.erase(std::unique(data.begin(), data.end()), data.end());
+    return data;
+}
+
+TEST(SortUniqueTest, EmptyRange)
+{
+    std::vector<int> data;
+    EXPECT_EQ(algo::sort_unique(data), 0);
+}
+
+TEST(SortUniqueTest, MatchesSortAndUnique)
+{
+    const std::vector<std::vector<int>> inputs{
+        { 5, 5, 5, 5, 5 },
+        { -3, 1, 9, 1, 0, 9, -10, 0, -3, -10 },
+        utility::tests::generate_random_data(1e4),
+        utility::tests::generate_sorted_data(1e4),
+        utility::tests::generate_reversed_data(1e4),
+        utility::tests::generate_duplicated_data(1e4),
+        // Large enough for the concurrent merges to be split
+        utility::tests::generate_random_data(2e5),
+    };
+
+    for (const auto& input: inputs)
+    {
+        auto expected = input;
+        std::ranges::sort(expected);
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+        auto data = input;
+        const size_t unique_size = algo::sort_unique(data);
+        data.resize(unique_size);
+        EXPECT_EQ(data, expected);
+
+        for (const size_t threads: { 1, 2, 5 })
+        {
+            auto concurrent_data = input;
+            const size_t concurrent_unique_size = algo::concurrent::sort_unique(
+                    concurrent_data, std::pmr::get_default_resource(), threads);
+            concurrent_data.resize(concurrent_unique_size);
+            EXPECT_EQ(concurrent_data, expected);
+        }
+    }
+}
+
+TEST(SortUniqueTest, Strings)
+{
+    std::vector<std::string> data{ "pear", "apple", "pear", "fig", "apple", "kiwi" };
+    const size_t unique_size = algo::sort_unique(data);
+    data.resize(unique_size);
+    EXPECT_EQ(data, (std::vector<std::string>{ "apple", "fig", "kiwi", "pear" }));
+}
+
+TEST(SortUniqueTest, ZeroThreads)
+{
+    std::vector<int> data{ 2, 1 };
+    EXPECT_THROW(algo::concurrent::sort_unique(data, std::pmr::get_default_resource(), 0), std::invalid_argument);
+    EXPECT_THROW(algo::concurrent::sort_count_by_key(data, std::pmr::get_default_resource(), 0),
+                 std::invalid_argument);
+}
+
+TEST(SortUniqueTest, ScratchBuffersComeFromResource)
+{
+    algo::counting_resource scratch(std::pmr::new_delete_resource());
+    auto data = utility::tests::generate_duplicated_data(1e4);
+
+    // One buffer for the keys, two more for the counts of sort_count_by_key
+    auto copy = data;
+    algo::sort_unique(copy, &scratch);
+    EXPECT_EQ(scratch.stats().allocations, 1);
+    copy = data;
+    algo::concurrent::sort_unique(copy, &scratch, 2);
+    EXPECT_EQ(scratch.stats().allocations, 2);
+
+    copy = data;
+    algo::sort_count_by_key(copy, &scratch);
+    EXPECT_EQ(scratch.stats().allocations, 5);
+    copy = data;
+    algo::concurrent::sort_count_by_key(copy, &scratch, 2);
+    EXPECT_EQ(scratch.stats().allocations, 8);
+    EXPECT_EQ(scratch.stats().bytes_in_use, 0);
+}
+
+TEST(SortCountByKeyTest, EmptyRange)
+{
+    std::vector<int> data;
+    EXPECT_TRUE(algo::sort_count_by_key(data).empty());
+    EXPECT_TRUE(algo::concurrent::sort_count_by_key(data).empty());
+}
+
+TEST(SortCountByKeyTest, MatchesCountingWithMap)
+{
+    for (const auto& input: { utility::tests::generate_duplicated_data(1e4), utility::tests::generate_random_data(1e4),
+                              utility::tests::generate_duplicated_data(2e5), std::vector<int>{ 2, 1, 2, 1, 2 } })
+    {
+        std::map<int, size_t> expected_counts;
+        for (const int value: input)
+            expected_counts[value]++;
+        const std::vector<std::pair<int, size_t>> expected(expected_counts.begin(), expected_counts.end());
+
+        auto data = input;
+        EXPECT_EQ(algo::sort_count_by_key(data), expected);
+
+        for (const size_t threads: { 1, 2, 5 })
+        {
+            auto concurrent_data = input;
+            EXPECT_EQ(algo::concurrent::sort_count_by_key(concurrent_data, std::pmr::get_default_resource(), threads), expected);
+        }
+    }
+}
+
+TEST(SortCountByKeyTest, KeysStayInRange)
+{
+    std::vector<std::string> data{ "pear", "apple", "pear", "fig", "apple" };
+    const auto counts = algo::sort_count_by_key(data);
+
+    const std::vector<std::pair<std::string, size_t>> expected{ { "apple", 2 }, { "fig", 1 }, { "pear", 2 } };
+    EXPECT_EQ(counts, expected);
+    for (size_t i = 0; i < counts.size(); ++i)
+        EXPECT_EQ(data[i], counts[i].first);
+}
+
+/** Parameterized test fixture for set operations on sets of different sizes */
+class SetOperationsTest : public ::testing::TestWithParam<std::tuple<size_t, size_t>>
+{
+protected:
+    void SetUp() override
+    {
+        const auto [size1, size2] = GetParam();
+        // Values range is chosen so that sets have a lot of common elements
+        const int max_value = static_cast<int>(2 * std::max(size1, size2) + 1);
+        first = generate_set(size1, max_value, 1);
+        second = generate_set(size2, max_value, 2);
+    }
+
+    std::vector<int> first, second;
+};
+
+TEST_P(SetOperationsTest, Intersection)
+{
+    std::vector<int> expected;
+    std::ranges::set_intersection(first, second, std::back_inserter(expected));
+
+    std::vector<int> result(std::min(first.size(), second.size()));
+    result.resize(algo::set_intersection(first, second, result));
+    EXPECT_EQ(result, expected);
+
+    for (const size_t threads: { 1, 2, 5 })
+    {
+        std::vector<int> concurrent_result(std::min(first.size(), second.size()));
+        concurrent_result.resize(algo::concurrent::set_intersection(first, second, concurrent_result, threads));
+        EXPECT_EQ(concurrent_result, expected) << "threads: " << threads;
+    }
+}
+
+TEST_P(SetOperationsTest, Union)
+{
+    std::vector<int> expected;
+    std::ranges::set_union(first, second, std::back_inserter(expected));
+
+    std::vector<int> result(first.size() + second.size());
+    result.resize(algo::set_union(first, second, result));
+    EXPECT_EQ(result, expected);
+
+    for (const size_t threads: { 1, 2, 5 })
+    {
+        std::vector<int> concurrent_result(first.size() + second.size());
+        concurrent_result.resize(algo::concurrent::set_union(first, second, concurrent_result, threads));
+        EXPECT_EQ(concurrent_result, expected) << "threads: " << threads;
+    }
+}
+
+TEST_P(SetOperationsTest, Difference)
+{
+    std::vector<int> expected;
+    std::ranges::set_difference(first, second, std::back_inserter(expected));
+
+    std::vector<int> result(first.size());
+    result.resize(algo::set_difference(first, second, result));
+    EXPECT_EQ(result, expected);
+
+    for (const size_t threads: { 1, 2, 5 })
+    {
+        std::vector<int> concurrent_result(first.size());
+        concurrent_result.resize(algo::concurrent::set_difference(first, second, concurrent_result, threads));
+        EXPECT_EQ(concurrent_result, expected) << "threads: " << threads;
+    }
+}
+
+/** Sizes cover empty sets, sets shorter than a SIMD block, skewed sizes for galloping and multithreaded sizes */
+INSTANTIATE_TEST_SUITE_P(SetOperations, SetOperationsTest,
+                         ::testing::Values(std::make_tuple(0, 0), std::make_tuple(0, 10), std::make_tuple(10, 0),
+                                           std::make_tuple(3, 5), std::make_tuple(7, 9), std::make_tuple(100, 100),
+                                           std::make_tuple(1000, 37), std::make_tuple(10, 10000),
+                                           std::make_tuple(10000, 10), std::make_tuple(200000, 150000)));
+
+TEST(SetOperationsOutputTest, OutputRangeTooSmall)
+{
+    const std::vector<int> first{ 1, 2, 3 }, second{ 2, 3, 4 };
+    std::vector<int> out(2);
+
+    EXPECT_THROW(algo::set_intersection(first, second, std::vector<int>(1)), std::invalid_argument);
+    EXPECT_THROW(algo::set_union(first, second, out), std::invalid_argument);
+    EXPECT_THROW(algo::set_difference(first, second, out), std::invalid_argument);
+}
+
+TEST(SetOperationsOutputTest, ZeroThreads)
+{
+    const std::vector<int> first{ 1, 2, 3 }, second{ 2, 3, 4 };
+    std::vector<int> out(first.size() + second.size());
+
+    EXPECT_THROW(algo::concurrent::set_intersection(first, second, out, 0), std::invalid_argument);
+    EXPECT_THROW(algo::concurrent::set_union(first, second, out, 0), std::invalid_argument);
+    EXPECT_THROW(algo::concurrent::set_difference(first, second, out, 0), std::invalid_argument);
+}
@@ -1,27 +1,151 @@
 #include <benchmark/benchmark.h>
 
+#include "algo/counting_resource.h"
+#include "algo/scratch_arena.h"
 #include "algo/sort.h"
+#include "generators.h"
+#include "perf_counters.h"
 #include "utility.h"
 
-/** Benchmark template for measuring sort algorithms */
-template<typename SortFunction, typename DataGenerator>
-static void BM_Sort(benchmark::State& state, SortFunction sort_function, DataGenerator data_generator)
+#include <chrono>
+#include <cstring>
+#include <map>
+
+/** Input datasets of one benchmark: generated once and restored before every timed sort */
+class input_pool final
 {
-    const auto size = static_cast<size_t>(state.range(0));
+public:
+    /**
+     * Small inputs are sorted in batches of distinct copies, so a single timing window and a single
+     * start/stop of hardware counters cover at least min_batch_elements elements
+     */
+    static constexpr size_t min_batch_elements = 1 << 16;
+
+    template<typename DataGenerator>
+    input_pool(DataGenerator data_generator, const size_t size)
+        : _inputs(std::max<size_t>(1, min_batch_elements / std::max<size_t>(1, size)))
+        , _data(_inputs.size(), std::vector<int>(size))
+    {
+        for (auto& input: _inputs)
+            input = data_generator(size);
+    }
+
+    [[nodiscard]] size_t batch_size() const
+    {
+        return _inputs.size();
+    }
+
+    /** Overwrites the sorted data with the original inputs, no allocations are made */
+    std::vector<std::vector<int>>& restore()
+    {
+        for (size_t i = 0; i < _inputs.size(); ++i)
+            std::memcpy(_data[i].data(), _inputs[i].data(), _inputs[i].size() * sizeof(int));
 
+        return _data;
+    }
+
+private:
+    std::vector<std::vector<int>> _inputs;
+    std::vector<std::vector<int>> _data;
+};
+
+/** Returns the pool of inputs, generated once per data generator and size for all runs of a benchmark */
+template<typename DataGenerator>
+static input_pool& get_input_pool(DataGenerator data_generator, const size_t size)
+{
+    static std::map<std::pair<DataGenerator, size_t>, input_pool> pools;
+
+    auto it = pools.find({ data_generator, size });
+    if (it == pools.end())
+        it = pools.try_emplace({ data_generator, size }, data_generator, size).first;
+
+    return it->second;
+}
+
+/**
+ * Times a batch of sorts of restored inputs with the manual timer, restoring is not measured.
+ * The iteration time is reported per sort, so complexity is fitted for a single sort of the given size
+ */
+template<typename SortBatch>
+static void run_sort_batches(benchmark::State& state, input_pool& pool, SortBatch sort_batch)
+{
     for (auto _: state)
     {
-        // Do not measure data generation
-        state.PauseTiming();
-        auto data = data_generator(size);
-        state.ResumeTiming();
+        auto& data = pool.restore();
 
-        sort_function(data);
+        const auto start = std::chrono::steady_clock::now();
+        sort_batch(data);
+        const auto finish = std::chrono::steady_clock::now();
 
         benchmark::DoNotOptimize(data);
+        state.SetIterationTime(std::chrono::duration<double>(finish - start).count() /
+                               static_cast<double>(pool.batch_size()));
     }
 
     state.SetComplexityN(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int)));
+    state.counters["batch"] = static_cast<double>(pool.batch_size());
+}
+
+/**
+ * Publishes allocations and allocated bytes per sort and the high-water mark of bytes in use.
+ * The counters are taken from the scratch memory resource, allocations of std::allocator are not seen
+ */
+static void publish_memory_stats(benchmark::State& state, const algo::memory_stats& stats, const size_t batch_size)
+{
+    const double sorts = static_cast<double>(state.iterations()) * static_cast<double>(batch_size);
+    if (sorts == 0)
+        return;
+
+    state.counters["allocations"] = static_cast<double>(stats.allocations) / sorts;
+    state.counters["allocated_bytes"] = static_cast<double>(stats.allocated_bytes) / sorts;
+    state.counters["peak_bytes"] = static_cast<double>(stats.peak_bytes);
+}
+
+/**
+ * Benchmark template for measuring sort algorithms.
+ * Hardware counters (where permitted) are collected only around the sorts and reported per element,
+ * scratch memory allocations are reported per sort
+ */
+template<typename SortFunction, typename DataGenerator>
+static void BM_Sort(benchmark::State& state, SortFunction sort_function, DataGenerator data_generator)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto& pool = get_input_pool(data_generator, size);
+    utility::tests::perf_counters counters;
+
+    // Sorts with a scratch resource argument take the default resource
+    algo::counting_resource memory;
+    std::pmr::memory_resource* previous_default = std::pmr::set_default_resource(&memory);
+
+    run_sort_batches(state, pool, [&](std::vector<std::vector<int>>& batch) {
+        counters.start();
+        for (auto& data: batch)
+            sort_function(data);
+        counters.stop();
+    });
+
+    std::pmr::set_default_resource(previous_default);
+
+    counters.publish(state, static_cast<double>(size * pool.batch_size()));
+    publish_memory_stats(state, memory.stats(), pool.batch_size());
+}
+
+/** Merge sorts have an optional scratch resource argument, so they are wrapped to be passed as sort functions */
+static void merge_sort(std::vector<int>& data)
+{
+    algo::merge_sort(data);
+}
+
+static void concurrent_merge_sort(std::vector<int>& data)
+{
+    algo::concurrent::merge_sort(data);
+}
+
+static void concurrent_merge_sort_advanced(std::vector<int>& data)
+{
+    algo::concurrent::merge_sort_advanced(data);
 }
 
 
@@ -31,6 +155,7 @@ static void BM_Sort(benchmark::State& state, SortFunction sort_function, DataGen
             ->RangeMultiplier(10)                                                                                      \
             ->Range(1e2, 1e6)                                                                                          \
             ->Complexity(benchmark::oNLogN)                                                                            \
+            ->UseManualTime()                                                                                          \
             ->Unit(benchmark::kMillisecond);
 
 /** A macros for measuring slow sort algorithms O(n^2) */
@@ -39,6 +164,7 @@ static void BM_Sort(benchmark::State& state, SortFunction sort_function, DataGen
             ->RangeMultiplier(10)                                                                                      \
             ->Range(1e2, 1e5)                                                                                          \
             ->Complexity(benchmark::oNSquared)                                                                         \
+            ->UseManualTime()                                                                                          \
             ->Unit(benchmark::kMillisecond);
 
 
@@ -132,40 +258,133 @@ BENCHMARK_SORT_FAST(QuickSort, Duplicated, algo::quick_sort<std::vector<int>&>,
 
 
 /** Performance benchmarks for Merge Sort */
-BENCHMARK_SORT_FAST(MergeSort, Random, algo::merge_sort<std::vector<int>&>, utility::tests::generate_random_data);
-BENCHMARK_SORT_FAST(MergeSort, Sorted, algo::merge_sort<std::vector<int>&>, utility::tests::generate_sorted_data);
-BENCHMARK_SORT_FAST(MergeSort, Reversed, algo::merge_sort<std::vector<int>&>, utility::tests::generate_reversed_data);
-BENCHMARK_SORT_FAST(MergeSort, AlmostSorted, algo::merge_sort<std::vector<int>&>,
-                    utility::tests::generate_almost_sorted_data);
-BENCHMARK_SORT_FAST(MergeSort, Duplicated, algo::merge_sort<std::vector<int>&>,
-                    utility::tests::generate_duplicated_data);
+BENCHMARK_SORT_FAST(MergeSort, Random, merge_sort, utility::tests::generate_random_data);
+BENCHMARK_SORT_FAST(MergeSort, Sorted, merge_sort, utility::tests::generate_sorted_data);
+BENCHMARK_SORT_FAST(MergeSort, Reversed, merge_sort, utility::tests::generate_reversed_data);
+BENCHMARK_SORT_FAST(MergeSort, AlmostSorted, merge_sort, utility::tests::generate_almost_sorted_data);
+BENCHMARK_SORT_FAST(MergeSort, Duplicated, merge_sort, utility::tests::generate_duplicated_data);
 
 
 /** Performance benchmarks for multithreaded Merge Sort */
-BENCHMARK_SORT_FAST(MultithreadedMergeSort, Random, algo::concurrent::merge_sort<std::vector<int>&>,
-                    utility::tests::generate_random_data);
-BENCHMARK_SORT_FAST(MultithreadedMergeSort, Sorted, algo::concurrent::merge_sort<std::vector<int>&>,
-                    utility::tests::generate_sorted_data);
-BENCHMARK_SORT_FAST(MultithreadedMergeSort, Reversed, algo::concurrent::merge_sort<std::vector<int>&>,
-                    utility::tests::generate_reversed_data);
-BENCHMARK_SORT_FAST(MultithreadedMergeSort, AlmostSorted, algo::concurrent::merge_sort<std::vector<int>&>,
+BENCHMARK_SORT_FAST(MultithreadedMergeSort, Random, concurrent_merge_sort, utility::tests::generate_random_data);
+BENCHMARK_SORT_FAST(MultithreadedMergeSort, Sorted, concurrent_merge_sort, utility::tests::generate_sorted_data);
+BENCHMARK_SORT_FAST(MultithreadedMergeSort, Reversed, concurrent_merge_sort, utility::tests::generate_reversed_data);
+BENCHMARK_SORT_FAST(MultithreadedMergeSort, AlmostSorted, concurrent_merge_sort,
                     utility::tests::generate_almost_sorted_data);
-BENCHMARK_SORT_FAST(MultithreadedMergeSort, Duplicated, algo::concurrent::merge_sort<std::vector<int>&>,
+BENCHMARK_SORT_FAST(MultithreadedMergeSort, Duplicated, concurrent_merge_sort,
                     utility::tests::generate_duplicated_data);
 
 
 /** Performance benchmarks for an advanced version of multithreaded Merge sort */
-BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, Random, algo::concurrent::merge_sort_advanced<std::vector<int>&>,
+BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, Random, concurrent_merge_sort_advanced,
                     utility::tests::generate_random_data);
-BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, Sorted, algo::concurrent::merge_sort_advanced<std::vector<int>&>,
+BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, Sorted, concurrent_merge_sort_advanced,
                     utility::tests::generate_sorted_data);
-BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, Reversed, algo::concurrent::merge_sort_advanced<std::vector<int>&>,
+BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, Reversed, concurrent_merge_sort_advanced,
                     utility::tests::generate_reversed_data);
-BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, AlmostSorted,
-                    algo::concurrent::merge_sort_advanced<std::vector<int>&>,
+BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, AlmostSorted, concurrent_merge_sort_advanced,
                     utility::tests::generate_almost_sorted_data);
-BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, Duplicated,
-                    algo::concurrent::merge_sort_advanced<std::vector<int>&>, utility::tests::generate_duplicated_data);
+BENCHMARK_SORT_FAST(MultithreadedMergeSortAdvanced, Duplicated, concurrent_merge_sort_advanced,
+                    utility::tests::generate_duplicated_data);
+
+
+/**
+ * Realistic and adversarial distributions from the parallel counter-based generators:
+ *     1. Zipf ranks - a few very frequent values
+ *     2. Gaussian values
+ *     3. Organ pipe - ascending and then descending half
+ *     4. Sawtooth - ascending runs of 1000 values
+ *     5. 16 interleaving sorted runs
+ *     6. 16 unique values
+ *     7. Median-of-3 killer permutation
+ */
+static std::vector<int> generate_zipf_data(const size_t size)
+{
+    return utility::tests::generate_zipf<int>(size);
+}
+
+static std::vector<int> generate_gaussian_data(const size_t size)
+{
+    return utility::tests::generate_gaussian<int>(size, 0, 1e6);
+}
+
+static std::vector<int> generate_sawtooth_data(const size_t size)
+{
+    return utility::tests::generate_sawtooth<int>(size, 1000);
+}
+
+static std::vector<int> generate_sorted_runs_data(const size_t size)
+{
+    return utility::tests::generate_sorted_runs<int>(size, 16);
+}
+
+static std::vector<int> generate_few_unique_data(const size_t size)
+{
+    return utility::tests::generate_few_unique<int>(size, 16);
+}
+
+/** A macros for measuring a fast sort on all distributions from the generators */
+#define BENCHMARK_SORT_DISTRIBUTIONS(sort_name, sort_function)                                                         \
+    BENCHMARK_SORT_FAST(sort_name, Zipf, sort_function, generate_zipf_data);                                           \
+    BENCHMARK_SORT_FAST(sort_name, Gaussian, sort_function, generate_gaussian_data);                                   \
+    BENCHMARK_SORT_FAST(sort_name, OrganPipe, sort_function, utility::tests::generate_organ_pipe<int>);                \
+    BENCHMARK_SORT_FAST(sort_name, Sawtooth, sort_function, generate_sawtooth_data);                                   \
+    BENCHMARK_SORT_FAST(sort_name, SortedRuns, sort_function, generate_sorted_runs_data);                              \
+    BENCHMARK_SORT_FAST(sort_name, FewUnique, sort_function, generate_few_unique_data);                                \
+    BENCHMARK_SORT_FAST(sort_name, MedianOf3Killer, sort_function, utility::tests::generate_median_of_3_killer<int>);
+
+BENCHMARK_SORT_DISTRIBUTIONS(STLSort, algo::stl_sort<std::vector<int>&>);
+BENCHMARK_SORT_DISTRIBUTIONS(BoostSpinSort, algo::boost_spin_sort<std::vector<int>&>);
+BENCHMARK_SORT_DISTRIBUTIONS(MergeSort, merge_sort);
+
+
+/** Benchmark template for measuring merge sorts with and without a reusable scratch arena */
+template<typename SortFunction>
+static void BM_SortScratch(benchmark::State& state, SortFunction sort_function, const bool use_arena)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+
+    algo::counting_resource upstream(std::pmr::new_delete_resource());
+    algo::scratch_arena arena(&upstream);
+    std::pmr::memory_resource* scratch = use_arena ? static_cast<std::pmr::memory_resource*>(&arena) : &upstream;
+
+    auto& pool = get_input_pool(utility::tests::generate_random_data, size);
+
+    run_sort_batches(state, pool, [&](std::vector<std::vector<int>>& batch) {
+        for (auto& data: batch)
+            sort_function(data, scratch);
+    });
+
+    publish_memory_stats(state, upstream.stats(), pool.batch_size());
+}
+
+/** A macros for measuring scratch allocations of merge sorts, the arena allocates only during warm-up */
+#define BENCHMARK_SORT_SCRATCH(sort_name, sort_function)                                                               \
+    BENCHMARK_CAPTURE(BM_SortScratch, sort_name##_Default, sort_function, false)                                       \
+            ->RangeMultiplier(100)                                                                                     \
+            ->Range(1e2, 1e6)                                                                                          \
+            ->UseManualTime()                                                                                          \
+            ->Unit(benchmark::kMillisecond);                                                                           \
+    BENCHMARK_CAPTURE(BM_SortScratch, sort_name##_Arena, sort_function, true)                                          \
+            ->RangeMultiplier(100)                                                                                     \
+            ->Range(1e2, 1e6)                                                                                          \
+            ->UseManualTime()                                                                                          \
+            ->Unit(benchmark::kMillisecond);
+
+/** Concurrent merge sorts also have an optional threads argument */
+static void concurrent_merge_sort_scratch(std::vector<int>& data, std::pmr::memory_resource* scratch)
+{
+    algo::concurrent::merge_sort(data, scratch);
+}
+
+static void concurrent_merge_sort_advanced_scratch(std::vector<int>& data, std::pmr::memory_resource* scratch)
+{
+    algo::concurrent::merge_sort_advanced(data, scratch);
+}
+
+BENCHMARK_SORT_SCRATCH(MergeSort, algo::merge_sort<std::vector<int>&>);
+BENCHMARK_SORT_SCRATCH(MultithreadedMergeSort, concurrent_merge_sort_scratch);
+BENCHMARK_SORT_SCRATCH(MultithreadedMergeSortAdvanced, concurrent_merge_sort_advanced_scratch);
 
 //--benchmark_filter=<regex>
 BENCHMARK_MAIN();
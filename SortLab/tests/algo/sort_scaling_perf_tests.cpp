@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include "algo/sort.h"
+#include "dataset_cache.h"
+#include "thread_scaling.h"
+
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <string>
+
+/**
+ * Random input shared by all thread counts of the same size, which run one after another, only the last size is
+ * kept mapped. It is generated once and mapped from the on-disk dataset cache by later runs
+ */
+static std::span<const int> get_scaling_input(const size_t size)
+{
+    static const utility::tests::dataset_cache cache;
+    static std::optional<utility::tests::mapped_dataset<int>> input;
+    if (!input || input->data().size() != size)
+    {
+        input.reset();
+        input = cache.get<int>("uniform", size, utility::tests::default_seed, utility::tests::generate_uniform<int>);
+    }
+
+    return input->data();
+}
+
+/**
+ * Concurrent sort of size random elements by the given number of threads.
+ * Speedup and efficiency are reported relative to the single thread run of the same size
+ */
+template<typename SortFunction>
+static void BM_SortScaling(benchmark::State& state, SortFunction sort_function, const std::string& name)
+{
+    const auto threads = static_cast<size_t>(state.range(0));
+    const auto size = static_cast<size_t>(state.range(1));
+    // The mapped input, the sorted data and the scratch buffer
+    if (!utility::tests::fits_in_memory(3 * size * sizeof(int)))
+    {
+        state.SkipWithError("Not enough memory for the input");
+        return;
+    }
+
+    const auto input = get_scaling_input(size);
+    std::vector<int> data(size);
+
+    double seconds = 0;
+    for (auto _: state)
+    {
+        std::memcpy(data.data(), input.data(), size * sizeof(int));
+
+        const auto start = std::chrono::steady_clock::now();
+        sort_function(data, std::pmr::get_default_resource(), threads);
+        const auto finish = std::chrono::steady_clock::now();
+
+        benchmark::DoNotOptimize(data);
+        const double iteration_seconds = std::chrono::duration<double>(finish - start).count();
+        state.SetIterationTime(iteration_seconds);
+        seconds += iteration_seconds;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.SetBytesProcessed(state.iterations() * state.range(1) * static_cast<int64_t>(sizeof(int)));
+    utility::tests::publish_scaling(state, name + "/" + std::to_string(size), threads, seconds);
+}
+
+/**
+ * A macros for sweeping thread counts of a concurrent sort. The first list of ArgsProduct varies fastest, so all
+ * thread counts of a size run together and the single thread run goes first
+ */
+#define BENCHMARK_SORT_SCALING(sort_name, sort_function)                                                               \
+    BENCHMARK_CAPTURE(BM_SortScaling, sort_name, sort_function, #sort_name)                                            \
+            ->ArgNames({ "threads", "size" })                                                                          \
+            ->ArgsProduct({ utility::tests::scaling_thread_counts(), utility::tests::scaling_sizes() })                 \
+            ->UseManualTime()                                                                                          \
+            ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_SORT_SCALING(MultithreadedMergeSort, algo::concurrent::merge_sort<std::vector<int>&>);
+BENCHMARK_SORT_SCALING(MultithreadedMergeSortAdvanced, algo::concurrent::merge_sort_advanced<std::vector<int>&>);
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <gtest/gtest.h>
 
+#include "algo/scratch_arena.h"
 #include "algo/sort.h"
 #include "utility.h"
 
@@ -192,6 +193,45 @@ INSTANTIATE_TEST_SUITE_P(MultithreadedMergeSortAdvanced, AlgoSortTest,
                                                     { algo::concurrent::merge_sort_advanced(vector); })),
                                             ::testing::ValuesIn(GetTestCases())));
 
+/** Instantiate tests for Multithreaded Merge sorts with explicit thread counts, odd counts split unevenly */
+INSTANTIATE_TEST_SUITE_P(MultithreadedMergeSortThreads, AlgoSortTest,
+                         ::testing::Combine(::testing::Values(std::function<void(std::vector<int>&)>(
+                                                    [](std::vector<int>& vector)
+                                                    {
+                                                        auto* scratch = std::pmr::get_default_resource();
+                                                        const auto input = vector;
+                                                        for (const size_t threads: { 1, 2, 3, 8 })
+                                                        {
+                                                            auto advanced = input;
+                                                            algo::concurrent::merge_sort_advanced(advanced, scratch,
+                                                                                                  threads);
+                                                            vector = input;
+                                                            algo::concurrent::merge_sort(vector, scratch, threads);
+                                                            EXPECT_EQ(vector, advanced);
+                                                        }
+                                                    })),
+                                            ::testing::ValuesIn(GetTestCases())));
+
+/** Instantiate tests for Merge sorts with the thread-local scratch arena */
+INSTANTIATE_TEST_SUITE_P(MergeSortScratchArena, AlgoSortTest,
+                         ::testing::Combine(::testing::Values(std::function<void(std::vector<int>&)>(
+                                                    [](std::vector<int>& vector)
+                                                    {
+                                                        auto& arena = algo::thread_local_scratch_arena();
+                                                        algo::merge_sort(vector, &arena);
+                                                        algo::concurrent::merge_sort(vector, &arena);
+                                                        algo::concurrent::merge_sort_advanced(vector, &arena);
+                                                    })),
+                                            ::testing::ValuesIn(GetTestCases())));
+
+TEST(AlgoSortThreadsTest, ZeroThreadsThrows)
+{
+    std::vector<int> data{ 3, 1, 2 };
+    EXPECT_THROW(algo::concurrent::merge_sort(data, std::pmr::get_default_resource(), 0), std::invalid_argument);
+    EXPECT_THROW(algo::concurrent::merge_sort_advanced(data, std::pmr::get_default_resource(), 0),
+                 std::invalid_argument);
+}
+
 
 int main(int argc, char** argv)
 {
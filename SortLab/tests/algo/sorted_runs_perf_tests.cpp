@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "algo/sorted_runs.h"
+#include "utility.h"
+
+static constexpr size_t batch_size = 1000;
+static constexpr size_t queries_per_batch = 100;
+static constexpr size_t batches_num = 100;
+
+/**
+ * Sustained workload: every iteration inserts a batch of random elements into a container
+ * of range(0) elements and then runs lower_bound queries against it.
+ * The container grows during the benchmark, so the number of iterations is fixed for all the containers
+ */
+template<typename InsertBatchFunction, typename QueryFunction, typename Container>
+static void run_insert_query_workload(benchmark::State& state, Container& container,
+                                      InsertBatchFunction insert_batch_function, QueryFunction query_function)
+{
+    std::mt19937 generator(17);
+    std::uniform_int_distribution distrib(0, 1 << 30);
+
+    std::vector<int> batch(batch_size), queries(queries_per_batch);
+    for (auto _: state)
+    {
+        // Do not measure data generation
+        state.PauseTiming();
+        std::ranges::generate(batch, [&] { return distrib(generator); });
+        std::ranges::generate(queries, [&] { return distrib(generator); });
+        state.ResumeTiming();
+
+        insert_batch_function(container, batch);
+        for (const int query: queries)
+            benchmark::DoNotOptimize(query_function(container, query));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (batch_size + queries_per_batch)));
+}
+
+static void BM_SortedRuns(benchmark::State& state)
+{
+    algo::sorted_runs<int> runs;
+    runs.insert_batch(utility::tests::generate_random_data(static_cast<size_t>(state.range(0))));
+
+    run_insert_query_workload(
+            state, runs, [](auto& container, const std::vector<int>& batch) { container.insert_batch(batch); },
+            [](auto& container, const int query) { return container.lower_bound(query); });
+}
+
+static void BM_FullResort(benchmark::State& state)
+{
+    auto data = utility::tests::generate_random_data(static_cast<size_t>(state.range(0)));
+    algo::merge_sort(data);
+
+    run_insert_query_workload(
+            state, data,
+            [](auto& container, const std::vector<int>& batch)
+            {
+                container.insert(container.end(), batch.begin(), batch.end());
+                algo::merge_sort(container);
+            },
+            [](auto& container, const int query) { return std::ranges::lower_bound(container, query); });
+}
+
+/** Sorting only the new batch and merging it in place is the best case for a single sorted vector */
+static void BM_SortBatchAndInplaceMerge(benchmark::State& state)
+{
+    auto data = utility::tests::generate_random_data(static_cast<size_t>(state.range(0)));
+    algo::merge_sort(data);
+
+    run_insert_query_workload(
+            state, data,
+            [](auto& container, const std::vector<int>& batch)
+            {
+                const auto old_size = static_cast<ptrdiff_t>(container.size());
+                container.insert(container.end(), batch.begin(), batch.end());
+                algo::merge_sort(std::ranges::subrange(container.begin() + old_size, container.end()));
+                std::inplace_merge(container.begin(), container.begin() + old_size, container.end());
+            },
+            [](auto& container, const int query) { return std::ranges::lower_bound(container, query); });
+}
+
+
+BENCHMARK(BM_SortedRuns)->RangeMultiplier(10)->Range(1e4, 1e6)->Iterations(batches_num)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FullResort)->RangeMultiplier(10)->Range(1e4, 1e6)->Iterations(batches_num)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SortBatchAndInplaceMerge)
+        ->RangeMultiplier(10)
+        ->Range(1e4, 1e6)
+        ->Iterations(batches_num)
+        ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "algo/counting_resource.h"
+#include "algo/sorted_runs.h"
+#include "utility.h"
+
+TEST(SortedRunsTest, Empty)
+{
+    algo::sorted_runs<int> runs;
+    EXPECT_TRUE(runs.empty());
+    EXPECT_EQ(runs.size(), 0);
+    EXPECT_EQ(runs.begin(), runs.end());
+    EXPECT_EQ(runs.lower_bound(0), runs.end());
+}
+
+TEST(SortedRunsTest, ZeroBufferCapacity)
+{
+    EXPECT_THROW(algo::sorted_runs<int>(0), std::invalid_argument);
+}
+
+TEST(SortedRunsTest, IterationMatchesSortedData)
+{
+    for (const auto& input: { utility::tests::generate_random_data(1e4), utility::tests::generate_sorted_data(1e4),
+                              utility::tests::generate_reversed_data(1e4),
+                              utility::tests::generate_duplicated_data(1e4) })
+    {
+        algo::sorted_runs<int> runs(64);
+        for (const int value: input)
+            runs.insert(value);
+
+        auto expected = input;
+        std::ranges::sort(expected);
+
+        EXPECT_EQ(runs.size(), input.size());
+        EXPECT_EQ(std::vector<int>(runs.begin(), runs.end()), expected);
+    }
+}
+
+TEST(SortedRunsTest, LogarithmicRunsCount)
+{
+    algo::sorted_runs<int> runs(16);
+    for (const int value: utility::tests::generate_random_data(1e5))
+    {
+        runs.insert(value);
+        // Sizes of merged runs decrease geometrically, so there are at most log2(n / capacity) + 1 of them
+        EXPECT_LE(runs.runs_count(), 14 + algo::sorted_runs<int>::max_unmerged_runs);
+    }
+
+    (void)runs.begin();
+    EXPECT_LE(runs.runs_count(), 14);
+
+    runs.compact();
+    EXPECT_EQ(runs.runs_count(), 1);
+    EXPECT_TRUE(std::ranges::is_sorted(runs));
+}
+
+TEST(SortedRunsTest, RunsAreMergedLazily)
+{
+    algo::sorted_runs<int> runs(16);
+    runs.insert_batch(utility::tests::generate_random_data(4 * 16));
+    for (const int value: utility::tests::generate_random_data(3 * 16))
+        runs.insert(value);
+    EXPECT_EQ(runs.runs_count(), 4);
+
+    // Runs of 64, 16, 16 and 16 elements are merged like binary digits before a query into 64, 32 and 16,
+    // queries work on a const multiset
+    const auto& const_runs = runs;
+    EXPECT_TRUE(std::ranges::is_sorted(const_runs));
+    EXPECT_EQ(runs.runs_count(), 3);
+    EXPECT_EQ(std::ranges::distance(const_runs.lower_bound(std::numeric_limits<int>::min()), const_runs.end()),
+              7 * 16);
+}
+
+TEST(SortedRunsTest, AllocatesFromResource)
+{
+    // Any allocation from the default resource fails
+    algo::counting_resource memory(std::pmr::new_delete_resource());
+    std::pmr::memory_resource* previous_default = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        algo::sorted_runs<int> runs(64, &memory);
+        for (const int value: utility::tests::generate_random_data(1e4))
+            runs.insert(value);
+        runs.insert_batch(utility::tests::generate_random_data(1000));
+        runs.compact();
+        EXPECT_TRUE(std::ranges::is_sorted(runs));
+    }
+    std::pmr::set_default_resource(previous_default);
+
+    EXPECT_GT(memory.stats().allocations, 0);
+    EXPECT_EQ(memory.stats().bytes_in_use, 0);
+}
+
+TEST(SortedRunsTest, LowerBoundMatchesStd)
+{
+    std::mt19937 generator(7);
+    std::uniform_int_distribution distrib(0, 5000);
+
+    algo::sorted_runs<int> runs(100);
+    std::vector<int> expected;
+
+    // Queries are interleaved with inserts, so they see both runs and pending elements
+    for (size_t batch = 0; batch < 50; ++batch)
+    {
+        for (size_t i = 0; i < 73; ++i)
+        {
+            const int value = distrib(generator);
+            runs.insert(value);
+            expected.push_back(value);
+        }
+        std::ranges::sort(expected);
+
+        for (size_t i = 0; i < 20; ++i)
+        {
+            const int query = distrib(generator);
+            const auto expected_position = std::ranges::lower_bound(expected, query);
+
+            auto position = runs.lower_bound(query);
+            EXPECT_EQ(std::vector<int>(position, runs.end()), std::vector<int>(expected_position, expected.end()));
+        }
+    }
+}
+
+TEST(SortedRunsTest, InsertBatch)
+{
+    algo::sorted_runs<int> runs(128);
+    const auto small_batch = utility::tests::generate_random_data(100);
+    const auto large_batch = utility::tests::generate_reversed_data(1000);
+
+    runs.insert_batch(small_batch);
+    runs.insert_batch(large_batch);
+    runs.insert_batch(small_batch);
+
+    std::vector<int> expected = small_batch;
+    expected.insert(expected.end(), large_batch.begin(), large_batch.end());
+    expected.insert(expected.end(), small_batch.begin(), small_batch.end());
+    std::ranges::sort(expected);
+
+    EXPECT_EQ(runs.size(), expected.size());
+    EXPECT_EQ(std::vector<int>(runs.begin(), runs.end()), expected);
+}
+
+TEST(SortedRunsTest, Strings)
+{
+    algo::sorted_runs<std::string> runs(2);
+    runs.insert_batch(std::vector<std::string>{ "pear", "apple", "fig", "kiwi", "apple" });
+
+    EXPECT_EQ(std::vector<std::string>(runs.begin(), runs.end()),
+              (std::vector<std::string>{ "apple", "apple", "fig", "kiwi", "pear" }));
+    EXPECT_EQ(*runs.lower_bound("b"), "fig");
+}
+
+TEST(SortedRunsTest, Clear)
+{
+    algo::sorted_runs<int> runs(4);
+    runs.insert_batch(utility::tests::generate_random_data(100));
+    runs.clear();
+
+    EXPECT_TRUE(runs.empty());
+    EXPECT_EQ(runs.runs_count(), 0);
+    EXPECT_EQ(runs.begin(), runs.end());
+}
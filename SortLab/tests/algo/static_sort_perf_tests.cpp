@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "algo/static_sort.h"
+
+/** Number of small arrays sorted in one iteration, so that the timer overhead is negligible */
+static constexpr size_t arrays_num = 1024;
+
+/** Random arrays are generated once, every iteration restores them by memcpy and sorts every array */
+template<size_t N, typename SortFunction>
+static void BM_SmallSort(benchmark::State& state, SortFunction sort_function)
+{
+    std::mt19937 generator(static_cast<unsigned int>(N));
+    std::uniform_int_distribution distrib;
+
+    std::vector<std::array<int, N>> source(arrays_num), arrays(arrays_num);
+    for (auto& array: source)
+        std::ranges::generate(array, [&] { return distrib(generator); });
+
+    for (auto _: state)
+    {
+        std::memcpy(arrays.data(), source.data(), arrays_num * sizeof(std::array<int, N>));
+        for (auto& array: arrays)
+            sort_function(array);
+
+        benchmark::DoNotOptimize(arrays.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * arrays_num));
+}
+
+template<size_t N>
+static void BM_StaticSort(benchmark::State& state)
+{
+    BM_SmallSort<N>(state, [](std::array<int, N>& array) { algo::static_sort(array); });
+}
+
+template<size_t N>
+static void BM_InsertionSort(benchmark::State& state)
+{
+    BM_SmallSort<N>(state, [](std::array<int, N>& array) { algo::insertion_sort(array); });
+}
+
+/** Benchmarks for every N in [MinSize, MinSize + sizeof...(Is)) are registered at compile time */
+template<size_t MinSize, size_t... Is>
+static bool register_small_sorts(std::index_sequence<Is...>)
+{
+    (benchmark::RegisterBenchmark(("BM_StaticSort/" + std::to_string(MinSize + Is)).c_str(),
+                                  BM_StaticSort<MinSize + Is>),
+     ...);
+    (benchmark::RegisterBenchmark(("BM_InsertionSort/" + std::to_string(MinSize + Is)).c_str(),
+                                  BM_InsertionSort<MinSize + Is>),
+     ...);
+
+    return true;
+}
+
+/** Arrays of 4-32 elements */
+[[maybe_unused]] static const bool small_sorts_registered = register_small_sorts<4>(std::make_index_sequence<29>{});
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+#include "algo/static_sort.h"
+
+/** By the 0-1 principle a network sorts every input if it sorts every sequence of zeros and ones */
+template<size_t N>
+static bool sorts_all_binary_sequences()
+{
+    for (size_t mask = 0; mask < (size_t{ 1 } << N); ++mask)
+    {
+        std::array<int, N> data{};
+        for (size_t i = 0; i < N; ++i)
+            data[i] = static_cast<int>((mask >> i) & 1);
+
+        algo::static_sort(data);
+        if (!std::ranges::is_sorted(data))
+            return false;
+    }
+
+    return true;
+}
+
+template<size_t N>
+static bool sorts_random_arrays()
+{
+    std::mt19937 generator(static_cast<unsigned int>(N));
+    std::uniform_int_distribution distrib(-100, 100);
+
+    for (size_t attempt = 0; attempt < 1000; ++attempt)
+    {
+        std::array<int, N> data{};
+        std::ranges::generate(data, [&] { return distrib(generator); });
+
+        auto expected = data;
+        std::ranges::sort(expected);
+
+        algo::static_sort(data);
+        if (data != expected)
+            return false;
+    }
+
+    return true;
+}
+
+template<size_t... Ns>
+static bool sorts_all_binary_sequences(std::index_sequence<Ns...>)
+{
+    return (sorts_all_binary_sequences<Ns>() && ...);
+}
+
+template<size_t... Ns>
+static bool sorts_random_arrays(std::index_sequence<Ns...>)
+{
+    return (sorts_random_arrays<Ns>() && ...);
+}
+
+TEST(StaticSortTest, NetworkSizes)
+{
+    EXPECT_EQ(algo::sorting_network<0>.size(), 0);
+    EXPECT_EQ(algo::sorting_network<1>.size(), 0);
+    EXPECT_EQ(algo::sorting_network<2>.size(), 1);
+    EXPECT_EQ(algo::sorting_network<4>.size(), 5);
+    EXPECT_EQ(algo::sorting_network<8>.size(), 19);
+    EXPECT_EQ(algo::sorting_network<16>.size(), 63);
+    EXPECT_EQ(algo::sorting_network<32>.size(), 191);
+}
+
+TEST(StaticSortTest, SortsAllBinarySequences)
+{
+    EXPECT_TRUE(sorts_all_binary_sequences(std::make_index_sequence<17>{}));
+}
+
+TEST(StaticSortTest, SortsRandomArrays)
+{
+    EXPECT_TRUE(sorts_random_arrays(std::make_index_sequence<33>{}));
+}
+
+TEST(StaticSortTest, ConstantExpression)
+{
+    constexpr auto sorted = []
+    {
+        std::array<double, 7> data{ 3.5, -1.0, 2.0, 9.0, 0.0, 2.0, -7.5 };
+        algo::static_sort(data);
+        return data;
+    }();
+
+    static_assert(std::ranges::is_sorted(sorted));
+    EXPECT_EQ(sorted, (std::array<double, 7>{ -7.5, -1.0, 0.0, 2.0, 2.0, 3.5, 9.0 }));
+}
+
+TEST(StaticSortTest, PointerAndNonArithmeticTypes)
+{
+    std::vector<std::string> data{ "pear", "apple", "fig", "kiwi", "apple", "banana" };
+
+    // Only the first 5 elements are sorted
+    algo::static_sort<5>(data.data());
+    EXPECT_EQ(data, (std::vector<std::string>{ "apple", "apple", "fig", "kiwi", "pear", "banana" }));
+}
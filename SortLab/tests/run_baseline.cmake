@@ -0,0 +1,31 @@
+# Runs the benchmark executable and saves its repetitions as <version>.json into the baseline directory.
+# The version is taken from git when the baseline is run, not when the project is configured, so every commit
+# gets its own file. Variables: BENCHMARK, SOURCE_DIR, BASELINE_DIR, BASELINE_VERSION (empty for the git version),
+# FILTER and REPETITIONS
+if (NOT BASELINE_VERSION)
+    execute_process(
+            COMMAND git describe --tags --always --dirty
+            WORKING_DIRECTORY ${SOURCE_DIR}
+            OUTPUT_VARIABLE BASELINE_VERSION
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            ERROR_QUIET
+    )
+    if (NOT BASELINE_VERSION)
+        set(BASELINE_VERSION local)
+    endif ()
+endif ()
+
+file(MAKE_DIRECTORY ${BASELINE_DIR})
+message(STATUS "Saving benchmark baseline ${BASELINE_DIR}/${BASELINE_VERSION}.json")
+
+execute_process(
+        COMMAND ${BENCHMARK}
+                --benchmark_filter=${FILTER}
+                --benchmark_repetitions=${REPETITIONS}
+                --benchmark_out=${BASELINE_DIR}/${BASELINE_VERSION}.json
+                --benchmark_out_format=json
+        RESULT_VARIABLE BENCHMARK_RESULT
+)
+if (NOT BENCHMARK_RESULT EQUAL 0)
+    message(FATAL_ERROR "Benchmarks failed: ${BENCHMARK_RESULT}")
+endif ()
@@ -0,0 +1,147 @@
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "benchmark_results.h"
+#include "json.h"
+
+TEST(JsonTest, ParsesValues)
+{
+    const auto value = sortlab::parse_json(R"( { "a": [1, -2.5e2, true, false, null], "b": { "c": "d" } } )");
+
+    const auto& array = value.find("a")->as_array();
+    ASSERT_EQ(array.size(), 5);
+    EXPECT_EQ(array[0].as_number(), 1);
+    EXPECT_EQ(array[1].as_number(), -250);
+    EXPECT_TRUE(array[2].as_bool());
+    EXPECT_FALSE(array[3].as_bool());
+    EXPECT_TRUE(array[4].is_null());
+    EXPECT_EQ(value.find("b")->find("c")->as_string(), "d");
+    EXPECT_EQ(value.find("missing"), nullptr);
+}
+
+TEST(JsonTest, ParsesEscapes)
+{
+    const auto value = sortlab::parse_json(R"("q\"b\\s\/n\nt\tu\u00e9\ud83d\ude00")");
+    EXPECT_EQ(value.as_string(), "q\"b\\s/n\nt\tu\xC3\xA9\xF0\x9F\x98\x80");
+}
+
+TEST(JsonTest, ParsesNonFiniteNumbers)
+{
+    const auto value = sortlab::parse_json("[NaN, Infinity, -Infinity]");
+    const auto& array = value.as_array();
+    EXPECT_TRUE(std::isnan(array[0].as_number()));
+    EXPECT_EQ(array[1].as_number(), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(array[2].as_number(), -std::numeric_limits<double>::infinity());
+}
+
+TEST(JsonTest, RejectsInvalidDocuments)
+{
+    for (const char* text: { "", "{", "[1,]", "{\"a\" 1}", "01", "1.", "\"abc", "tru", "[1] 2", "\"\\x\"", "-" })
+        EXPECT_THROW(sortlab::parse_json(text), std::invalid_argument) << text;
+}
+
+TEST(JsonTest, WrongTypeThrows)
+{
+    EXPECT_THROW((void)sortlab::parse_json("1").as_string(), std::invalid_argument);
+}
+
+TEST(BenchmarkResultsTest, ParsesRepetitions)
+{
+    const auto samples = sortlab::parse_benchmark_results(R"({
+        "context": { "num_cpus": 1 },
+        "benchmarks": [
+            { "name": "BM_A/10", "run_name": "BM_A/10", "run_type": "iteration", "real_time": 2.0, "time_unit": "us" },
+            { "name": "BM_A/10", "run_name": "BM_A/10", "run_type": "iteration", "real_time": 3.0, "time_unit": "us" },
+            { "name": "BM_A/10_mean", "run_name": "BM_A/10", "run_type": "aggregate", "real_time": 2.5,
+              "time_unit": "us" },
+            { "name": "BM_B", "run_name": "BM_B", "run_type": "iteration", "real_time": 1.5, "time_unit": "ms" },
+            { "name": "BM_C", "run_name": "BM_C", "run_type": "iteration", "error_occurred": true,
+              "error_message": "skipped" }
+        ]
+    })");
+
+    ASSERT_EQ(samples.size(), 2);
+    EXPECT_EQ(samples.at("BM_A/10"), (std::vector<double>{ 2000, 3000 }));
+    EXPECT_EQ(samples.at("BM_B"), (std::vector<double>{ 1.5e6 }));
+}
+
+TEST(BenchmarkResultsTest, NotBenchmarkOutputThrows)
+{
+    EXPECT_THROW(sortlab::parse_benchmark_results("{}"), std::invalid_argument);
+    EXPECT_THROW(sortlab::load_benchmark_results("missing_benchmark_results.json"), std::invalid_argument);
+}
+
+TEST(BenchmarkResultsTest, Median)
+{
+    EXPECT_EQ(sortlab::median({}), 0);
+    EXPECT_EQ(sortlab::median({ 3, 1, 2 }), 2);
+    EXPECT_EQ(sortlab::median({ 4, 1, 3, 2 }), 2.5);
+}
+
+TEST(MannWhitneyTest, ExactSeparatedSamples)
+{
+    // All 5 + 5 samples separated: 2 of C(10, 5) = 252 arrangements are as extreme
+    const std::vector<double> first{ 1, 2, 3, 4, 5 }, second{ 6, 7, 8, 9, 10 };
+    EXPECT_NEAR(sortlab::mann_whitney_p_value(first, second), 2.0 / 252, 1e-12);
+    EXPECT_NEAR(sortlab::mann_whitney_p_value(second, first), 2.0 / 252, 1e-12);
+}
+
+TEST(MannWhitneyTest, ExactInterleavedSamples)
+{
+    const std::vector<double> first{ 1, 3, 5, 7 }, second{ 2, 4, 6, 8 };
+    EXPECT_GT(sortlab::mann_whitney_p_value(first, second), 0.5);
+}
+
+TEST(MannWhitneyTest, ApproximationWithTies)
+{
+    std::vector<double> first, second;
+    for (int i = 0; i < 30; ++i)
+    {
+        first.push_back(i % 10);
+        second.push_back(i % 10 + 5);
+    }
+
+    EXPECT_LT(sortlab::mann_whitney_p_value(first, second), 1e-3);
+    EXPECT_EQ(sortlab::mann_whitney_p_value(first, first), 1);
+    EXPECT_EQ(sortlab::mann_whitney_p_value(std::vector<double>(5, 1), std::vector<double>(5, 1)), 1);
+}
+
+TEST(MannWhitneyTest, EmptySamples)
+{
+    EXPECT_EQ(sortlab::mann_whitney_p_value({}, std::vector<double>{ 1, 2 }), 1);
+}
+
+TEST(CompareBenchmarkResultsTest, Verdicts)
+{
+    const sortlab::benchmark_samples baseline{
+        { "slower", { 100, 101, 102, 103, 104 } },
+        { "faster", { 100, 101, 102, 103, 104 } },
+        { "noise", { 100, 101, 102, 103, 104 } },
+        { "small", { 100, 101, 102, 103, 104 } },
+        { "removed", { 1 } },
+    };
+    const sortlab::benchmark_samples contender{
+        { "slower", { 120, 121, 122, 123, 124 } }, { "faster", { 80, 81, 82, 83, 84 } },
+        { "noise", { 99, 102, 103, 100, 104 } },   { "small", { 105, 106, 107, 108, 109 } },
+        { "added", { 1 } },
+    };
+
+    const auto changes = sortlab::compare_benchmark_results(baseline, contender, { .threshold = 0.1, .alpha = 0.05 });
+    ASSERT_EQ(changes.size(), 4);
+
+    // Changes are ordered by names
+    EXPECT_EQ(changes[0].name, "faster");
+    EXPECT_EQ(changes[0].verdict, sortlab::change_verdict::improvement);
+    EXPECT_NEAR(changes[0].change, -20.0 / 102, 1e-12);
+
+    EXPECT_EQ(changes[1].name, "noise");
+    EXPECT_EQ(changes[1].verdict, sortlab::change_verdict::unchanged);
+
+    EXPECT_EQ(changes[2].name, "slower");
+    EXPECT_EQ(changes[2].verdict, sortlab::change_verdict::regression);
+    EXPECT_LT(changes[2].p_value, 0.05);
+
+    // Significant, but below the threshold
+    EXPECT_EQ(changes[3].name, "small");
+    EXPECT_EQ(changes[3].verdict, sortlab::change_verdict::unchanged);
+}
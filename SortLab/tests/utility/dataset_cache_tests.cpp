@@ -0,0 +1,167 @@
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "dataset_cache.h"
+
+namespace
+{
+/** Cache in a fresh temporary directory which is removed after the test */
+class DatasetCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory = std::filesystem::temp_directory_path() /
+                    ("dataset_cache_tests_" + std::to_string(getpid()) + "_" +
+                     ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    /** Uniform generator which counts its calls */
+    auto counting_generator()
+    {
+        return [this](const size_t size, const uint64_t seed)
+        {
+            generated++;
+            return utility::tests::generate_uniform<int>(size, seed);
+        };
+    }
+
+    std::filesystem::path directory;
+    size_t generated = 0;
+};
+} // namespace
+
+TEST_F(DatasetCacheTest, GeneratesOnceAndMapsLater)
+{
+    const utility::tests::dataset_cache cache(directory);
+    const auto expected = utility::tests::generate_uniform<int>(1000, 5);
+
+    {
+        const auto dataset = cache.get<int>("uniform", 1000, 5, counting_generator());
+        EXPECT_TRUE(std::ranges::equal(dataset.data(), expected));
+    }
+
+    const auto dataset = cache.get<int>("uniform", 1000, 5, counting_generator());
+    EXPECT_TRUE(std::ranges::equal(dataset.data(), expected));
+    EXPECT_EQ(generated, 1);
+    EXPECT_TRUE(std::filesystem::exists(directory / "uniform_int32_1000_5.bin"));
+}
+
+TEST_F(DatasetCacheTest, KeysAreSeparate)
+{
+    const utility::tests::dataset_cache cache(directory);
+
+    (void)cache.get<int>("uniform", 1000, 5, counting_generator());
+    (void)cache.get<int>("uniform", 1000, 6, counting_generator());
+    (void)cache.get<int>("uniform", 999, 5, counting_generator());
+    (void)cache.get<int>("other", 1000, 5, counting_generator());
+    EXPECT_EQ(generated, 4);
+
+    const auto doubles =
+            cache.get<double>("uniform", 10, 5, [](const size_t size, const uint64_t seed)
+                              { return utility::tests::generate_uniform<double>(size, seed); });
+    EXPECT_TRUE(std::ranges::equal(doubles.data(), utility::tests::generate_uniform<double>(10, 5)));
+}
+
+TEST_F(DatasetCacheTest, ParametersAreSeparateKeys)
+{
+    const utility::tests::dataset_cache cache(directory);
+    const auto zipf = [](const double exponent)
+    {
+        return [exponent](const size_t size, const uint64_t seed)
+        { return utility::tests::generate_zipf<int>(size, exponent, 0, seed); };
+    };
+
+    const auto first = cache.get<int>("zipf", "exponent=1.0", 1000, 5, zipf(1.0));
+    const auto second = cache.get<int>("zipf", "exponent=1.5", 1000, 5, zipf(1.5));
+    EXPECT_TRUE(std::ranges::equal(first.data(), utility::tests::generate_zipf<int>(1000, 1.0, 0, 5)));
+    EXPECT_TRUE(std::ranges::equal(second.data(), utility::tests::generate_zipf<int>(1000, 1.5, 0, 5)));
+    EXPECT_TRUE(std::filesystem::exists(directory / "zipf_int32_1000_5_exponent=1.5.bin"));
+
+    EXPECT_THROW((void)cache.get<int>("zipf", "exponent/1.5", 10, 1, zipf(1.5)), std::invalid_argument);
+}
+
+TEST_F(DatasetCacheTest, NoTemporaryFilesAreLeft)
+{
+    const utility::tests::dataset_cache cache(directory);
+    (void)cache.get<int>("uniform", 100, 1, counting_generator());
+
+    const auto files = std::distance(std::filesystem::directory_iterator(directory), {});
+    EXPECT_EQ(files, 1);
+    EXPECT_EQ(std::filesystem::status(directory / "uniform_int32_100_1.bin").permissions() &
+                      std::filesystem::perms::others_read,
+              std::filesystem::perms::others_read);
+}
+
+TEST_F(DatasetCacheTest, ChangesAreCopyOnWrite)
+{
+    const utility::tests::dataset_cache cache(directory);
+
+    {
+        const auto dataset = cache.get<int>("uniform", 100, 1, counting_generator());
+        std::ranges::fill(dataset.data(), 0);
+    }
+
+    const auto dataset = cache.get<int>("uniform", 100, 1, counting_generator());
+    EXPECT_TRUE(std::ranges::equal(dataset.data(), utility::tests::generate_uniform<int>(100, 1)));
+    EXPECT_EQ(generated, 1);
+}
+
+TEST_F(DatasetCacheTest, CorruptedHeaderIsRegenerated)
+{
+    const utility::tests::dataset_cache cache(directory);
+    (void)cache.get<int>("uniform", 100, 1, counting_generator());
+
+    {
+        std::fstream file(directory / "uniform_int32_100_1.bin", std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(9);
+        file.put('x');
+    }
+
+    const auto dataset = cache.get<int>("uniform", 100, 1, counting_generator());
+    EXPECT_TRUE(std::ranges::equal(dataset.data(), utility::tests::generate_uniform<int>(100, 1)));
+    EXPECT_EQ(generated, 2);
+}
+
+TEST_F(DatasetCacheTest, TruncatedFileIsRegenerated)
+{
+    const utility::tests::dataset_cache cache(directory);
+    (void)cache.get<int>("uniform", 100, 1, counting_generator());
+
+    std::filesystem::resize_file(directory / "uniform_int32_100_1.bin", 200);
+
+    (void)cache.get<int>("uniform", 100, 1, counting_generator());
+    EXPECT_EQ(generated, 2);
+}
+
+TEST_F(DatasetCacheTest, EmptyDataset)
+{
+    const utility::tests::dataset_cache cache(directory);
+    EXPECT_TRUE(cache.get<int>("uniform", 0, 1, counting_generator()).data().empty());
+}
+
+TEST_F(DatasetCacheTest, InvalidArguments)
+{
+    const utility::tests::dataset_cache cache(directory);
+
+    EXPECT_THROW((void)cache.get<int>("../uniform", 10, 1, counting_generator()), std::invalid_argument);
+    EXPECT_THROW((void)cache.get<int>("", 10, 1, counting_generator()), std::invalid_argument);
+    EXPECT_THROW((void)cache.get<int>("short", 10, 1,
+                                      [](const size_t, const uint64_t) { return std::vector<int>(5); }),
+                 std::invalid_argument);
+}
+
+TEST(DatasetValueTypeTest, Names)
+{
+    EXPECT_EQ(utility::tests::value_type_name<int8_t>(), "int8");
+    EXPECT_EQ(utility::tests::value_type_name<uint64_t>(), "uint64");
+    EXPECT_EQ(utility::tests::value_type_name<float>(), "float32");
+    EXPECT_EQ(utility::tests::value_type_name<double>(), "float64");
+}
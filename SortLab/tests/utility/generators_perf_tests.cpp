@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "generators.h"
+#include "utility.h"
+
+/** Generation of random data with the shared std::mt19937, one thread */
+static void BM_GenerateRandomData(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+
+    for (auto _: state)
+        benchmark::DoNotOptimize(utility::tests::generate_random_data(size));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/** Generation of random data with the counter-based generator on all hardware threads */
+template<typename DataGenerator>
+static void BM_Generate(benchmark::State& state, DataGenerator data_generator)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+
+    for (auto _: state)
+        benchmark::DoNotOptimize(data_generator(size));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static std::vector<int> generate_uniform_data(const size_t size)
+{
+    return utility::tests::generate_uniform<int>(size);
+}
+
+static std::vector<int> generate_zipf_data(const size_t size)
+{
+    return utility::tests::generate_zipf<int>(size);
+}
+
+static std::vector<double> generate_gaussian_data(const size_t size)
+{
+    return utility::tests::generate_gaussian<double>(size, 0, 1);
+}
+
+BENCHMARK(BM_GenerateRandomData)->RangeMultiplier(100)->Range(1e4, 1e8)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Generate, Uniform, generate_uniform_data)
+        ->RangeMultiplier(100)
+        ->Range(1e4, 1e8)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Generate, Zipf, generate_zipf_data)
+        ->RangeMultiplier(100)
+        ->Range(1e4, 1e8)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Generate, Gaussian, generate_gaussian_data)
+        ->RangeMultiplier(100)
+        ->Range(1e4, 1e8)
+        ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numeric>
+
+#include "algo/sort.h"
+#include "generators.h"
+#include "utility.h"
+
+TEST(CounterRngTest, DeterministicPerSeed)
+{
+    const utility::tests::counter_rng first(1), same(1), other(2);
+
+    EXPECT_EQ(first.bits(42), same.bits(42));
+    EXPECT_NE(first.bits(42), other.bits(42));
+    EXPECT_NE(first.bits(42), first.bits(43));
+
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        EXPECT_GT(first.uniform(i), 0);
+        EXPECT_LT(first.uniform(i), 1);
+    }
+}
+
+TEST(CounterRngTest, MatchesSplitMix64)
+{
+    // First outputs of the reference SplitMix64 for the seed 0
+    const utility::tests::counter_rng rng(0);
+    EXPECT_EQ(rng.bits(0), 0xE220A8397B1DCDAF);
+    EXPECT_EQ(rng.bits(1), 0x6E789E6AA1B965F4);
+}
+
+TEST(GeneratorsTest, ParallelGenerationDoesNotDependOnThreads)
+{
+    static constexpr size_t size = 300'000;
+    const utility::tests::counter_rng rng(7);
+
+    std::vector<uint64_t> single(size), several(size);
+    utility::tests::parallel_generate(std::span(single), [rng](const size_t i) { return rng.bits(i); }, 1);
+    utility::tests::parallel_generate(std::span(several), [rng](const size_t i) { return rng.bits(i); }, 5);
+
+    EXPECT_EQ(single, several);
+}
+
+TEST(GeneratorsTest, Uniform)
+{
+    EXPECT_EQ(utility::tests::generate_uniform<int>(1000, 5), utility::tests::generate_uniform<int>(1000, 5));
+    EXPECT_NE(utility::tests::generate_uniform<int>(1000, 5), utility::tests::generate_uniform<int>(1000, 6));
+
+    const auto data = utility::tests::generate_uniform<double>(100'000);
+    EXPECT_NEAR(std::accumulate(data.begin(), data.end(), 0.0) / static_cast<double>(data.size()), 0.5, 0.01);
+    EXPECT_TRUE(std::ranges::all_of(data, [](const double value) { return value > 0 && value < 1; }));
+
+    const auto floats = utility::tests::generate_uniform<float>(1'000'000);
+    EXPECT_NEAR(std::accumulate(floats.begin(), floats.end(), 0.0) / static_cast<double>(floats.size()), 0.5, 0.01);
+    EXPECT_TRUE(std::ranges::all_of(floats, [](const float value) { return value >= 0 && value < 1; }));
+}
+
+TEST(GeneratorsTest, Zipf)
+{
+    static constexpr size_t size = 100'000;
+    const auto data = utility::tests::generate_zipf<int>(size, 1.0, 1000);
+
+    EXPECT_TRUE(std::ranges::all_of(data, [](const int value) { return value >= 1 && value <= 1000; }));
+
+    // P(1) = 1 / H(1000) ~ 0.134, P(2) = P(1) / 2
+    const auto ones = static_cast<double>(std::ranges::count(data, 1)) / size;
+    const auto twos = static_cast<double>(std::ranges::count(data, 2)) / size;
+    EXPECT_NEAR(ones, 0.134, 0.01);
+    EXPECT_NEAR(twos, 0.067, 0.01);
+
+    EXPECT_THROW(utility::tests::generate_zipf<int>(size, 0), std::invalid_argument);
+}
+
+TEST(GeneratorsTest, Gaussian)
+{
+    const auto data = utility::tests::generate_gaussian<double>(100'000, 10, 2);
+
+    const double mean = std::accumulate(data.begin(), data.end(), 0.0) / static_cast<double>(data.size());
+    double variance = 0;
+    for (const double value: data)
+        variance += (value - mean) * (value - mean);
+    variance /= static_cast<double>(data.size());
+
+    EXPECT_NEAR(mean, 10, 0.05);
+    EXPECT_NEAR(std::sqrt(variance), 2, 0.05);
+
+    // Integers are clamped to the range of the type
+    const auto bytes = utility::tests::generate_gaussian<uint8_t>(1000, 0, 1000);
+    EXPECT_TRUE(std::ranges::any_of(bytes, [](const uint8_t value) { return value == 0; }));
+    EXPECT_TRUE(std::ranges::any_of(bytes, [](const uint8_t value) { return value == 255; }));
+}
+
+TEST(GeneratorsTest, OrganPipe)
+{
+    EXPECT_EQ(utility::tests::generate_organ_pipe<int>(7), (std::vector<int>{ 0, 1, 2, 3, 2, 1, 0 }));
+    EXPECT_EQ(utility::tests::generate_organ_pipe<int>(6), (std::vector<int>{ 0, 1, 2, 2, 1, 0 }));
+}
+
+TEST(GeneratorsTest, Sawtooth)
+{
+    EXPECT_EQ(utility::tests::generate_sawtooth<float>(7, 3), (std::vector<float>{ 0, 1, 2, 0, 1, 2, 0 }));
+    EXPECT_THROW(utility::tests::generate_sawtooth<int>(7, 0), std::invalid_argument);
+}
+
+TEST(GeneratorsTest, SortedRuns)
+{
+    EXPECT_EQ(utility::tests::generate_sorted_runs<int>(6, 2), (std::vector<int>{ 0, 2, 4, 1, 3, 5 }));
+
+    static constexpr size_t size = 10'000, runs = 8;
+    auto data = utility::tests::generate_sorted_runs<int>(size, runs);
+    for (size_t run = 0; run < runs; ++run)
+    {
+        const auto begin = data.begin() + static_cast<std::ptrdiff_t>(run * size / runs);
+        EXPECT_TRUE(std::is_sorted(begin, begin + size / runs));
+    }
+
+    std::ranges::sort(data);
+    EXPECT_EQ(data, utility::tests::generate_sorted_data(size));
+}
+
+TEST(GeneratorsTest, FewUnique)
+{
+    const auto data = utility::tests::generate_few_unique<int64_t>(10'000, 5);
+
+    std::vector<int64_t> unique = data;
+    std::ranges::sort(unique);
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    EXPECT_EQ(unique, (std::vector<int64_t>{ 0, 1, 2, 3, 4 }));
+}
+
+TEST(GeneratorsTest, MedianOf3Killer)
+{
+    // Musser's sequence for k = 4
+    EXPECT_EQ(utility::tests::generate_median_of_3_killer<int>(8), (std::vector<int>{ 1, 5, 3, 7, 2, 4, 6, 8 }));
+
+    for (const size_t size: { 0, 1, 5, 10, 1001 })
+    {
+        auto data = utility::tests::generate_median_of_3_killer<int>(size);
+        algo::merge_sort(data);
+
+        std::vector<int> expected(size);
+        std::iota(expected.begin(), expected.end(), 1);
+        EXPECT_EQ(data, expected) << "size: " << size;
+    }
+}
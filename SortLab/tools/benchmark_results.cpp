@@ -0,0 +1,218 @@
+#include "benchmark_results.h"
+
+#include "json.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace sortlab
+{
+namespace
+{
+double nanoseconds_per_unit(const std::string& unit)
+{
+    if (unit == "ns")
+        return 1;
+    if (unit == "us")
+        return 1e3;
+    if (unit == "ms")
+        return 1e6;
+    if (unit == "s")
+        return 1e9;
+
+    throw std::invalid_argument("Unknown benchmark time unit: " + unit);
+}
+
+/**
+ * Number of arrangements of first_size and second_size elements with the given U statistic for all U,
+ * counts[u] for u in [0, first_size * second_size]. Recurrence on the largest element:
+ * N(m, n, u) = N(m - 1, n, u - n) + N(m, n - 1, u)
+ */
+std::vector<double> mann_whitney_distribution(const size_t first_size, const size_t second_size)
+{
+    const size_t max_u = first_size * second_size;
+    // counts[n][u] for the current m
+    std::vector<std::vector<double>> counts(second_size + 1, std::vector<double>(max_u + 1, 0));
+    for (size_t n = 0; n <= second_size; ++n)
+        counts[n][0] = 1;
+
+    for (size_t m = 1; m <= first_size; ++m)
+    {
+        std::vector<std::vector<double>> next(second_size + 1, std::vector<double>(max_u + 1, 0));
+        next[0][0] = 1;
+        for (size_t n = 1; n <= second_size; ++n)
+        {
+            for (size_t u = 0; u <= m * n; ++u)
+                next[n][u] = (u >= n ? counts[n][u - n] : 0) + next[n - 1][u];
+        }
+        counts = std::move(next);
+    }
+
+    return counts[second_size];
+}
+
+/** Exact distribution is computed for up to this number of samples on each side */
+constexpr size_t max_exact_size = 20;
+} // namespace
+
+benchmark_samples parse_benchmark_results(const std::string_view json)
+{
+    const json_value document = parse_json(json);
+    const json_value* benchmarks = document.find("benchmarks");
+    if (benchmarks == nullptr)
+        throw std::invalid_argument("Not a Google Benchmark JSON output: there is no benchmarks array");
+
+    benchmark_samples samples;
+    for (const auto& run: benchmarks->as_array())
+    {
+        const json_value* run_type = run.find("run_type");
+        if (run_type != nullptr && run_type->as_string() != "iteration")
+            continue;
+
+        const json_value* error = run.find("error_occurred");
+        if (error != nullptr && error->as_bool())
+            continue;
+
+        // Repetitions of the same benchmark share the run name
+        const json_value* name = run.find("run_name");
+        if (name == nullptr)
+            name = run.find("name");
+
+        const json_value* real_time = run.find("real_time");
+        const json_value* time_unit = run.find("time_unit");
+        if (name == nullptr || real_time == nullptr)
+            throw std::invalid_argument("Benchmark run has no name or real time");
+
+        const double unit = time_unit != nullptr ? nanoseconds_per_unit(time_unit->as_string()) : 1;
+        samples[name->as_string()].push_back(real_time->as_number() * unit);
+    }
+
+    return samples;
+}
+
+benchmark_samples load_benchmark_results(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::invalid_argument("Cannot read benchmark results " + path.string());
+
+    std::ostringstream content;
+    content << file.rdbuf();
+
+    return parse_benchmark_results(content.str());
+}
+
+double median(std::vector<double> samples)
+{
+    if (samples.empty())
+        return 0;
+
+    const size_t mid = samples.size() / 2;
+    std::ranges::nth_element(samples, samples.begin() + static_cast<std::ptrdiff_t>(mid));
+    if (samples.size() % 2 == 1)
+        return samples[mid];
+
+    const double upper = samples[mid];
+    const double lower = *std::max_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(mid));
+    return (lower + upper) / 2;
+}
+
+double mann_whitney_p_value(const std::span<const double> first, const std::span<const double> second)
+{
+    if (first.empty() || second.empty())
+        return 1;
+
+    // U statistic of the first sample: pairs where the first element is greater, ties count as halves
+    double u = 0;
+    for (const double x: first)
+    {
+        for (const double y: second)
+            u += x > y ? 1 : (x == y ? 0.5 : 0);
+    }
+
+    std::vector<double> all(first.begin(), first.end());
+    all.insert(all.end(), second.begin(), second.end());
+    std::ranges::sort(all);
+
+    // Sum of t^3 - t over groups of t tied values
+    double ties = 0;
+    for (size_t i = 0; i < all.size();)
+    {
+        size_t j = i + 1;
+        while (j < all.size() && all[j] == all[i])
+            j++;
+
+        const auto tied = static_cast<double>(j - i);
+        ties += tied * tied * tied - tied;
+        i = j;
+    }
+
+    const auto m = static_cast<double>(first.size()), n = static_cast<double>(second.size());
+    const double mean = m * n / 2;
+
+    if (ties == 0 && first.size() <= max_exact_size && second.size() <= max_exact_size)
+    {
+        const auto counts = mann_whitney_distribution(first.size(), second.size());
+        const auto observed = static_cast<size_t>(u);
+        assert(observed < counts.size());
+
+        // The distribution is symmetric, so the two-sided p-value is twice the smaller tail
+        const size_t tail_end = std::min(observed, counts.size() - 1 - observed);
+        double tail = 0, total = 0;
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            total += counts[i];
+            if (i <= tail_end)
+                tail += counts[i];
+        }
+
+        return std::min(1.0, 2 * tail / total);
+    }
+
+    const double total = m + n;
+    const double variance = m * n / 12 * ((total + 1) - ties / (total * (total - 1)));
+    if (variance <= 0)
+        return 1;
+
+    const double z = std::max(0.0, std::abs(u - mean) - 0.5) / std::sqrt(variance);
+    return std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+}
+
+std::vector<benchmark_change> compare_benchmark_results(const benchmark_samples& baseline,
+                                                        const benchmark_samples& contender,
+                                                        const comparison_options& options)
+{
+    std::vector<benchmark_change> changes;
+
+    for (const auto& [name, baseline_samples]: baseline)
+    {
+        const auto it = contender.find(name);
+        if (it == contender.end())
+            continue;
+
+        const auto& contender_samples = it->second;
+
+        benchmark_change change;
+        change.name = name;
+        change.baseline_median = median(baseline_samples);
+        change.contender_median = median(contender_samples);
+        change.change = change.baseline_median > 0
+                                ? (change.contender_median - change.baseline_median) / change.baseline_median
+                                : 0;
+        change.p_value = mann_whitney_p_value(baseline_samples, contender_samples);
+
+        if (change.p_value < options.alpha && change.change > options.threshold)
+            change.verdict = change_verdict::regression;
+        else if (change.p_value < options.alpha && change.change < -options.threshold)
+            change.verdict = change_verdict::improvement;
+
+        changes.push_back(std::move(change));
+    }
+
+    return changes;
+}
+} // namespace sortlab
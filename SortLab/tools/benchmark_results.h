@@ -0,0 +1,63 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sortlab
+{
+/** Real time samples in nanoseconds per benchmark run name, one sample per repetition */
+using benchmark_samples = std::map<std::string, std::vector<double>>;
+
+/**
+ * Reads iteration runs from Google Benchmark JSON output (--benchmark_out_format=json).
+ * Aggregates (mean, median, ...) and runs with errors are skipped, because comparison needs raw repetitions
+ */
+benchmark_samples parse_benchmark_results(std::string_view json);
+
+/** Throws std::invalid_argument if the file cannot be read or it is not Google Benchmark JSON output */
+benchmark_samples load_benchmark_results(const std::filesystem::path& path);
+
+double median(std::vector<double> samples);
+
+/**
+ * Two-sided p-value of the Mann-Whitney U test for the hypothesis that both samples come from the same
+ * distribution. It is exact for small samples without ties and uses the normal approximation with the tie
+ * and continuity corrections otherwise. At least 4 samples on each side are needed to get p < 0.05
+ */
+double mann_whitney_p_value(std::span<const double> first, std::span<const double> second);
+
+enum class change_verdict
+{
+    unchanged,
+    improvement,
+    regression
+};
+
+struct comparison_options
+{
+    /** Minimal relative change of the median time to report, smaller significant changes are ignored */
+    double threshold = 0.05;
+    /** Significance level of the Mann-Whitney U test */
+    double alpha = 0.05;
+};
+
+struct benchmark_change
+{
+    std::string name;
+    double baseline_median = 0;
+    double contender_median = 0;
+    /** Relative change of the median time: (contender - baseline) / baseline */
+    double change = 0;
+    double p_value = 1;
+    change_verdict verdict = change_verdict::unchanged;
+};
+
+/** Compares benchmarks which are present in both results, in the order of names */
+std::vector<benchmark_change> compare_benchmark_results(const benchmark_samples& baseline,
+                                                        const benchmark_samples& contender,
+                                                        const comparison_options& options = {});
+} // namespace sortlab
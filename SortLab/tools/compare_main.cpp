@@ -0,0 +1,136 @@
+#include "benchmark_results.h"
+
+#include <charconv>
+#include <exception>
+#include <optional>
+#include <print>
+#include <string_view>
+
+namespace
+{
+/** Exit codes: regressions are separated from usage and input errors for scripts */
+constexpr int no_regressions_code = 0;
+constexpr int regressions_code = 1;
+constexpr int error_code = 2;
+
+struct options
+{
+    std::string_view baseline_path;
+    std::string_view contender_path;
+    sortlab::comparison_options comparison;
+};
+
+void print_usage()
+{
+    std::println(stderr, "Usage: SortLab_Compare <baseline.json> <contender.json> [--threshold 0.05] [--alpha 0.05]");
+    std::println(stderr, "Compares repetitions of Google Benchmark runs (--benchmark_repetitions=N, N >= 5 is"
+                         " recommended) with the Mann-Whitney U test and exits with {} if any benchmark regressed",
+                 regressions_code);
+}
+
+bool parse_fraction(const std::string_view value, double& result)
+{
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    return error == std::errc() && end == value.data() + value.size() && result >= 0 && result < 1;
+}
+
+std::optional<options> parse_options(const int argc, char** argv)
+{
+    options result;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (!argument.starts_with("--"))
+        {
+            if (result.baseline_path.empty())
+                result.baseline_path = argument;
+            else if (result.contender_path.empty())
+                result.contender_path = argument;
+            else
+                return std::nullopt;
+            continue;
+        }
+
+        if (i + 1 == argc)
+            return std::nullopt;
+        const std::string_view value = argv[++i];
+
+        if (argument == "--threshold" && parse_fraction(value, result.comparison.threshold))
+            continue;
+        if (argument == "--alpha" && parse_fraction(value, result.comparison.alpha))
+            continue;
+
+        return std::nullopt;
+    }
+
+    if (result.baseline_path.empty() || result.contender_path.empty())
+        return std::nullopt;
+
+    return result;
+}
+
+std::string_view verdict_name(const sortlab::change_verdict verdict)
+{
+    switch (verdict)
+    {
+    case sortlab::change_verdict::improvement:
+        return "improvement";
+    case sortlab::change_verdict::regression:
+        return "REGRESSION";
+    default:
+        return "";
+    }
+}
+
+/** Benchmarks which are present in only one of the results are listed, but they do not fail the comparison */
+void print_missing(const sortlab::benchmark_samples& results, const sortlab::benchmark_samples& other,
+                   const std::string_view description)
+{
+    for (const auto& [name, samples]: results)
+    {
+        if (!other.contains(name))
+            std::println("{:<80} only in {}", name, description);
+    }
+}
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    const auto options = parse_options(argc, argv);
+    if (!options)
+    {
+        print_usage();
+        return error_code;
+    }
+
+    try
+    {
+        const auto baseline = sortlab::load_benchmark_results(options->baseline_path);
+        const auto contender = sortlab::load_benchmark_results(options->contender_path);
+
+        const auto changes = sortlab::compare_benchmark_results(baseline, contender, options->comparison);
+
+        std::println("{:<80}{:>14}{:>14}{:>9}{:>9}", "Benchmark", "Baseline, ns", "Contender, ns", "Change", "p");
+        size_t regressions = 0;
+        for (const auto& change: changes)
+        {
+            std::println("{:<80}{:>14.1f}{:>14.1f}{:>8.1f}%{:>9.4f} {}", change.name, change.baseline_median,
+                         change.contender_median, change.change * 100, change.p_value, verdict_name(change.verdict));
+
+            if (change.verdict == sortlab::change_verdict::regression)
+                regressions++;
+        }
+
+        print_missing(baseline, contender, "baseline");
+        print_missing(contender, baseline, "contender");
+
+        std::println("{} benchmarks compared, {} regressions", changes.size(), regressions);
+        return regressions == 0 ? no_regressions_code : regressions_code;
+    }
+    catch (const std::exception& exception)
+    {
+        std::println(stderr, "Error: {}", exception.what());
+        return error_code;
+    }
+}
@@ -0,0 +1,417 @@
+#include "json.h"
+
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace sortlab
+{
+json_value::json_value(const bool value) : _value(value) {}
+
+json_value::json_value(const double value) : _value(value) {}
+
+json_value::json_value(std::string value) : _value(std::move(value)) {}
+
+json_value::json_value(array value) : _value(std::move(value)) {}
+
+json_value::json_value(object value) : _value(std::move(value)) {}
+
+bool json_value::is_null() const
+{
+    return std::holds_alternative<std::nullptr_t>(_value);
+}
+
+bool json_value::is_bool() const
+{
+    return std::holds_alternative<bool>(_value);
+}
+
+bool json_value::is_number() const
+{
+    return std::holds_alternative<double>(_value);
+}
+
+bool json_value::is_string() const
+{
+    return std::holds_alternative<std::string>(_value);
+}
+
+bool json_value::is_array() const
+{
+    return std::holds_alternative<array>(_value);
+}
+
+bool json_value::is_object() const
+{
+    return std::holds_alternative<object>(_value);
+}
+
+bool json_value::as_bool() const
+{
+    if (!is_bool())
+        throw std::invalid_argument("JSON value is not a boolean");
+    return std::get<bool>(_value);
+}
+
+double json_value::as_number() const
+{
+    if (!is_number())
+        throw std::invalid_argument("JSON value is not a number");
+    return std::get<double>(_value);
+}
+
+const std::string& json_value::as_string() const
+{
+    if (!is_string())
+        throw std::invalid_argument("JSON value is not a string");
+    return std::get<std::string>(_value);
+}
+
+const json_value::array& json_value::as_array() const
+{
+    if (!is_array())
+        throw std::invalid_argument("JSON value is not an array");
+    return std::get<array>(_value);
+}
+
+const json_value::object& json_value::as_object() const
+{
+    if (!is_object())
+        throw std::invalid_argument("JSON value is not an object");
+    return std::get<object>(_value);
+}
+
+const json_value* json_value::find(const std::string_view key) const
+{
+    if (!is_object())
+        return nullptr;
+
+    for (const auto& [name, value]: std::get<object>(_value))
+    {
+        if (name == key)
+            return &value;
+    }
+
+    return nullptr;
+}
+
+namespace
+{
+/** Recursive descent parser, nesting depth is limited to protect the stack from malicious documents */
+class json_parser final
+{
+public:
+    explicit json_parser(const std::string_view text) : _text(text) {}
+
+    json_value parse_document()
+    {
+        json_value value = parse_value(0);
+        skip_whitespace();
+        if (_position != _text.size())
+            fail("unexpected characters after the document");
+
+        return value;
+    }
+
+private:
+    static constexpr size_t max_depth = 512;
+
+    [[noreturn]] void fail(const std::string& message) const
+    {
+        throw std::invalid_argument("Invalid JSON at offset " + std::to_string(_position) + ": " + message);
+    }
+
+    void skip_whitespace()
+    {
+        while (_position < _text.size() && (_text[_position] == ' ' || _text[_position] == '\t' ||
+                                            _text[_position] == '\n' || _text[_position] == '\r'))
+            _position++;
+    }
+
+    char peek()
+    {
+        skip_whitespace();
+        if (_position == _text.size())
+            fail("unexpected end of the document");
+
+        return _text[_position];
+    }
+
+    void expect(const char symbol)
+    {
+        if (peek() != symbol)
+            fail(std::string("expected '") + symbol + "'");
+        _position++;
+    }
+
+    void expect_literal(const std::string_view literal)
+    {
+        if (_text.substr(_position, literal.size()) != literal)
+            fail("unknown literal");
+        _position += literal.size();
+    }
+
+    json_value parse_value(const size_t depth)
+    {
+        if (depth > max_depth)
+            fail("too deep nesting");
+
+        switch (peek())
+        {
+        case '{':
+            return parse_object(depth);
+        case '[':
+            return parse_array(depth);
+        case '"':
+            return json_value(parse_string());
+        case 't':
+            expect_literal("true");
+            return json_value(true);
+        case 'f':
+            expect_literal("false");
+            return json_value(false);
+        case 'n':
+            expect_literal("null");
+            return {};
+        case 'N':
+        case 'I':
+            return json_value(parse_non_finite(1));
+        default:
+            return json_value(parse_number());
+        }
+    }
+
+    json_value parse_object(const size_t depth)
+    {
+        expect('{');
+
+        json_value::object members;
+        if (peek() == '}')
+        {
+            _position++;
+            return json_value(std::move(members));
+        }
+
+        while (true)
+        {
+            if (peek() != '"')
+                fail("expected a member name");
+            std::string name = parse_string();
+            expect(':');
+            members.emplace_back(std::move(name), parse_value(depth + 1));
+
+            if (peek() == '}')
+            {
+                _position++;
+                return json_value(std::move(members));
+            }
+            expect(',');
+        }
+    }
+
+    json_value parse_array(const size_t depth)
+    {
+        expect('[');
+
+        json_value::array elements;
+        if (peek() == ']')
+        {
+            _position++;
+            return json_value(std::move(elements));
+        }
+
+        while (true)
+        {
+            elements.push_back(parse_value(depth + 1));
+
+            if (peek() == ']')
+            {
+                _position++;
+                return json_value(std::move(elements));
+            }
+            expect(',');
+        }
+    }
+
+    uint32_t parse_hex4()
+    {
+        if (_position + 4 > _text.size())
+            fail("truncated unicode escape");
+
+        uint32_t code = 0;
+        const auto [end, error] = std::from_chars(_text.data() + _position, _text.data() + _position + 4, code, 16);
+        if (error != std::errc() || end != _text.data() + _position + 4)
+            fail("invalid unicode escape");
+        _position += 4;
+
+        return code;
+    }
+
+    static void append_utf8(std::string& result, const uint32_t code)
+    {
+        if (code < 0x80)
+            result += static_cast<char>(code);
+        else if (code < 0x800)
+        {
+            result += static_cast<char>(0xC0 | (code >> 6));
+            result += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000)
+        {
+            result += static_cast<char>(0xE0 | (code >> 12));
+            result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            result += static_cast<char>(0xF0 | (code >> 18));
+            result += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    uint32_t parse_code_point()
+    {
+        const uint32_t code = parse_hex4();
+        if (code < 0xD800 || code > 0xDBFF)
+            return code;
+
+        // A high surrogate must be followed by an escaped low surrogate
+        if (_text.substr(_position, 2) != "\\u")
+            fail("unpaired surrogate");
+        _position += 2;
+
+        const uint32_t low = parse_hex4();
+        if (low < 0xDC00 || low > 0xDFFF)
+            fail("invalid low surrogate");
+
+        return 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    std::string parse_string()
+    {
+        expect('"');
+
+        std::string result;
+        while (true)
+        {
+            if (_position == _text.size())
+                fail("unterminated string");
+
+            const char symbol = _text[_position++];
+            if (symbol == '"')
+                return result;
+            if (static_cast<unsigned char>(symbol) < 0x20)
+                fail("control character in a string");
+            if (symbol != '\\')
+            {
+                result += symbol;
+                continue;
+            }
+
+            if (_position == _text.size())
+                fail("unterminated escape");
+
+            switch (const char escaped = _text[_position++])
+            {
+            case '"':
+            case '\\':
+            case '/':
+                result += escaped;
+                break;
+            case 'b':
+                result += '\b';
+                break;
+            case 'f':
+                result += '\f';
+                break;
+            case 'n':
+                result += '\n';
+                break;
+            case 'r':
+                result += '\r';
+                break;
+            case 't':
+                result += '\t';
+                break;
+            case 'u':
+                append_utf8(result, parse_code_point());
+                break;
+            default:
+                fail("unknown escape");
+            }
+        }
+    }
+
+    /** Google Benchmark writes non-finite counters as NaN and Infinity, which is not standard JSON */
+    double parse_non_finite(const double sign)
+    {
+        if (_text[_position] == 'N')
+        {
+            expect_literal("NaN");
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        expect_literal("Infinity");
+        return sign * std::numeric_limits<double>::infinity();
+    }
+
+    double parse_number()
+    {
+        const size_t start = _position;
+        if (_position < _text.size() && _text[_position] == '-')
+        {
+            _position++;
+            if (_position < _text.size() && (_text[_position] == 'N' || _text[_position] == 'I'))
+                return parse_non_finite(-1);
+        }
+
+        // Strict JSON grammar: no leading zeros, no leading '+' or '.', digits after '.' and exponent
+        const auto skip_digits = [this]
+        {
+            const size_t digits_start = _position;
+            while (_position < _text.size() && _text[_position] >= '0' && _text[_position] <= '9')
+                _position++;
+            if (_position == digits_start)
+                fail("expected a digit");
+        };
+
+        if (_position < _text.size() && _text[_position] == '0')
+            _position++;
+        else
+            skip_digits();
+
+        if (_position < _text.size() && _text[_position] == '.')
+        {
+            _position++;
+            skip_digits();
+        }
+
+        if (_position < _text.size() && (_text[_position] == 'e' || _text[_position] == 'E'))
+        {
+            _position++;
+            if (_position < _text.size() && (_text[_position] == '+' || _text[_position] == '-'))
+                _position++;
+            skip_digits();
+        }
+
+        double value = 0;
+        const auto [end, error] = std::from_chars(_text.data() + start, _text.data() + _position, value);
+        if (error == std::errc::invalid_argument || end != _text.data() + _position)
+            fail("invalid number");
+
+        return value;
+    }
+
+    std::string_view _text;
+    size_t _position = 0;
+};
+} // namespace
+
+json_value parse_json(const std::string_view text)
+{
+    return json_parser(text).parse_document();
+}
+} // namespace sortlab
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace sortlab
+{
+/** JSON value: null, boolean, number, string, array or object. Object members keep the document order */
+class json_value final
+{
+public:
+    using array = std::vector<json_value>;
+    using object = std::vector<std::pair<std::string, json_value>>;
+
+    json_value() = default;
+    explicit json_value(bool value);
+    explicit json_value(double value);
+    explicit json_value(std::string value);
+    explicit json_value(array value);
+    explicit json_value(object value);
+
+    [[nodiscard]] bool is_null() const;
+    [[nodiscard]] bool is_bool() const;
+    [[nodiscard]] bool is_number() const;
+    [[nodiscard]] bool is_string() const;
+    [[nodiscard]] bool is_array() const;
+    [[nodiscard]] bool is_object() const;
+
+    /** Accessors throw std::invalid_argument if the value has another type */
+    [[nodiscard]] bool as_bool() const;
+    [[nodiscard]] double as_number() const;
+    [[nodiscard]] const std::string& as_string() const;
+    [[nodiscard]] const array& as_array() const;
+    [[nodiscard]] const object& as_object() const;
+
+    /** Returns the first object member with the key, nullptr if there is no such member or it is not an object */
+    [[nodiscard]] const json_value* find(std::string_view key) const;
+
+private:
+    std::variant<std::nullptr_t, bool, double, std::string, array, object> _value = nullptr;
+};
+
+/** Parses a whole JSON document, throws std::invalid_argument with the error offset on syntax errors */
+json_value parse_json(std::string_view text);
+} // namespace sortlab
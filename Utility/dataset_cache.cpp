@@ -0,0 +1,263 @@
+#include "dataset_cache.h"
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace utility::tests
+{
+namespace
+{
+std::system_error make_system_error(const std::string& what)
+{
+    return { errno, std::generic_category(), what };
+}
+
+constexpr std::array<char, 8> dataset_magic{ 'D', 'A', 'T', 'A', 'S', 'E', 'T', '1' };
+
+struct dataset_header
+{
+    std::array<char, 8> magic{};
+    uint64_t key_hash = 0;
+    uint64_t value_size = 0;
+    uint64_t size = 0;
+    std::array<uint64_t, 3> reserved{};
+    /** Checksum of all the previous fields */
+    uint64_t checksum = 0;
+};
+static_assert(sizeof(dataset_header) == dataset_cache::header_size);
+
+/** FNV-1a */
+uint64_t hash_bytes(const void* data, const size_t size)
+{
+    uint64_t hash = 0xCBF29CE484222325;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<const unsigned char*>(data)[i];
+        hash *= 0x100000001B3;
+    }
+
+    return hash;
+}
+
+uint64_t header_checksum(const dataset_header& header)
+{
+    return hash_bytes(&header, offsetof(dataset_header, checksum));
+}
+
+dataset_header make_header(const std::string& key, const size_t value_size, const size_t size)
+{
+    dataset_header header;
+    header.magic = dataset_magic;
+    header.key_hash = hash_bytes(key.data(), key.size());
+    header.value_size = value_size;
+    header.size = size;
+    header.checksum = header_checksum(header);
+
+    return header;
+}
+
+/** Symbols allowed in generator names: letters, digits, '_' and '-' */
+bool is_name_symbol(const char symbol)
+{
+    return (symbol >= 'a' && symbol <= 'z') || (symbol >= 'A' && symbol <= 'Z') || (symbol >= '0' && symbol <= '9') ||
+           symbol == '_' || symbol == '-';
+}
+
+void write_all(const int descriptor, const std::byte* data, size_t size, const std::filesystem::path& path)
+{
+    while (size > 0)
+    {
+        const ssize_t written = ::write(descriptor, data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw make_system_error("Cannot write " + path.string());
+        }
+
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+} // namespace
+
+private_mapping::private_mapping(const std::filesystem::path& path)
+{
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        throw make_system_error("Cannot open " + path.string());
+
+    struct stat file_stat{};
+    if (fstat(descriptor, &file_stat) != 0)
+    {
+        const auto error = make_system_error("Cannot get size of " + path.string());
+        close(descriptor);
+        throw error;
+    }
+    _size = static_cast<size_t>(file_stat.st_size);
+
+    if (_size > 0)
+    {
+        // Writable private mapping of a read-only file: modified pages are copied, the file is never changed
+        void* mapped = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+        if (mapped == MAP_FAILED)
+        {
+            const auto error = make_system_error("Cannot map " + path.string());
+            close(descriptor);
+            throw error;
+        }
+        _data = static_cast<std::byte*>(mapped);
+    }
+
+    // The mapping keeps the file alive
+    close(descriptor);
+}
+
+private_mapping::private_mapping(private_mapping&& other) noexcept
+    : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0))
+{}
+
+private_mapping& private_mapping::operator=(private_mapping&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (_data != nullptr)
+            munmap(_data, _size);
+
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+    }
+
+    return *this;
+}
+
+private_mapping::~private_mapping()
+{
+    if (_data != nullptr)
+        munmap(_data, _size);
+}
+
+std::byte* private_mapping::data() const
+{
+    return _data;
+}
+
+size_t private_mapping::size() const
+{
+    return _size;
+}
+
+dataset_cache::dataset_cache(std::filesystem::path directory) : _directory(std::move(directory)) {}
+
+std::filesystem::path dataset_cache::default_directory()
+{
+    if (const char* directory = std::getenv("DATASET_CACHE_DIR"); directory != nullptr && *directory != '\0')
+        return directory;
+
+    return std::filesystem::temp_directory_path() / "dataset_cache";
+}
+
+const std::filesystem::path& dataset_cache::directory() const
+{
+    return _directory;
+}
+
+std::filesystem::path dataset_cache::file_path(const std::string& key) const
+{
+    return _directory / (key + ".bin");
+}
+
+std::optional<private_mapping> dataset_cache::open(const std::string& key, const size_t value_size,
+                                                   const size_t size) const
+{
+    const auto path = file_path(key);
+
+    std::error_code error;
+    const auto file_size = std::filesystem::file_size(path, error);
+    if (error || file_size != header_size + value_size * size)
+        return std::nullopt;
+
+    private_mapping mapping(path);
+
+    dataset_header header;
+    std::memcpy(&header, mapping.data(), sizeof(header));
+
+    const dataset_header expected = make_header(key, value_size, size);
+    if (header.checksum != header_checksum(header) || std::memcmp(&header, &expected, sizeof(header)) != 0)
+        return std::nullopt;
+
+    return mapping;
+}
+
+void dataset_cache::write(const std::string& key, const size_t value_size, const size_t size,
+                          const std::byte* data) const
+{
+    std::filesystem::create_directories(_directory);
+
+    const auto path = file_path(key);
+    // Unique name, so neither other processes nor other threads of this one write to the same temporary file
+    std::string temporary_name = path.string() + ".tmpXXXXXX";
+    const int descriptor = mkstemp(temporary_name.data());
+    if (descriptor < 0)
+        throw make_system_error("Cannot create " + temporary_name);
+    const std::filesystem::path temporary_path = temporary_name;
+
+    try
+    {
+        // mkstemp creates the file readable only by the owner
+        if (fchmod(descriptor, 0644) != 0)
+            throw make_system_error("Cannot change permissions of " + temporary_path.string());
+
+        const dataset_header header = make_header(key, value_size, size);
+        write_all(descriptor, reinterpret_cast<const std::byte*>(&header), sizeof(header), temporary_path);
+        write_all(descriptor, data, value_size * size, temporary_path);
+    }
+    catch (...)
+    {
+        close(descriptor);
+        std::filesystem::remove(temporary_path);
+        throw;
+    }
+
+    if (close(descriptor) != 0)
+        throw make_system_error("Cannot write " + temporary_path.string());
+
+    // Concurrent runs may write the same dataset, the rename replaces the file atomically
+    std::filesystem::rename(temporary_path, path);
+}
+
+std::string dataset_cache::make_key(const std::string_view generator_name, const std::string_view parameters,
+                                    const std::string_view type_name, const size_t size, const uint64_t seed)
+{
+    if (generator_name.empty())
+        throw std::invalid_argument("Dataset generator name must not be empty");
+
+    for (const char symbol: generator_name)
+    {
+        if (!is_name_symbol(symbol))
+            throw std::invalid_argument("Dataset generator name may contain only letters, digits, '_' and '-'");
+    }
+
+    for (const char symbol: parameters)
+    {
+        if (!is_name_symbol(symbol) && symbol != '.' && symbol != '=')
+            throw std::invalid_argument(
+                    "Dataset generator parameters may contain only letters, digits, '_', '-', '.' and '='");
+    }
+
+    std::string key = std::string(generator_name) + "_" + std::string(type_name) + "_" + std::to_string(size) + "_" +
+                      std::to_string(seed);
+    if (!parameters.empty())
+        key += "_" + std::string(parameters);
+    return key;
+}
+} // namespace utility::tests
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "generators.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace utility::tests
+{
+/**
+ * Whole file mapped with MAP_PRIVATE: the data can be modified in memory, but changes are copy-on-write,
+ * so they are never written back to the file and other mappings of it do not see them
+ */
+class private_mapping final
+{
+public:
+    explicit private_mapping(const std::filesystem::path& path);
+
+    private_mapping(const private_mapping& other) = delete;
+    private_mapping& operator=(const private_mapping& other) = delete;
+
+    private_mapping(private_mapping&& other) noexcept;
+    private_mapping& operator=(private_mapping&& other) noexcept;
+
+    ~private_mapping();
+
+    [[nodiscard]] std::byte* data() const;
+    [[nodiscard]] size_t size() const;
+
+private:
+    std::byte* _data = nullptr;
+    size_t _size = 0;
+};
+
+/** Cached dataset of T values, its pages are read from the file on the first access */
+template<GeneratedValue T>
+class mapped_dataset final
+{
+public:
+    explicit mapped_dataset(private_mapping mapping, size_t offset);
+
+    [[nodiscard]] std::span<T> data() const;
+
+private:
+    private_mapping _mapping;
+    std::span<T> _data;
+};
+
+/** Name of the value type in cache keys, e.g. int32, uint8, float64 */
+template<GeneratedValue T>
+std::string value_type_name();
+
+/**
+ * On-disk cache of generated benchmark inputs. Every dataset is a binary file keyed by the generator name,
+ * the value type, the size, the seed and the generator parameters. It is written once and mapped copy-on-write
+ * by later runs.
+ * The header stores the key and the size and is protected by a checksum, the data itself is not checksummed,
+ * so opening even a multi-GB dataset takes milliseconds
+ */
+class dataset_cache final
+{
+public:
+    /** The directory is created on the first write */
+    explicit dataset_cache(std::filesystem::path directory = default_directory());
+
+    /** DATASET_CACHE_DIR environment variable or <temp directory>/dataset_cache */
+    static std::filesystem::path default_directory();
+
+    [[nodiscard]] const std::filesystem::path& directory() const;
+
+    /**
+     * Returns the cached dataset or generates it with generator(size, seed) -> std::vector<T>, writes it to
+     * the cache and maps it. Missing or truncated files and files with corrupted headers are regenerated,
+     * corrupted data after a valid header is not detected. The generator name may contain only letters, digits,
+     * '_' and '-', otherwise std::invalid_argument is thrown
+     */
+    template<GeneratedValue T, class Generator>
+    mapped_dataset<T> get(std::string_view generator_name, size_t size, uint64_t seed, Generator generator) const;
+
+    /**
+     * The same for generators with parameters other than the size and the seed, e.g. "exponent=1.5" for Zipf.
+     * They are a part of the key, so datasets with different parameters are never mixed up. The parameters may
+     * contain only letters, digits, '_', '-', '.' and '='
+     */
+    template<GeneratedValue T, class Generator>
+    mapped_dataset<T> get(std::string_view generator_name, std::string_view parameters, size_t size, uint64_t seed,
+                          Generator generator) const;
+
+    /** Offset of the data in dataset files */
+    static constexpr size_t header_size = 64;
+
+private:
+    [[nodiscard]] std::filesystem::path file_path(const std::string& key) const;
+
+    /** Returns the mapping if the file exists and its header matches the key and the data size */
+    [[nodiscard]] std::optional<private_mapping> open(const std::string& key, size_t value_size, size_t size) const;
+
+    /** Writes the file atomically: to a temporary file which is renamed then */
+    void write(const std::string& key, size_t value_size, size_t size, const std::byte* data) const;
+
+    static std::string make_key(std::string_view generator_name, std::string_view parameters,
+                                std::string_view type_name, size_t size, uint64_t seed);
+
+    std::filesystem::path _directory;
+};
+} // namespace utility::tests
+
+#include "dataset_cache.inl"
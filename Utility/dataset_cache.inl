@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace utility::tests
+{
+template<GeneratedValue T>
+mapped_dataset<T>::mapped_dataset(private_mapping mapping, const size_t offset) : _mapping(std::move(mapping))
+{
+    _data = std::span<T>(reinterpret_cast<T*>(_mapping.data() + offset), (_mapping.size() - offset) / sizeof(T));
+}
+
+template<GeneratedValue T>
+std::span<T> mapped_dataset<T>::data() const
+{
+    return _data;
+}
+
+template<GeneratedValue T>
+std::string value_type_name()
+{
+    const char* kind = std::is_floating_point_v<T> ? "float" : (std::is_signed_v<T> ? "int" : "uint");
+    return kind + std::to_string(sizeof(T) * 8);
+}
+
+template<GeneratedValue T, class Generator>
+mapped_dataset<T> dataset_cache::get(const std::string_view generator_name, const size_t size, const uint64_t seed,
+                                     Generator generator) const
+{
+    return get<T>(generator_name, {}, size, seed, std::move(generator));
+}
+
+template<GeneratedValue T, class Generator>
+mapped_dataset<T> dataset_cache::get(const std::string_view generator_name, const std::string_view parameters,
+                                     const size_t size, const uint64_t seed, Generator generator) const
+{
+    const std::string key = make_key(generator_name, parameters, value_type_name<T>(), size, seed);
+
+    auto mapping = open(key, sizeof(T), size);
+    if (!mapping)
+    {
+        const std::vector<T> data = generator(size, seed);
+        if (data.size() != size)
+            throw std::invalid_argument("Dataset generator returned " + std::to_string(data.size()) +
+                                        " elements instead of " + std::to_string(size));
+
+        write(key, sizeof(T), size, reinterpret_cast<const std::byte*>(data.data()));
+
+        mapping = open(key, sizeof(T), size);
+        if (!mapping)
+            throw std::runtime_error("Dataset " + key + " cannot be read back from the cache");
+    }
+
+    return mapped_dataset<T>(std::move(*mapping), header_size);
+}
+} // namespace utility::tests
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utility::tests
+{
+/** Fixed seed by default, random seeds may lead to different performance results */
+inline constexpr uint64_t default_seed = 31;
+
+/** Values of generated data: integers and floating point numbers */
+template<typename T>
+concept GeneratedValue = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+/**
+ * Counter-based random numbers: the n-th output of SplitMix64 started from the seed is computed directly
+ * from n. Every element is generated from its own index, so data is the same for the seed regardless of
+ * how many threads generate it and in which order
+ */
+class counter_rng final
+{
+public:
+    explicit constexpr counter_rng(uint64_t seed = default_seed);
+
+    /** 64 random bits for the counter */
+    [[nodiscard]] constexpr uint64_t bits(uint64_t counter) const;
+
+    /** Uniform number in (0, 1) for the counter, it is never 0, so logarithms of it are finite */
+    [[nodiscard]] constexpr double uniform(uint64_t counter) const;
+
+private:
+    uint64_t _seed;
+};
+
+/** Fills data[i] = generator(i) by at most threads threads, splitting the data in halves recursively */
+template<class T, class Generator>
+void parallel_generate(std::span<T> data, Generator generator,
+                       size_t threads = std::max(std::thread::hardware_concurrency(), 1u));
+
+/**
+ * Integers with all bits random (negative ones too for signed types), floating point numbers in (0, 1),
+ * floats in [0, 1) with 24 random bits
+ */
+template<GeneratedValue T>
+std::vector<T> generate_uniform(size_t size, uint64_t seed = default_seed);
+
+/**
+ * Zipf distributed ranks in [1, universe]: rank k has the probability proportional to 1 / k^exponent,
+ * so a few small values are very frequent. The universe is the size by default (universe = 0)
+ */
+template<GeneratedValue T>
+std::vector<T> generate_zipf(size_t size, double exponent = 1.0, uint64_t universe = 0, uint64_t seed = default_seed);
+
+/** Normally distributed values, rounded and clamped to the range of integer types */
+template<GeneratedValue T>
+std::vector<T> generate_gaussian(size_t size, double mean, double stddev, uint64_t seed = default_seed);
+
+/** 0, 1, 2, ..., n/2, ..., 2, 1, 0: ascending first half and descending second half */
+template<GeneratedValue T>
+std::vector<T> generate_organ_pipe(size_t size);
+
+/** 0, 1, ..., period - 1, 0, 1, ...: ascending runs of the same values */
+template<GeneratedValue T>
+std::vector<T> generate_sawtooth(size_t size, size_t period);
+
+/**
+ * Concatenation of runs ascending runs of equal length (the last one may be shorter).
+ * Values of different runs interleave, so merging the runs moves every element
+ */
+template<GeneratedValue T>
+std::vector<T> generate_sorted_runs(size_t size, size_t runs);
+
+/** Random values from [0, unique_count) */
+template<GeneratedValue T>
+std::vector<T> generate_few_unique(size_t size, size_t unique_count, uint64_t seed = default_seed);
+
+/**
+ * Musser's "median-of-3 killer" permutation of 1..size: quick sort taking the median of the first, middle and
+ * last elements as the pivot splits off only two elements per partition and takes O(n^2) time
+ */
+template<GeneratedValue T>
+std::vector<T> generate_median_of_3_killer(size_t size);
+} // namespace utility::tests
+
+#include "generators.inl"
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+namespace utility::tests
+{
+namespace local
+{
+    static constexpr uint64_t golden_gamma = 0x9E3779B97F4A7C15;
+
+    /** SplitMix64 output function */
+    constexpr uint64_t mix(uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+        return value ^ (value >> 31);
+    }
+
+    /** Wraps integers modulo 2^bits of T, converts to floating point types exactly as far as possible */
+    template<class T>
+    constexpr T from_integer(const uint64_t value)
+    {
+        return static_cast<T>(value);
+    }
+
+    /** Rounds and clamps to the range of integer types */
+    template<class T>
+    T from_double(const double value)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+            return static_cast<T>(value);
+        else
+        {
+            if (std::isnan(value) || value <= static_cast<double>(std::numeric_limits<T>::lowest()))
+                return std::numeric_limits<T>::lowest();
+            if (value >= static_cast<double>(std::numeric_limits<T>::max()))
+                return std::numeric_limits<T>::max();
+
+            return static_cast<T>(std::round(value));
+        }
+    }
+
+    static constexpr size_t min_size_for_threading = 1 << 16;
+
+    template<class T, class Generator>
+    void parallel_generate(T* data, const size_t begin, const size_t end, const Generator& generator,
+                           const size_t threads)
+    {
+        if (threads <= 1 || end - begin <= min_size_for_threading)
+        {
+            for (size_t i = begin; i < end; ++i)
+                data[i] = generator(i);
+            return;
+        }
+
+        const size_t mid = begin + (end - begin) / 2;
+
+        // This thread generates the left part, a new thread generates the right part
+        auto right_future = std::async(std::launch::async, [=, &generator]
+                                       { parallel_generate(data, mid, end, generator, threads / 2); });
+        parallel_generate(data, begin, mid, generator, threads - threads / 2);
+
+        // Waiting for the right part to be generated
+        right_future.get();
+    }
+
+    template<class T, class Generator>
+    std::vector<T> generate(const size_t size, const Generator& generator)
+    {
+        std::vector<T> data(size);
+        utility::tests::parallel_generate(std::span<T>(data), generator);
+        return data;
+    }
+
+    /**
+     * Rejection-inversion sampling of the Zipf distribution (W. Hormann, G. Derflinger, 1996):
+     * constant expected time for any universe without tables, so every element is sampled independently
+     */
+    class zipf_sampler final
+    {
+    public:
+        zipf_sampler(const double exponent, const uint64_t universe) : _exponent(exponent), _universe(universe)
+        {
+            _h_integral_x1 = h_integral(1.5) - 1;
+            _h_integral_universe = h_integral(static_cast<double>(universe) + 0.5);
+            _s = 2 - h_integral_inverse(h_integral(2.5) - h(2));
+        }
+
+        /** Takes uniform numbers in (0, 1) from the callback until a sample is accepted */
+        template<class Uniform>
+        uint64_t operator()(Uniform uniform) const
+        {
+            // The acceptance rate is high, the limit only protects from an infinite loop
+            static constexpr size_t max_attempts = 64;
+
+            double x = 1;
+            for (size_t attempt = 0; attempt < max_attempts; ++attempt)
+            {
+                const double u =
+                        _h_integral_universe + uniform(attempt) * (_h_integral_x1 - _h_integral_universe);
+                x = h_integral_inverse(u);
+
+                const double k = std::clamp(std::round(x), 1.0, static_cast<double>(_universe));
+                if (k - x <= _s || u >= h_integral(k + 0.5) - h(k))
+                    return static_cast<uint64_t>(k);
+            }
+
+            return static_cast<uint64_t>(std::clamp(std::round(x), 1.0, static_cast<double>(_universe)));
+        }
+
+    private:
+        /** log(1 + x) / x, stable near 0 */
+        static double helper1(const double x)
+        {
+            return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+        }
+
+        /** (exp(x) - 1) / x, stable near 0 */
+        static double helper2(const double x)
+        {
+            return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+        }
+
+        [[nodiscard]] double h(const double x) const
+        {
+            return std::exp(-_exponent * std::log(x));
+        }
+
+        [[nodiscard]] double h_integral(const double x) const
+        {
+            const double log_x = std::log(x);
+            return helper2((1 - _exponent) * log_x) * log_x;
+        }
+
+        [[nodiscard]] double h_integral_inverse(const double x) const
+        {
+            const double t = std::max(x * (1 - _exponent), -1.0);
+            return std::exp(helper1(t) * x);
+        }
+
+        double _exponent;
+        uint64_t _universe;
+        double _h_integral_x1 = 0;
+        double _h_integral_universe = 0;
+        double _s = 0;
+    };
+} // namespace local
+
+constexpr counter_rng::counter_rng(const uint64_t seed) : _seed(seed) {}
+
+constexpr uint64_t counter_rng::bits(const uint64_t counter) const
+{
+    return local::mix(_seed + (counter + 1) * local::golden_gamma);
+}
+
+constexpr double counter_rng::uniform(const uint64_t counter) const
+{
+    // 53 random bits and a half of the lowest bit: (0, 1) without the ends
+    return (static_cast<double>(bits(counter) >> 11) + 0.5) * 0x1.0p-53;
+}
+
+template<class T, class Generator>
+void parallel_generate(std::span<T> data, Generator generator, const size_t threads)
+{
+    local::parallel_generate(data.data(), 0, data.size(), generator, threads);
+}
+
+template<GeneratedValue T>
+std::vector<T> generate_uniform(const size_t size, const uint64_t seed)
+{
+    const counter_rng rng(seed);
+
+    return local::generate<T>(size,
+                              [rng](const size_t i)
+                              {
+                                  // Rounding of a double to float may give 1, 24 random bits are exact
+                                  if constexpr (std::same_as<T, float>)
+                                      return static_cast<float>(rng.bits(i) >> 40) * 0x1p-24f;
+                                  else if constexpr (std::is_floating_point_v<T>)
+                                      return static_cast<T>(rng.uniform(i));
+                                  else
+                                      return local::from_integer<T>(rng.bits(i));
+                              });
+}
+
+template<GeneratedValue T>
+std::vector<T> generate_zipf(const size_t size, const double exponent, const uint64_t universe, const uint64_t seed)
+{
+    if (exponent <= 0)
+        throw std::invalid_argument("Zipf exponent must be positive");
+
+    const counter_rng rng(seed);
+    const local::zipf_sampler sampler(exponent, universe == 0 ? std::max<uint64_t>(size, 1) : universe);
+
+    // Every element has its own sequence of 64 counters for rejection attempts
+    return local::generate<T>(size,
+                              [rng, &sampler](const size_t i)
+                              {
+                                  const auto uniform = [rng, i](const size_t attempt)
+                                  { return rng.uniform(i * 64 + attempt); };
+                                  return local::from_integer<T>(sampler(uniform));
+                              });
+}
+
+template<GeneratedValue T>
+std::vector<T> generate_gaussian(const size_t size, const double mean, const double stddev, const uint64_t seed)
+{
+    const counter_rng rng(seed);
+
+    // Box-Muller transform of two uniform numbers per element
+    return local::generate<T>(size,
+                              [rng, mean, stddev](const size_t i)
+                              {
+                                  const double radius = std::sqrt(-2 * std::log(rng.uniform(2 * i)));
+                                  const double angle = 2 * std::numbers::pi * rng.uniform(2 * i + 1);
+                                  return local::from_double<T>(mean + stddev * radius * std::cos(angle));
+                              });
+}
+
+template<GeneratedValue T>
+std::vector<T> generate_organ_pipe(const size_t size)
+{
+    return local::generate<T>(size, [size](const size_t i)
+                              { return local::from_integer<T>(i < size / 2 ? i : size - 1 - i); });
+}
+
+template<GeneratedValue T>
+std::vector<T> generate_sawtooth(const size_t size, const size_t period)
+{
+    if (period == 0)
+        throw std::invalid_argument("Sawtooth period must be positive");
+
+    return local::generate<T>(size, [period](const size_t i) { return local::from_integer<T>(i % period); });
+}
+
+template<GeneratedValue T>
+std::vector<T> generate_sorted_runs(const size_t size, const size_t runs)
+{
+    if (runs == 0)
+        throw std::invalid_argument("Number of sorted runs must be positive");
+
+    const size_t run_size = std::max<size_t>((size + runs - 1) / runs, 1);
+
+    // j-th element of the r-th run is j * runs + r, so all values are unique
+    return local::generate<T>(size, [runs, run_size](const size_t i)
+                              { return local::from_integer<T>(i % run_size * runs + i / run_size); });
+}
+
+template<GeneratedValue T>
+std::vector<T> generate_few_unique(const size_t size, const size_t unique_count, const uint64_t seed)
+{
+    if (unique_count == 0)
+        throw std::invalid_argument("Number of unique values must be positive");
+
+    const counter_rng rng(seed);
+
+    return local::generate<T>(size, [rng, unique_count](const size_t i)
+                              { return local::from_integer<T>(rng.bits(i) % unique_count); });
+}
+
+template<GeneratedValue T>
+std::vector<T> generate_median_of_3_killer(const size_t size)
+{
+    // Musser's construction for n = 2k with even k:
+    // 1, k + 1, 3, k + 3, ..., k - 1, 2k - 1, 2, 4, ..., 2k. The tail which does not fit is ascending
+    const size_t k = size / 2 / 2 * 2;
+
+    return local::generate<T>(size,
+                              [k](const size_t i)
+                              {
+                                  if (i >= 2 * k)
+                                      return local::from_integer<T>(i + 1);
+                                  if (i >= k)
+                                      return local::from_integer<T>(2 * (i - k + 1));
+                                  return local::from_integer<T>(i % 2 == 0 ? i + 1 : k + i);
+                              });
+}
+} // namespace utility::tests
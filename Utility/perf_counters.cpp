@@ -0,0 +1,118 @@
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace utility::tests
+{
+#ifdef __linux__
+namespace
+{
+struct event_description
+{
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cache_read_miss(const uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr event_description events[]{
+    { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { "L1d-misses", PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_L1D) },
+    { "LLC-misses", PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_LL) },
+    { "dTLB-misses", PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_DTLB) },
+};
+
+int open_event(const event_description& event)
+{
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = event.type;
+    attributes.config = event.config;
+    attributes.disabled = 1;
+    // Threads created by the measured code (e.g. concurrent sorts) are counted too
+    attributes.inherit = 1;
+    // User space only, it is permitted with the default perf_event_paranoid = 2
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    // The events are multiplexed if the CPU has fewer counters, the times tell the share each one was counted
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+} // namespace
+
+perf_counters::perf_counters()
+{
+    for (const auto& event: events)
+    {
+        const int descriptor = open_event(event);
+        if (descriptor >= 0)
+            _counters.push_back({ event.name, 0, descriptor });
+    }
+}
+
+perf_counters::~perf_counters()
+{
+    for (const auto& counter: _counters)
+        close(counter.descriptor);
+}
+
+void perf_counters::start()
+{
+    // Disabled counters keep their values and times, so they accumulate over all start()/stop() pairs
+    for (const auto& counter: _counters)
+        ioctl(counter.descriptor, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+void perf_counters::stop()
+{
+    for (auto& counter: _counters)
+    {
+        ioctl(counter.descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+        // The read format: the raw value, the time enabled and the time running
+        uint64_t values[3]{};
+        if (read(counter.descriptor, values, sizeof(values)) != sizeof(values))
+            continue;
+
+        const auto [raw_value, time_enabled, time_running] = values;
+        counter.time_enabled = time_enabled;
+        counter.time_running = time_running;
+        counter.value = time_running == 0 || time_running == time_enabled
+                                ? raw_value
+                                : static_cast<uint64_t>(static_cast<double>(raw_value) *
+                                                        static_cast<double>(time_enabled) /
+                                                        static_cast<double>(time_running));
+    }
+}
+#else
+perf_counters::perf_counters() = default;
+
+perf_counters::~perf_counters() = default;
+
+void perf_counters::start() {}
+
+void perf_counters::stop() {}
+#endif
+
+bool perf_counters::available() const
+{
+    return !_counters.empty();
+}
+
+const std::vector<perf_counters::counter>& perf_counters::counters() const
+{
+    return _counters;
+}
+} // namespace utility::tests
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace utility::tests
+{
+/**
+ * Hardware performance counters of the calling thread and threads created by it (Linux perf_event_open).
+ * Counters which cannot be opened (not permitted by perf_event_paranoid, not supported by the CPU or
+ * a virtual machine, not Linux) are skipped, so the class can always be used and just measures less.
+ * If the CPU has fewer counters than events, the kernel multiplexes them: a value is then estimated from the share
+ * of the time its event was counted, and an event which was never counted has no value
+ */
+class perf_counters final
+{
+public:
+    struct counter
+    {
+        std::string name;
+        // Scaled to the whole enabled time if the event was counted only a part of it
+        uint64_t value = 0;
+        int descriptor = -1;
+        // Nanoseconds the event was enabled and actually counted
+        uint64_t time_enabled = 0;
+        uint64_t time_running = 0;
+
+        [[nodiscard]] bool counted() const
+        {
+            return time_running > 0;
+        }
+    };
+
+    perf_counters();
+
+    perf_counters(const perf_counters& other) = delete;
+    perf_counters& operator=(const perf_counters& other) = delete;
+
+    perf_counters(perf_counters&& other) = delete;
+    perf_counters& operator=(perf_counters&& other) = delete;
+
+    ~perf_counters();
+
+    /** Returns false if none of the counters could be opened */
+    [[nodiscard]] bool available() const;
+
+    /** Counting is accumulated over all start()/stop() pairs */
+    void start();
+    void stop();
+
+    [[nodiscard]] const std::vector<counter>& counters() const;
+
+    /**
+     * Publishes accumulated values as benchmark user counters normalized per element:
+     * e.g. "branch-misses/elem" = branch misses / (iterations * elements).
+     * Events which were not counted are listed in the label instead
+     */
+    template<class BenchmarkState>
+    void publish(BenchmarkState& state, const double elements) const
+    {
+        const double total_elements = static_cast<double>(state.iterations()) * elements;
+        if (total_elements == 0)
+            return;
+
+        std::string not_counted;
+        for (const auto& counter: _counters)
+        {
+            if (counter.counted())
+                state.counters[counter.name + "/elem"] = static_cast<double>(counter.value) / total_elements;
+            else
+                not_counted += (not_counted.empty() ? "not counted: " : ", ") + counter.name;
+        }
+
+        if (!not_counted.empty())
+            state.SetLabel(not_counted);
+    }
+
+private:
+    std::vector<counter> _counters;
+};
+} // namespace utility::tests
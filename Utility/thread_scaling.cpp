@@ -0,0 +1,45 @@
+#include "thread_scaling.h"
+
+#include <algorithm>
+#include <map>
+#include <thread>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+namespace utility::tests
+{
+std::vector<int64_t> scaling_thread_counts()
+{
+    const auto hardware_threads = static_cast<int64_t>(std::max(std::thread::hardware_concurrency(), 1u));
+
+    std::vector<int64_t> counts;
+    for (int64_t threads = 1; threads < hardware_threads; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(hardware_threads);
+
+    return counts;
+}
+
+std::vector<int64_t> scaling_sizes()
+{
+    return { 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000 };
+}
+
+bool fits_in_memory(const size_t bytes)
+{
+#ifdef __unix__
+    const long pages = sysconf(_SC_PHYS_PAGES), page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && page_size > 0)
+        return bytes <= static_cast<size_t>(pages) / 2 * static_cast<size_t>(page_size);
+#endif
+    return true;
+}
+
+double& single_thread_seconds(const std::string& key)
+{
+    static std::map<std::string, double> seconds;
+    return seconds[key];
+}
+} // namespace utility::tests
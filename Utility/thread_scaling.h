@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace utility::tests
+{
+/** Thread counts swept by scaling benchmarks: 1, 2, 4, ... and the hardware concurrency itself */
+std::vector<int64_t> scaling_thread_counts();
+
+/** Sizes swept by scaling benchmarks: 1e5 ... 1e9 */
+std::vector<int64_t> scaling_sizes();
+
+/** Returns true if the given number of bytes takes at most a half of the physical memory (or it is unknown) */
+bool fits_in_memory(size_t bytes);
+
+/** Time of the single thread run per iteration for the benchmark key, 0 if it was not recorded */
+double& single_thread_seconds(const std::string& key);
+
+/**
+ * Publishes speedup and parallel efficiency (speedup / threads) relative to the single thread run
+ * with the same key (e.g. a benchmark name and a size). The single thread run must go first,
+ * its time is recorded by this function too
+ */
+template<class BenchmarkState>
+void publish_scaling(BenchmarkState& state, const std::string& key, const size_t threads, const double seconds)
+{
+    if (state.iterations() == 0)
+        return;
+
+    const double iteration_seconds = seconds / static_cast<double>(state.iterations());
+    if (threads == 1)
+        single_thread_seconds(key) = iteration_seconds;
+
+    const double baseline_seconds = single_thread_seconds(key);
+    if (baseline_seconds == 0 || iteration_seconds == 0)
+        return;
+
+    const double speedup = baseline_seconds / iteration_seconds;
+    state.counters["speedup"] = speedup;
+    state.counters["efficiency"] = speedup / static_cast<double>(threads);
+}
+} // namespace utility::tests